@@ -0,0 +1,50 @@
+/*  File: allocator.c
+ *
+ *  Copyright (C) 2011, Patrick M. Elsen
+ *
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *  Author: Patrick M. Elsen <pelsen.vn (a) gmail.com>
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "clists/allocator.h"
+
+void *allocator_alloc(const allocator_t *allocator, size_t size)
+{
+    // no allocator means plain malloc()
+    if(allocator == NULL) {
+        return malloc(size);
+    }
+
+    return allocator->alloc(allocator->ctx, size);
+}
+
+void allocator_free(const allocator_t *allocator, void *ptr, size_t size)
+{
+    // no allocator means plain free()
+    if(allocator == NULL) {
+        free(ptr);
+        return;
+    }
+
+    // allocators without free function release
+    // memory some other way
+    if(allocator->free != NULL) {
+        allocator->free(allocator->ctx, ptr, size);
+    }
+}
@@ -0,0 +1,187 @@
+/*  File: arena.c
+ *
+ *  Copyright (C) 2011, Patrick M. Elsen
+ *
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *  Author: Patrick M. Elsen <pelsen.vn (a) gmail.com>
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "clists/arena.h"
+#include <assert.h>
+
+// strictest alignment any object could need, same as
+// what malloc() guarantees
+union arena_max_align {
+    long double ld;
+    long long ll;
+    void *ptr;
+    void (*fn)(void);
+};
+
+#define arena_align sizeof(union arena_max_align)
+
+// round size up to a multiple of arena_align
+#define arena_round(size) \
+    ((((size) + arena_align - 1) / arena_align) * arena_align)
+
+// default size of a chunk
+#define arena_default_chunk_size 65536
+
+// offset of the data in a chunk allocation
+#define arena_chunk_header arena_round(sizeof(arena_chunk_t))
+
+// allocate a new chunk with at least size bytes
+static arena_chunk_t *arena_chunk_new(size_t size);
+
+arena_t *arena_new(size_t chunk_size)
+{
+    // allocate memory for new arena
+    arena_t *arena = malloc(sizeof(arena_t));
+
+    // check if memory allocation worked
+    if(arena == NULL) {
+        return NULL;
+    }
+
+    return arena_init(arena, chunk_size);
+}
+
+arena_t *arena_init(arena_t *arena, size_t chunk_size)
+{
+    // make sure arena exists
+    if(arena == NULL) {
+        return NULL;
+    }
+
+    arena->chunks = NULL;
+    arena->chunk_size = (chunk_size == 0) ? arena_default_chunk_size : chunk_size;
+
+    return arena;
+}
+
+void *arena_alloc(arena_t *arena, size_t size)
+{
+    arena_chunk_t *chunk = arena->chunks;
+
+    // keep everything aligned
+    size = arena_round(size);
+
+    // fast path: there is enough space in the
+    // current chunk
+    if(chunk != NULL && (chunk->size - chunk->used) >= size) {
+        void *ptr = chunk->data + chunk->used;
+        chunk->used += size;
+        return ptr;
+    }
+
+    // allocations larger than a chunk get a chunk
+    // of their own, which is put behind the current
+    // one so we can keep using that.
+    if(size > arena->chunk_size && chunk != NULL) {
+        arena_chunk_t *large = arena_chunk_new(size);
+
+        if(large == NULL) {
+            return NULL;
+        }
+
+        large->used = size;
+        large->next = chunk->next;
+        chunk->next = large;
+
+        return large->data;
+    }
+
+    // start a new chunk
+    chunk = arena_chunk_new((size > arena->chunk_size) ? size : arena->chunk_size);
+
+    if(chunk == NULL) {
+        return NULL;
+    }
+
+    chunk->next = arena->chunks;
+    chunk->used = size;
+    arena->chunks = chunk;
+
+    return chunk->data;
+}
+
+arena_t *arena_reset(arena_t *arena)
+{
+    // nothing to do
+    if(arena->chunks == NULL) {
+        return arena;
+    }
+
+    // free all but the current chunk
+    arena_chunk_t *chunk = arena->chunks->next;
+    while(chunk != NULL) {
+        arena_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    arena->chunks->next = NULL;
+    arena->chunks->used = 0;
+
+    return arena;
+}
+
+arena_t *arena_purge(arena_t *arena)
+{
+    arena_chunk_t *chunk = arena->chunks;
+    while(chunk != NULL) {
+        arena_chunk_t *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+
+    arena->chunks = NULL;
+
+    return arena;
+}
+
+int arena_free(arena_t *arena)
+{
+    // can't free a NULL pointer
+    if(arena == NULL) {
+        return -1;
+    }
+
+    arena_purge(arena);
+    free(arena);
+
+    return 0;
+}
+
+static arena_chunk_t *arena_chunk_new(size_t size)
+{
+    // chunk header and data are one allocation
+    arena_chunk_t *chunk = malloc(arena_chunk_header + size);
+
+    if(chunk == NULL) {
+        return NULL;
+    }
+
+    chunk->next = NULL;
+    chunk->size = size;
+    chunk->used = 0;
+    chunk->data = ((char*) chunk) + arena_chunk_header;
+
+    return chunk;
+}
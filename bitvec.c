@@ -71,47 +71,34 @@ bitvec_word *bitvec_raw(bitvec_t *vec) {
 /* CREATION/DESTRUCTION FUNCTIONS */
 
 bitvec_t *bitvec_new(size_t size, bool val) {
-    bitvec_t *vec = malloc(sizeof(bitvec_t));
+    return bitvec_new_allocator(size, val, NULL);
+}
+
+bitvec_t *bitvec_init(bitvec_t *vec, size_t size, bool val) {
+    return bitvec_init_allocator(vec, size, val, NULL);
+}
+
+bitvec_t *bitvec_new_allocator(size_t size, bool val, const allocator_t *allocator) {
+    bitvec_t *vec = allocator_alloc(allocator, sizeof(bitvec_t));
 
     // make sure allocation worked
     if(vec == NULL) {
         return NULL;
     }
 
-    // set the size
-    vec->size = size;
-
-    // calculate how many bitvec_words we need,
-    // looks awkward because we need to round
-    // up.
-    vec->alloc = (size + sizeof(bitvec_word) - 1) / sizeof(bitvec_word);
-
-    // alloc being 0 can only happen when size is 0.
-    if(vec->alloc == 0) {
-        vec->data = NULL;
-        return vec;
-    }
-
-    // allocate data
-    vec->data = malloc(vec->alloc * sizeof(bitvec_word));
-
-    // make sure the allocation worked
-    if(vec->data == NULL) {
-        free(vec);
+    // initialize the bits
+    if(bitvec_init_allocator(vec, size, val, allocator) == NULL) {
+        allocator_free(allocator, vec, sizeof(bitvec_t));
         return NULL;
     }
 
-    // initialise the bits
-    if(val == false) {
-        memset(vec->data, 0, sizeof(bitvec_word) * vec->alloc);
-    } else {
-        memset(vec->data, 255, sizeof(bitvec_word) * vec->alloc);
-    }
-
     return vec;
 }
 
-bitvec_t *bitvec_init(bitvec_t *vec, size_t size, bool val) {
+bitvec_t *bitvec_init_allocator(bitvec_t *vec, size_t size, bool val, const allocator_t *allocator) {
+    // remember the allocator
+    vec->allocator = allocator;
+
     // set size and calculate how many bitvec_words
     // we need for the given size
     vec->size = size;
@@ -124,7 +111,7 @@ bitvec_t *bitvec_init(bitvec_t *vec, size_t size, bool val) {
     }
 
     // allocate data
-    vec->data = malloc(vec->alloc * sizeof(bitvec_word));
+    vec->data = allocator_alloc(allocator, vec->alloc * sizeof(bitvec_word));
 
     // make sure the allocation worked
     if(vec->data == NULL) {
@@ -147,10 +134,10 @@ bitvec_t *bitvec_purge(bitvec_t *vec);
 
 int bitvec_free(bitvec_t *vec) {
     if(vec->data != NULL) {
-        free(vec->data);
+        allocator_free(vec->allocator, vec->data, vec->alloc * sizeof(bitvec_word));
     }
 
-    free(vec);
+    allocator_free(vec->allocator, vec, sizeof(bitvec_t));
 
     return 0;
 }
@@ -0,0 +1,1250 @@
+/*  File: blist.c
+ *
+ *  Copyright (C) 2011, Patrick M. Elsen
+ *
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *  Author: Patrick M. Elsen <pelsen.vn (a) gmail.com>
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "clists/blist.h"
+#include <assert.h>
+#include <stdbool.h>
+
+// get a pointer to the element at index i of a leaf
+#define blist_element(list, leaf, i) ((leaf)->data + ((i) * (list)->size))
+
+// swap two variables
+#define swap(x,y) do {   \
+    typeof(x) _x = x;      \
+    typeof(y) _y = y;      \
+    x = _y;                \
+    y = _x;                \
+    } while(0)
+
+// allocate new, empty nodes
+static blist_leaf_t *blist_leaf_new(const blist_t *list);
+static blist_branch_t *blist_branch_new(void);
+
+// release a node and everything below it
+static void blist_node_free(void *node, size_t height);
+
+// how many elements (leaf) or children (branch) a node has
+static size_t blist_node_count(const void *node, size_t height);
+
+// how many elements are in the subtree of node
+static size_t blist_node_length(const void *node, size_t height);
+
+// maximum and minimum count of a node at height
+static size_t blist_node_max(const blist_t *list, size_t height);
+static size_t blist_node_min(const blist_t *list, size_t height);
+
+// split a full node in half, returning the upper half
+static void *blist_node_split(blist_t *list, void *node, size_t height);
+
+// split children[i] of branch (which is at height) in
+// half and insert the upper half as children[i+1]
+static int blist_branch_split(blist_t *list, blist_branch_t *branch, size_t height, size_t i);
+
+// insert or remove a child of a branch
+static void blist_branch_insert(blist_branch_t *branch, size_t i, void *child, size_t length);
+static void blist_branch_remove(blist_branch_t *branch, size_t i);
+
+// merge children[i] and children[i+1] of branch if they
+// fit into one node, or even out their counts otherwise.
+// if left is true, children[i] gets the bigger half.
+static void blist_rebalance(blist_t *list, blist_branch_t *branch, size_t height, size_t i, bool left);
+
+// make sure the root isn't full, adding a level to the
+// tree if it is
+static int blist_grow(blist_t *list);
+
+// remove levels from the top of the tree that only
+// have a single child
+static void blist_shrink(blist_t *list);
+
+// repair underfull nodes on the right (or left) edge of
+// the tree, left behind by splitting it
+static void blist_repair_right(blist_t *list);
+static void blist_repair_left(blist_t *list);
+
+// remove the element at pos from the subtree of node
+static void blist_node_remove(blist_t *list, void *node, size_t height, size_t pos);
+
+// get the leaf holding the element at pos, and change
+// pos to the position of the element in the leaf
+static blist_leaf_t *blist_leaf_get(const blist_t *list, size_t *pos);
+
+// copy the subtree of node, linking leaves into copy
+static void *blist_node_copy(blist_t *copy, const void *node, size_t height);
+
+// verify the subtree of node
+static int blist_node_verify(const blist_t *list, const void *node, size_t height, bool root, blist_leaf_t **leaf, size_t *length);
+
+size_t blist_size(const blist_t *list) {
+    if(list != NULL) {
+        return list->size;
+    }
+
+    return 0;
+}
+
+size_t blist_length(const blist_t *list) {
+    if(list != NULL) {
+        return list->length;
+    }
+
+    return 0;
+}
+
+void *blist_first(const blist_t *list) {
+    if(list != NULL && list->first != NULL) {
+        return blist_element(list, list->first, 0);
+    }
+
+    return NULL;
+}
+
+void *blist_last(const blist_t *list) {
+    if(list != NULL && list->last != NULL) {
+        return blist_element(list, list->last, list->last->count - 1);
+    }
+
+    return NULL;
+}
+
+blist_t *blist_new(size_t size)
+{
+    // allocate memory for new list
+    blist_t *list = malloc(sizeof(blist_t));
+
+    // check if memory allocation worked
+    if(list == NULL) {
+        return NULL;
+    }
+
+    return blist_init(list, size);
+}
+
+blist_t *blist_init(blist_t *list, size_t size)
+{
+    // make sure list exists
+    if(list == NULL) {
+        return NULL;
+    }
+
+    // initialize memory
+    memset(list, 0, sizeof(blist_t));
+
+    // set size
+    list->size = size;
+
+    // fit as many elements into a leaf as possible
+    // without going over BLIST_LEAF_BYTES
+    list->per_leaf = BLIST_MIN_PER_LEAF;
+    if(size > 0 && (BLIST_LEAF_BYTES / size) > BLIST_MIN_PER_LEAF) {
+        list->per_leaf = BLIST_LEAF_BYTES / size;
+    }
+
+    return list;
+}
+
+blist_t *blist_purge(blist_t *list)
+{
+    if(list->root != NULL) {
+        blist_node_free(list->root, list->height);
+    }
+
+    // reset everything but size and per_leaf
+    list->root = NULL;
+    list->height = 0;
+    list->first = NULL;
+    list->last = NULL;
+    list->length = 0;
+
+    return list;
+}
+
+int blist_free(blist_t *list)
+{
+    // can't free a NULL pointer
+    if(list == NULL) {
+        return -1;
+    }
+
+    blist_purge(list);
+    free(list);
+
+    return 0;
+}
+
+void *blist_append(blist_t *list, const void *data)
+{
+    return blist_insert(list, list->length, data);
+}
+
+void *blist_prepend(blist_t *list, const void *data)
+{
+    return blist_insert(list, 0, data);
+}
+
+void *blist_insert(blist_t *list, size_t pos, const void *data)
+{
+    // can't insert past the end of the list
+    if(pos > list->length) {
+        return NULL;
+    }
+
+    // an empty list gets a leaf as root
+    if(list->root == NULL) {
+        blist_leaf_t *leaf = blist_leaf_new(list);
+
+        if(leaf == NULL) {
+            return NULL;
+        }
+
+        list->root = leaf;
+        list->height = 0;
+        list->first = leaf;
+        list->last = leaf;
+    }
+
+    // split full nodes on the way down, so that there is
+    // always space for the element (or the new node from
+    // the level below). if an allocation fails, the tree
+    // is still valid, it just has some more nodes.
+    if(blist_grow(list) < 0) {
+        return NULL;
+    }
+
+    // remember the path, so the lengths can be updated
+    // once the element is inserted
+    blist_branch_t *path[list->height + 1];
+    size_t index[list->height + 1];
+
+    void *node = list->root;
+    for(size_t height = list->height; height > 0; height--) {
+        blist_branch_t *branch = node;
+
+        // find the child to insert into. if pos is right
+        // between two children, use the left one.
+        size_t i = 0;
+        while(i < (branch->count - 1) && pos > branch->lengths[i]) {
+            pos -= branch->lengths[i];
+            i++;
+        }
+
+        // make sure the child isn't full
+        if(blist_node_count(branch->children[i], height - 1) == blist_node_max(list, height - 1)) {
+            if(blist_branch_split(list, branch, height, i) < 0) {
+                return NULL;
+            }
+
+            // the position could now be in the upper half
+            if(pos > branch->lengths[i]) {
+                pos -= branch->lengths[i];
+                i++;
+            }
+        }
+
+        path[height] = branch;
+        index[height] = i;
+        node = branch->children[i];
+    }
+
+    // insert into the leaf, which has space
+    blist_leaf_t *leaf = node;
+    assert(leaf->count < list->per_leaf);
+
+    memmove(blist_element(list, leaf, pos + 1),
+            blist_element(list, leaf, pos),
+            (leaf->count - pos) * list->size);
+    leaf->count++;
+
+    // update the lengths along the path
+    for(size_t height = list->height; height > 0; height--) {
+        path[height]->lengths[index[height]]++;
+    }
+
+    list->length++;
+
+    void *element = blist_element(list, leaf, pos);
+
+    if(data != NULL) {
+        memcpy(element, data, list->size);
+    }
+
+    return element;
+}
+
+int blist_remove(blist_t *list, size_t pos)
+{
+    // can't remove something which is not in the list
+    if(pos >= list->length) {
+        return -1;
+    }
+
+    blist_node_remove(list, list->root, list->height, pos);
+    list->length--;
+
+    // the tree might have gotten smaller
+    if(list->length == 0) {
+        blist_node_free(list->root, list->height);
+        list->root = NULL;
+        list->height = 0;
+        list->first = NULL;
+        list->last = NULL;
+    } else {
+        blist_shrink(list);
+    }
+
+    return 0;
+}
+
+void *blist_set(blist_t *list, size_t pos, const void *data)
+{
+    blist_leaf_t *leaf = blist_leaf_get(list, &pos);
+
+    // make sure element exists
+    if(leaf == NULL || data == NULL) {
+        return NULL;
+    }
+
+    void *element = blist_element(list, leaf, pos);
+    memcpy(element, data, list->size);
+
+    return element;
+}
+
+void *blist_get(const blist_t *list, size_t pos, void *data)
+{
+    blist_leaf_t *leaf = blist_leaf_get(list, &pos);
+
+    // make sure element exists
+    if(leaf == NULL) {
+        return NULL;
+    }
+
+    void *element = blist_element(list, leaf, pos);
+
+    if(data != NULL) {
+        memcpy(data, element, list->size);
+    }
+
+    return element;
+}
+
+void *blist_pop(blist_t *list, void *data)
+{
+    // make sure list isn't empty
+    if(list->length == 0) {
+        return NULL;
+    }
+
+    // copy data if requested
+    if(data != NULL) {
+        memcpy(data, list->first->data, list->size);
+    }
+
+    blist_remove(list, 0);
+
+    return data;
+}
+
+int blist_swap(blist_t *list, size_t pos_a, size_t pos_b)
+{
+    // if elements don't exist, we can't swap 'em
+    if(pos_a >= list->length || pos_b >= list->length) {
+        return -1;
+    }
+
+    // swapping an element with itself is a nop
+    if(pos_a == pos_b) {
+        return 0;
+    }
+
+    char *a = blist_get(list, pos_a, NULL);
+    char *b = blist_get(list, pos_b, NULL);
+    assert(a != NULL && b != NULL);
+
+    // swap byte by byte, so we don't need a buffer
+    for(size_t i = 0; i < list->size; i++) {
+        swap(a[i], b[i]);
+    }
+
+    return 0;
+}
+
+blist_t *blist_split(blist_t *list, size_t pos)
+{
+    // check if pos actually points to anything useful
+    if(pos >= list->length) {
+        return NULL;
+    }
+
+    // allocate new list
+    blist_t *new = blist_new(list->size);
+
+    if(new == NULL) {
+        return NULL;
+    }
+
+    new->per_leaf = list->per_leaf;
+
+    // check if we should transfer the whole list
+    if(pos == 0) {
+        swap(list->root, new->root);
+        swap(list->height, new->height);
+        swap(list->first, new->first);
+        swap(list->last, new->last);
+        swap(list->length, new->length);
+        return new;
+    }
+
+    size_t height = list->height;
+
+    // the right half needs a new node on every level,
+    // allocate them up front so we can't fail halfway
+    void *nodes[height + 1];
+    nodes[0] = blist_leaf_new(list);
+    for(size_t h = 1; h <= height; h++) {
+        nodes[h] = blist_branch_new();
+    }
+
+    for(size_t h = 0; h <= height; h++) {
+        if(nodes[h] == NULL) {
+            for(size_t i = 0; i <= height; i++) {
+                free(nodes[i]);
+            }
+
+            free(new);
+            return NULL;
+        }
+    }
+
+    // find the path to pos
+    blist_branch_t *path[height + 1];
+    size_t index[height + 1];
+    size_t offset = pos;
+
+    void *node = list->root;
+    for(size_t h = height; h > 0; h--) {
+        blist_branch_t *branch = node;
+
+        size_t i = 0;
+        while(offset >= branch->lengths[i]) {
+            offset -= branch->lengths[i];
+            i++;
+        }
+
+        path[h] = branch;
+        index[h] = i;
+        node = branch->children[i];
+    }
+
+    // cut the leaf, the elements from offset on go into
+    // the new leaf
+    blist_leaf_t *leaf = node;
+    blist_leaf_t *right_leaf = nodes[0];
+
+    memcpy(right_leaf->data,
+           blist_element(list, leaf, offset),
+           (leaf->count - offset) * list->size);
+    right_leaf->count = leaf->count - offset;
+    leaf->count = offset;
+
+    right_leaf->next = leaf->next;
+    leaf->next = NULL;
+
+    new->first = right_leaf;
+    new->last = (list->last == leaf) ? right_leaf : list->last;
+
+    // now cut every branch on the path. left is the left
+    // part of the cut node one level below (which may be
+    // empty), and right the right part.
+    void *left = leaf;
+    void *right = right_leaf;
+
+    for(size_t h = 1; h <= height; h++) {
+        blist_branch_t *branch = path[h];
+        blist_branch_t *right_branch = nodes[h];
+        size_t i = index[h];
+
+        // the right part gets the right part of the cut
+        // child, and all children after it
+        right_branch->children[0] = right;
+        right_branch->lengths[0] = blist_node_length(right, h - 1);
+        right_branch->count = 1;
+
+        for(size_t j = i + 1; j < branch->count; j++) {
+            right_branch->children[right_branch->count] = branch->children[j];
+            right_branch->lengths[right_branch->count] = branch->lengths[j];
+            right_branch->count++;
+        }
+
+        // the left part keeps everything before it, and the
+        // left part of the cut child if it isn't empty
+        branch->count = i;
+        if(blist_node_count(left, h - 1) > 0) {
+            branch->children[i] = left;
+            branch->lengths[i] = blist_node_length(left, h - 1);
+            branch->count++;
+        } else {
+            free(left);
+        }
+
+        left = branch;
+        right = right_branch;
+    }
+
+    // there is at least one element before pos, so the
+    // left part isn't empty
+    assert(blist_node_count(left, height) > 0);
+
+    new->root = right;
+    new->height = height;
+    new->length = list->length - pos;
+    list->length = pos;
+
+    // the last leaf of the list could have been removed
+    // if it was empty, so find it again
+    node = list->root;
+    for(size_t h = height; h > 0; h--) {
+        blist_branch_t *branch = node;
+        node = branch->children[branch->count - 1];
+    }
+
+    list->last = node;
+    list->last->next = NULL;
+
+    // nodes along the cut can have too few children now
+    blist_repair_right(list);
+    blist_repair_left(new);
+
+    return new;
+}
+
+blist_t *blist_join(blist_t *dest, blist_t *src)
+{
+    // leaves must be interchangeable
+    if(src->size != dest->size || src->per_leaf != dest->per_leaf) {
+        return NULL;
+    }
+
+    // if there is nothing to copy, just return dest
+    if(src->length == 0) {
+        return dest;
+    }
+
+    // if dest is empty, simply take over the tree
+    if(dest->length == 0) {
+        swap(dest->root, src->root);
+        swap(dest->height, src->height);
+        swap(dest->first, src->first);
+        swap(dest->last, src->last);
+        swap(dest->length, src->length);
+        return dest;
+    }
+
+    if(dest->height == src->height) {
+        // both trees become children of a new root
+        blist_branch_t *root = blist_branch_new();
+
+        if(root == NULL) {
+            return NULL;
+        }
+
+        blist_branch_insert(root, 0, dest->root, dest->length);
+        blist_branch_insert(root, 1, src->root, src->length);
+
+        dest->root = root;
+        dest->height++;
+        dest->last->next = src->first;
+        dest->last = src->last;
+
+        // the old roots may have too few children
+        if(blist_node_count(root->children[0], dest->height - 1) < blist_node_min(dest, dest->height - 1) ||
+                blist_node_count(root->children[1], dest->height - 1) < blist_node_min(dest, dest->height - 1)) {
+            blist_rebalance(dest, root, dest->height, 0, true);
+        }
+
+        blist_shrink(dest);
+    } else if(dest->height > src->height) {
+        // hang the root of src into the right edge of
+        // dest, one level above the height of src
+        if(blist_grow(dest) < 0) {
+            return NULL;
+        }
+
+        blist_branch_t *path[dest->height + 1];
+        blist_branch_t *branch = dest->root;
+
+        for(size_t h = dest->height; h > (src->height + 1); h--) {
+            size_t i = branch->count - 1;
+
+            // make sure there is space for another child
+            if(blist_node_count(branch->children[i], h - 1) == BLIST_BRANCHES) {
+                if(blist_branch_split(dest, branch, h, i) < 0) {
+                    return NULL;
+                }
+
+                i++;
+            }
+
+            path[h] = branch;
+            branch = branch->children[i];
+        }
+
+        blist_branch_insert(branch, branch->count, src->root, src->length);
+
+        // update the lengths along the path
+        for(size_t h = dest->height; h > (src->height + 1); h--) {
+            path[h]->lengths[path[h]->count - 1] += src->length;
+        }
+
+        dest->last->next = src->first;
+        dest->last = src->last;
+
+        // the old root of src may have too few children
+        if(blist_node_count(src->root, src->height) < blist_node_min(dest, src->height)) {
+            blist_rebalance(dest, branch, src->height + 1, branch->count - 2, false);
+        }
+    } else {
+        // hang the root of dest into the left edge of
+        // src, one level above the height of dest
+        if(blist_grow(src) < 0) {
+            return NULL;
+        }
+
+        blist_branch_t *path[src->height + 1];
+        blist_branch_t *branch = src->root;
+
+        for(size_t h = src->height; h > (dest->height + 1); h--) {
+            // make sure there is space for another child
+            if(blist_node_count(branch->children[0], h - 1) == BLIST_BRANCHES) {
+                if(blist_branch_split(src, branch, h, 0) < 0) {
+                    return NULL;
+                }
+            }
+
+            path[h] = branch;
+            branch = branch->children[0];
+        }
+
+        blist_branch_insert(branch, 0, dest->root, dest->length);
+
+        // update the lengths along the path
+        for(size_t h = src->height; h > (dest->height + 1); h--) {
+            path[h]->lengths[0] += dest->length;
+        }
+
+        dest->last->next = src->first;
+        src->first = dest->first;
+
+        // the old root of dest may have too few children
+        if(blist_node_count(dest->root, dest->height) < blist_node_min(src, dest->height)) {
+            blist_rebalance(src, branch, dest->height + 1, 0, true);
+        }
+
+        dest->root = src->root;
+        dest->height = src->height;
+        dest->first = src->first;
+        dest->last = src->last;
+    }
+
+    dest->length += src->length;
+
+    // reset src, but keep data size
+    src->root = NULL;
+    src->height = 0;
+    src->first = NULL;
+    src->last = NULL;
+    src->length = 0;
+
+    return dest;
+}
+
+blist_t *blist_copy(const blist_t *list)
+{
+    // allocate a new list
+    blist_t *copy = blist_new(list->size);
+
+    // memory error checking
+    if(copy == NULL) {
+        return NULL;
+    }
+
+    copy->per_leaf = list->per_leaf;
+
+    if(list->root != NULL) {
+        copy->root = blist_node_copy(copy, list->root, list->height);
+
+        if(copy->root == NULL) {
+            free(copy);
+            return NULL;
+        }
+
+        copy->height = list->height;
+        copy->length = list->length;
+    }
+
+    return copy;
+}
+
+int blist_verify(const blist_t *list)
+{
+    if(list == NULL) {
+        return -1;
+    }
+
+    // an empty list has no nodes
+    if(list->length == 0) {
+        if(list->root != NULL || list->first != NULL || list->last != NULL || list->height != 0) {
+            return -2;
+        }
+
+        return 0;
+    }
+
+    if(list->root == NULL) {
+        return -3;
+    }
+
+    // walk the tree, checking that the leaves are linked
+    // in the same order
+    blist_leaf_t *leaf = list->first;
+    size_t length = 0;
+
+    int ret = blist_node_verify(list, list->root, list->height, true, &leaf, &length);
+    if(ret < 0) {
+        return ret;
+    }
+
+    // all leaves must have been visited
+    if(leaf != NULL) {
+        return -4;
+    }
+
+    if(length != list->length) {
+        return -5;
+    }
+
+    if(list->last->next != NULL) {
+        return -6;
+    }
+
+    return 0;
+}
+
+static blist_leaf_t *blist_leaf_new(const blist_t *list)
+{
+    blist_leaf_t *leaf = malloc(sizeof(blist_leaf_t) + (list->per_leaf * list->size));
+
+    if(leaf == NULL) {
+        return NULL;
+    }
+
+    leaf->next = NULL;
+    leaf->count = 0;
+
+    return leaf;
+}
+
+static blist_branch_t *blist_branch_new(void)
+{
+    blist_branch_t *branch = malloc(sizeof(blist_branch_t));
+
+    if(branch == NULL) {
+        return NULL;
+    }
+
+    branch->count = 0;
+
+    return branch;
+}
+
+static void blist_node_free(void *node, size_t height)
+{
+    if(height > 0) {
+        blist_branch_t *branch = node;
+
+        for(size_t i = 0; i < branch->count; i++) {
+            blist_node_free(branch->children[i], height - 1);
+        }
+    }
+
+    free(node);
+}
+
+static size_t blist_node_count(const void *node, size_t height)
+{
+    if(height == 0) {
+        return ((const blist_leaf_t *) node)->count;
+    }
+
+    return ((const blist_branch_t *) node)->count;
+}
+
+static size_t blist_node_length(const void *node, size_t height)
+{
+    if(height == 0) {
+        return ((const blist_leaf_t *) node)->count;
+    }
+
+    const blist_branch_t *branch = node;
+    size_t length = 0;
+
+    for(size_t i = 0; i < branch->count; i++) {
+        length += branch->lengths[i];
+    }
+
+    return length;
+}
+
+static size_t blist_node_max(const blist_t *list, size_t height)
+{
+    return (height == 0) ? list->per_leaf : BLIST_BRANCHES;
+}
+
+static size_t blist_node_min(const blist_t *list, size_t height)
+{
+    return blist_node_max(list, height) / 2;
+}
+
+static void *blist_node_split(blist_t *list, void *node, size_t height)
+{
+    if(height == 0) {
+        blist_leaf_t *leaf = node;
+        blist_leaf_t *right = blist_leaf_new(list);
+
+        if(right == NULL) {
+            return NULL;
+        }
+
+        // move the upper half into the new leaf
+        size_t half = leaf->count / 2;
+        memcpy(right->data,
+               blist_element(list, leaf, half),
+               (leaf->count - half) * list->size);
+        right->count = leaf->count - half;
+        leaf->count = half;
+
+        // link the new leaf
+        right->next = leaf->next;
+        leaf->next = right;
+
+        if(list->last == leaf) {
+            list->last = right;
+        }
+
+        return right;
+    }
+
+    blist_branch_t *branch = node;
+    blist_branch_t *right = blist_branch_new();
+
+    if(right == NULL) {
+        return NULL;
+    }
+
+    // move the upper half into the new branch
+    size_t half = branch->count / 2;
+    right->count = branch->count - half;
+    memcpy(right->children, &branch->children[half], right->count * sizeof(void*));
+    memcpy(right->lengths, &branch->lengths[half], right->count * sizeof(size_t));
+    branch->count = half;
+
+    return right;
+}
+
+static int blist_branch_split(blist_t *list, blist_branch_t *branch, size_t height, size_t i)
+{
+    assert(branch->count < BLIST_BRANCHES);
+
+    void *child = branch->children[i];
+    void *right = blist_node_split(list, child, height - 1);
+
+    if(right == NULL) {
+        return -1;
+    }
+
+    size_t length = blist_node_length(right, height - 1);
+    branch->lengths[i] -= length;
+    blist_branch_insert(branch, i + 1, right, length);
+
+    return 0;
+}
+
+static void blist_branch_insert(blist_branch_t *branch, size_t i, void *child, size_t length)
+{
+    assert(branch->count < BLIST_BRANCHES);
+
+    memmove(&branch->children[i + 1], &branch->children[i], (branch->count - i) * sizeof(void*));
+    memmove(&branch->lengths[i + 1], &branch->lengths[i], (branch->count - i) * sizeof(size_t));
+    branch->children[i] = child;
+    branch->lengths[i] = length;
+    branch->count++;
+}
+
+static void blist_branch_remove(blist_branch_t *branch, size_t i)
+{
+    memmove(&branch->children[i], &branch->children[i + 1], (branch->count - i - 1) * sizeof(void*));
+    memmove(&branch->lengths[i], &branch->lengths[i + 1], (branch->count - i - 1) * sizeof(size_t));
+    branch->count--;
+}
+
+static void blist_rebalance(blist_t *list, blist_branch_t *branch, size_t height, size_t i, bool left)
+{
+    void *a = branch->children[i];
+    void *b = branch->children[i + 1];
+    size_t count_a = blist_node_count(a, height - 1);
+    size_t count_b = blist_node_count(b, height - 1);
+    size_t total = count_a + count_b;
+
+    if(total <= blist_node_max(list, height - 1)) {
+        // both fit into one node, move everything into a
+        if(height == 1) {
+            blist_leaf_t *leaf_a = a;
+            blist_leaf_t *leaf_b = b;
+
+            memcpy(blist_element(list, leaf_a, count_a), leaf_b->data, count_b * list->size);
+            leaf_a->count = total;
+            leaf_a->next = leaf_b->next;
+
+            if(list->last == leaf_b) {
+                list->last = leaf_a;
+            }
+        } else {
+            blist_branch_t *branch_a = a;
+            blist_branch_t *branch_b = b;
+
+            memcpy(&branch_a->children[count_a], branch_b->children, count_b * sizeof(void*));
+            memcpy(&branch_a->lengths[count_a], branch_b->lengths, count_b * sizeof(size_t));
+            branch_a->count = total;
+        }
+
+        branch->lengths[i] += branch->lengths[i + 1];
+        blist_branch_remove(branch, i + 1);
+        free(b);
+
+        return;
+    }
+
+    // even out the counts
+    size_t target = left ? ((total + 1) / 2) : (total / 2);
+
+    if(height == 1) {
+        blist_leaf_t *leaf_a = a;
+        blist_leaf_t *leaf_b = b;
+
+        if(count_a < target) {
+            // move elements from the front of b to a
+            size_t move = target - count_a;
+            memcpy(blist_element(list, leaf_a, count_a), leaf_b->data, move * list->size);
+            memmove(leaf_b->data, blist_element(list, leaf_b, move), (count_b - move) * list->size);
+            leaf_a->count += move;
+            leaf_b->count -= move;
+        } else if(count_a > target) {
+            // move elements from the back of a to b
+            size_t move = count_a - target;
+            memmove(blist_element(list, leaf_b, move), leaf_b->data, count_b * list->size);
+            memcpy(leaf_b->data, blist_element(list, leaf_a, target), move * list->size);
+            leaf_a->count -= move;
+            leaf_b->count += move;
+        }
+    } else {
+        blist_branch_t *branch_a = a;
+        blist_branch_t *branch_b = b;
+
+        if(count_a < target) {
+            // move children from the front of b to a
+            size_t move = target - count_a;
+            memcpy(&branch_a->children[count_a], branch_b->children, move * sizeof(void*));
+            memcpy(&branch_a->lengths[count_a], branch_b->lengths, move * sizeof(size_t));
+            memmove(branch_b->children, &branch_b->children[move], (count_b - move) * sizeof(void*));
+            memmove(branch_b->lengths, &branch_b->lengths[move], (count_b - move) * sizeof(size_t));
+            branch_a->count += move;
+            branch_b->count -= move;
+        } else if(count_a > target) {
+            // move children from the back of a to b
+            size_t move = count_a - target;
+            memmove(&branch_b->children[move], branch_b->children, count_b * sizeof(void*));
+            memmove(&branch_b->lengths[move], branch_b->lengths, count_b * sizeof(size_t));
+            memcpy(branch_b->children, &branch_a->children[target], move * sizeof(void*));
+            memcpy(branch_b->lengths, &branch_a->lengths[target], move * sizeof(size_t));
+            branch_a->count -= move;
+            branch_b->count += move;
+        }
+    }
+
+    size_t length = branch->lengths[i] + branch->lengths[i + 1];
+    branch->lengths[i] = blist_node_length(a, height - 1);
+    branch->lengths[i + 1] = length - branch->lengths[i];
+}
+
+static int blist_grow(blist_t *list)
+{
+    // nothing to do if the root has space
+    if(blist_node_count(list->root, list->height) < blist_node_max(list, list->height)) {
+        return 0;
+    }
+
+    blist_branch_t *root = blist_branch_new();
+
+    if(root == NULL) {
+        return -1;
+    }
+
+    // the old root becomes the only child of the new one,
+    // and is split in half
+    blist_branch_insert(root, 0, list->root, list->length);
+
+    if(blist_branch_split(list, root, list->height + 1, 0) < 0) {
+        free(root);
+        return -1;
+    }
+
+    list->root = root;
+    list->height++;
+
+    return 0;
+}
+
+static void blist_shrink(blist_t *list)
+{
+    while(list->height > 0 && blist_node_count(list->root, list->height) == 1) {
+        blist_branch_t *root = list->root;
+        list->root = root->children[0];
+        list->height--;
+        free(root);
+    }
+}
+
+static void blist_repair_right(blist_t *list)
+{
+    blist_shrink(list);
+
+    // go down the right edge. every node on it gets at
+    // least one child more than the minimum before we
+    // go into it, so fixing its last child (which might
+    // merge two children) doesn't make it too small.
+    void *node = list->root;
+    for(size_t height = list->height; height > 0; height--) {
+        blist_branch_t *branch = node;
+        size_t need = blist_node_min(list, height - 1) + ((height > 1) ? 1 : 0);
+
+        if(blist_node_count(branch->children[branch->count - 1], height - 1) < need) {
+            assert(branch->count >= 2);
+            blist_rebalance(list, branch, height, branch->count - 2, false);
+        }
+
+        node = branch->children[branch->count - 1];
+    }
+
+    blist_shrink(list);
+}
+
+static void blist_repair_left(blist_t *list)
+{
+    blist_shrink(list);
+
+    // same as blist_repair_right(), but on the left edge
+    void *node = list->root;
+    for(size_t height = list->height; height > 0; height--) {
+        blist_branch_t *branch = node;
+        size_t need = blist_node_min(list, height - 1) + ((height > 1) ? 1 : 0);
+
+        if(blist_node_count(branch->children[0], height - 1) < need) {
+            assert(branch->count >= 2);
+            blist_rebalance(list, branch, height, 0, true);
+        }
+
+        node = branch->children[0];
+    }
+
+    blist_shrink(list);
+}
+
+static void blist_node_remove(blist_t *list, void *node, size_t height, size_t pos)
+{
+    if(height == 0) {
+        blist_leaf_t *leaf = node;
+
+        // close the gap
+        memmove(blist_element(list, leaf, pos),
+                blist_element(list, leaf, pos + 1),
+                (leaf->count - pos - 1) * list->size);
+        leaf->count--;
+
+        return;
+    }
+
+    blist_branch_t *branch = node;
+
+    // find the child holding pos
+    size_t i = 0;
+    while(pos >= branch->lengths[i]) {
+        pos -= branch->lengths[i];
+        i++;
+    }
+
+    blist_node_remove(list, branch->children[i], height - 1, pos);
+    branch->lengths[i]--;
+
+    // if the child got too small, merge it with or
+    // borrow from one of its siblings
+    if(blist_node_count(branch->children[i], height - 1) < blist_node_min(list, height - 1) && branch->count > 1) {
+        if((i + 1) < branch->count) {
+            blist_rebalance(list, branch, height, i, true);
+        } else {
+            blist_rebalance(list, branch, height, i - 1, true);
+        }
+    }
+}
+
+static blist_leaf_t *blist_leaf_get(const blist_t *list, size_t *pos)
+{
+    // pos must be inside the list
+    if(*pos >= list->length) {
+        return NULL;
+    }
+
+    // shortcut for the last leaf, which is used a lot
+    if(*pos >= (list->length - list->last->count)) {
+        *pos -= list->length - list->last->count;
+        return list->last;
+    }
+
+    void *node = list->root;
+    for(size_t height = list->height; height > 0; height--) {
+        blist_branch_t *branch = node;
+
+        size_t i = 0;
+        while(*pos >= branch->lengths[i]) {
+            *pos -= branch->lengths[i];
+            i++;
+        }
+
+        node = branch->children[i];
+    }
+
+    return node;
+}
+
+static void *blist_node_copy(blist_t *copy, const void *node, size_t height)
+{
+    if(height == 0) {
+        const blist_leaf_t *leaf = node;
+        blist_leaf_t *new = blist_leaf_new(copy);
+
+        if(new == NULL) {
+            return NULL;
+        }
+
+        memcpy(new->data, leaf->data, leaf->count * copy->size);
+        new->count = leaf->count;
+
+        // leaves are copied in order, so link them as we go
+        if(copy->last != NULL) {
+            copy->last->next = new;
+        } else {
+            copy->first = new;
+        }
+
+        copy->last = new;
+
+        return new;
+    }
+
+    const blist_branch_t *branch = node;
+    blist_branch_t *new = blist_branch_new();
+
+    if(new == NULL) {
+        return NULL;
+    }
+
+    for(size_t i = 0; i < branch->count; i++) {
+        void *child = blist_node_copy(copy, branch->children[i], height - 1);
+
+        if(child == NULL) {
+            blist_node_free(new, height);
+            return NULL;
+        }
+
+        new->children[i] = child;
+        new->lengths[i] = branch->lengths[i];
+        new->count++;
+    }
+
+    return new;
+}
+
+static int blist_node_verify(const blist_t *list, const void *node, size_t height, bool root, blist_leaf_t **leaf, size_t *length)
+{
+    size_t count = blist_node_count(node, height);
+
+    // nodes may not be overfull, or underfull unless they
+    // are the root
+    if(count > blist_node_max(list, height)) {
+        return -10;
+    }
+
+    if(root) {
+        if(count < ((height > 0) ? 2 : 1)) {
+            return -11;
+        }
+    } else if(count < blist_node_min(list, height)) {
+        return -12;
+    }
+
+    if(height == 0) {
+        // leaves must be linked in order
+        if(node != *leaf) {
+            return -13;
+        }
+
+        if((node == list->last) != (((const blist_leaf_t *) node)->next == NULL)) {
+            return -14;
+        }
+
+        *leaf = ((const blist_leaf_t *) node)->next;
+        *length += count;
+
+        return 0;
+    }
+
+    const blist_branch_t *branch = node;
+
+    for(size_t i = 0; i < branch->count; i++) {
+        size_t child_length = 0;
+
+        int ret = blist_node_verify(list, branch->children[i], height - 1, false, leaf, &child_length);
+        if(ret < 0) {
+            return ret;
+        }
+
+        // the length of every child must be right
+        if(child_length != branch->lengths[i]) {
+            return -15;
+        }
+
+        *length += child_length;
+    }
+
+    return 0;
+}
@@ -0,0 +1,105 @@
+/*! @file allocator.h
+ *  @author Patrick Elsen
+ *  @date 9 Sep 2012
+ *  @copyright 2011, Patrick M. Elsen
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  ### Design Specifications
+ *  - pluggable allocation for all containers
+ *  - an allocator is a set of functions plus a context
+ *    pointer that gets passed to them
+ */
+
+#pragma once
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Allocator.
+ *
+ *  Containers that are initialized with an allocator
+ *  keep a pointer to it and use it for all of their
+ *  allocations, so it needs to stay valid for as long
+ *  as the containers are in use.
+ *
+ *  ### Invariants
+ *
+ *  `alloc` must not be NULL. It returns memory that is
+ *  suitably aligned for any kind of data, or NULL on
+ *  error.
+ *
+ *  `free` gets passed the same size that was used to
+ *  allocate the memory. It may be NULL, in which case
+ *  memory is never released individually (as with an
+ *  arena), and lists don't walk their nodes when they
+ *  are purged.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  void *my_alloc(void *ctx, size_t size) {
+ *      return malloc(size);
+ *  }
+ *
+ *  void my_free(void *ctx, void *ptr, size_t size) {
+ *      free(ptr);
+ *  }
+ *
+ *  allocator_t alloc = {my_alloc, my_free, NULL};
+ *  slist_t *list = slist_new_allocator(sizeof(int), &alloc);
+ *  ```
+ */
+struct allocator
+{
+    //! allocates size bytes
+    void *(*alloc)(void *ctx, size_t size);
+
+    //! releases memory allocated by alloc
+    void  (*free)(void *ctx, void *ptr, size_t size);
+
+    //! passed to alloc and free
+    void *ctx;
+};
+
+typedef struct allocator allocator_t;
+
+/*! Allocates memory with the given allocator.
+ *
+ *  @param allocator the allocator to use, or NULL to
+ *      use malloc()
+ *  @param size how many bytes to allocate
+ *  @return a pointer to the memory, or NULL on error
+ */
+void *allocator_alloc(const allocator_t *allocator, size_t size);
+
+/*! Releases memory with the given allocator.
+ *
+ *  @param allocator the allocator to use, or NULL to
+ *      use free()
+ *  @param ptr the memory to release
+ *  @param size how many bytes were allocated
+ */
+void allocator_free(const allocator_t *allocator, void *ptr, size_t size);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,143 @@
+/*! @file arena.h
+ *  @author Patrick Elsen
+ *  @date 9 Sep 2012
+ *  @copyright 2011, Patrick M. Elsen
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  ### Design Specifications
+ *  - bump allocator for short-lived data
+ *  - memory is only released all at once, with
+ *    arena_reset() or arena_free()
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Chunk of memory of an arena.
+ *
+ *  Memory is handed out from `data`, the first
+ *  `used` bytes of which are already in use.
+ */
+struct arena_chunk
+{
+    //! next (older) chunk
+    struct arena_chunk *next;
+
+    //! how many bytes `data` holds
+    size_t size;
+
+    //! how many bytes of `data` are used
+    size_t used;
+
+    //! the memory itself
+    char *data;
+};
+
+typedef struct arena_chunk arena_chunk_t;
+
+/*! The main arena struct.
+ *
+ *  ### Invariants
+ *
+ *  `chunks` points to the chunk that memory is
+ *  currently handed out from, or NULL if no memory
+ *  has been allocated yet. Older chunks are linked
+ *  through their `next` pointers.
+ */
+struct arena
+{
+    //! current chunk
+    struct arena_chunk *chunks;
+
+    //! how big new chunks should be
+    size_t chunk_size;
+};
+
+typedef struct arena arena_t;
+
+/*! Creates a new arena on the heap.
+ *
+ *  @param chunk_size how many bytes to allocate at
+ *      once, or 0 for a sensible default
+ *  @return the new arena, or NULL on error
+ */
+arena_t *arena_new(size_t chunk_size);
+
+/*! Initializes a given arena.
+ *
+ *  @param arena the arena to initialize
+ *  @param chunk_size how many bytes to allocate at
+ *      once, or 0 for a sensible default
+ *  @return the arena, or NULL on error
+ */
+arena_t *arena_init(arena_t *arena, size_t chunk_size);
+
+/*! Allocates memory from an arena.
+ *
+ *  The memory is suitably aligned for any kind of
+ *  data, and stays valid until the arena is reset
+ *  or freed.
+ *
+ *  @param arena the arena to allocate from
+ *  @param size how many bytes to allocate
+ *  @return a pointer to the memory, or NULL on error
+ */
+void *arena_alloc(arena_t *arena, size_t size);
+
+/*! Releases all memory allocated from an arena at
+ *  once.
+ *
+ *  The most recent chunk is kept around, so that
+ *  an arena that is reset periodically does not have
+ *  to allocate memory again.
+ *
+ *  @warning All pointers handed out by the arena,
+ *      including those of any lists that use it,
+ *      become invalid!
+ *
+ *  @param arena the arena to reset
+ *  @return the arena
+ */
+arena_t *arena_reset(arena_t *arena);
+
+/*! Releases all memory of an arena without freeing
+ *  the arena itself.
+ *
+ *  @param arena the arena to purge
+ *  @return the arena
+ */
+arena_t *arena_purge(arena_t *arena);
+
+/*! Releases all memory of an arena that was created
+ *  with arena_new() and frees the arena itself.
+ *
+ *  @param arena the arena to free
+ *  @return 0 on success, negative on error
+ */
+int arena_free(arena_t *arena);
+
+#ifdef __cplusplus
+}
+#endif
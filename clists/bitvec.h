@@ -33,6 +33,7 @@
 #include <stdlib.h>
 #include <stdbool.h>
 #include <string.h>
+#include "allocator.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -50,6 +51,9 @@ struct bitvec
 
     //! The actual bits
     bitvec_word *data;
+
+    //! Allocator used for the bits and the vector, or NULL
+    const struct allocator *allocator;
 };
 
 typedef struct bitvec bitvec_t;
@@ -68,6 +72,10 @@ bitvec_t *bitvec_new(size_t size, bool val);
 
 bitvec_t *bitvec_init(bitvec_t *vec, size_t size, bool val);
 
+bitvec_t *bitvec_new_allocator(size_t size, bool val, const allocator_t *allocator);
+
+bitvec_t *bitvec_init_allocator(bitvec_t *vec, size_t size, bool val, const allocator_t *allocator);
+
 bitvec_t *bitvec_resize(bitvec_t *vec, size_t size, bool val);
 
 bitvec_t *bitvec_purge(bitvec_t *vec);
@@ -0,0 +1,413 @@
+/*! @file blist.h
+ *  @author Patrick Elsen
+ *  @date 9 Sep 2012
+ *  @copyright 2011, Patrick M. Elsen
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  ### Design Specifications
+ *  - sequence container stored as a B-tree, where every
+ *    branch knows how many elements each of its children
+ *    holds (a counted B-tree)
+ *  - elements are stored in leaves, as contiguous arrays,
+ *    and leaves are linked so iterating is cache friendly
+ *  - getting, setting, inserting and removing elements by
+ *    position as well as splitting and joining lists are
+ *    all O(log n)
+ *  - same interface as slist, so it can be used in its
+ *    place when positional operations dominate
+ *
+ *  @todo test the code extensively
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <string.h>
+
+/*  foreach loop implementation for blist, use like this, assuming the
+ *  list that is to be iterated is called 'list' and of type blist_t*:
+ *
+ *      blist_foreach(list, item) {
+ *          printf("%p", item);
+ *      }
+ *
+ *  since this is implemented as two nested loops, `break` only leaves
+ *  the current leaf, use `goto` to leave the loop early.
+ */
+#define blist_foreach(list, __data) \
+    for(blist_leaf_t *__leaf = (list)->first; __leaf != NULL; __leaf = __leaf->next) \
+        for(void *__data = __leaf->data; \
+                (char*)__data < (__leaf->data + __leaf->count * (list)->size); \
+                __data = (char*)__data + (list)->size)
+
+/*! How many bytes of elements a leaf should hold if the
+ *  elements are small enough. */
+#define BLIST_LEAF_BYTES 512
+
+/*! The minimum amount of elements per leaf. */
+#define BLIST_MIN_PER_LEAF 8
+
+/*! How many children a branch can have. */
+#define BLIST_BRANCHES 16
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Leaf of the tree.
+ *
+ *  Stores up to `per_leaf` elements (as set in the
+ *  list) in `data`, and a pointer to the next leaf.
+ *
+ *  ### Invariants
+ *
+ *  `count` is the number of elements stored in `data`,
+ *  it is never larger than the `per_leaf` of the list,
+ *  and never smaller than half of it, unless the leaf
+ *  is the root of the tree.
+ *
+ *  If `next` is NULL, this is the last leaf of the list.
+ */
+struct blist_leaf
+{
+    //! pointer to next leaf in list
+    struct blist_leaf *next;
+
+    //! how many elements this leaf holds
+    size_t count;
+
+    //! elements
+    char data[];
+};
+
+typedef struct blist_leaf blist_leaf_t;
+
+/*! Branch of the tree.
+ *
+ *  ### Invariants
+ *
+ *  `count` is the number of children, it is never
+ *  larger than BLIST_BRANCHES and never smaller than
+ *  half of it, unless the branch is the root of the
+ *  tree, in which case it has at least two children.
+ *
+ *  `lengths[i]` is the amount of elements in the
+ *  subtree `children[i]`.
+ *
+ *  All children are branches, or all are leaves.
+ */
+struct blist_branch
+{
+    //! how many children this branch has
+    size_t count;
+
+    //! amount of elements in each child
+    size_t lengths[BLIST_BRANCHES];
+
+    //! children, either branches or leaves
+    void *children[BLIST_BRANCHES];
+};
+
+typedef struct blist_branch blist_branch_t;
+
+/*! The main blist struct.
+ *
+ *  ### Invariants
+ *
+ *  If the list is not empty, `root` points to the root of
+ *  the tree, otherwise it is NULL. `height` is 0 if the
+ *  root is a leaf, and otherwise the amount of branches
+ *  on the way from the root to any leaf.
+ *
+ *  `first` and `last` point to the first and last leaf
+ *  of the list if it is not empty, otherwise both are
+ *  NULL.
+ *
+ *  `length` is the amount of elements in the list.
+ *
+ *  `size` is the size of each element and `per_leaf` the
+ *  maximum amount of elements a leaf can hold, both stay
+ *  the same during the whole lifetime of the list.
+ */
+struct blist
+{
+    //! root of the tree, a branch or a leaf
+    void *root;
+
+    //! height of the tree
+    size_t height;
+
+    //! first leaf of the list
+    struct blist_leaf *first;
+
+    //! last leaf of the list
+    struct blist_leaf *last;
+
+    //! length of the list (how many elements)
+    size_t length;
+
+    //! size of each element
+    size_t size;
+
+    //! maximum amount of elements per leaf
+    size_t per_leaf;
+};
+
+typedef struct blist blist_t;
+
+/* BASIC DATA ACCESS */
+
+/*! Returns the size of the elements that the list
+ *  holds in bytes.
+ *
+ *  @param list the list in question
+ *  @return the size of the elements, or 0 if passed NULL
+ */
+size_t blist_size(const blist_t *list);
+
+/*! Returns the length of the list (how many elements
+ *  are in it).
+ *
+ *  @param list the list in question
+ *  @return the length of the list, or 0 if passed NULL
+ */
+size_t blist_length(const blist_t *list);
+
+/*! Returns a pointer to the first element in the list.
+ *
+ *  @param list the list in question
+ *  @return a pointer to the first element, or NULL if
+ *      the list is NULL or empty
+ */
+void *blist_first(const blist_t *list);
+
+/*! Returns a pointer to the last element in the list.
+ *
+ *  @param list the list in question
+ *  @return a pointer to the last element, or NULL if
+ *      the list is NULL or empty
+ */
+void *blist_last(const blist_t *list);
+
+/* CREATION/DESTRUCTION FUNCTIONS */
+
+/*! Creates a new blist_t object on the heap with
+ *  elements of the given size.
+ *
+ *  As many elements as fit into BLIST_LEAF_BYTES
+ *  (but at least BLIST_MIN_PER_LEAF) are stored
+ *  per leaf.
+ *
+ *  @param size the size of the elements that this
+ *      list contains
+ *  @return a pointer to the allocated list, or NULL
+ *      on error
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  blist_t *list = blist_new(sizeof(int));
+ *
+ *  if(list == NULL) {
+ *      // error!
+ *  }
+ *  ```
+ */
+blist_t *blist_new(size_t size);
+
+/*! Initializes a given blist object for use with
+ *  objects of the given size.
+ *
+ *  @warning Assumes that the list is either
+ *      uninitialized or empty. If not, it will
+ *      leak memory!
+ *
+ *  @param list the list to be initialized
+ *  @param size the size of the elements that the
+ *      list should hold
+ *  @return a pointer to the initialized list, or
+ *      NULL on error
+ */
+blist_t *blist_init(blist_t *list, size_t size);
+
+/*! Takes an existing (already initialized) list and
+ *  removes all its elements.
+ *
+ *  @param list the list to be purged
+ *  @return the purged list
+ */
+blist_t *blist_purge(blist_t *list);
+
+/*! Takes an existing list that has been allocated
+ *  on the heap (for example with blist_new()),
+ *  free()s all of the data and then the list itself.
+ *
+ *  @param list the list to free
+ *  @return 0 on success, negative on error
+ */
+int     blist_free (blist_t *list);
+
+/* INSERTION/REMOVAL */
+
+/*! Appends some data to the end of a list.
+ *
+ *  @warning This function returns a pointer to the
+ *      newly created element. Please note that
+ *      this pointer is only valid until the next
+ *      mutating library call.
+ *
+ *  @param list the list to append data to
+ *  @param data the data to append, or NULL
+ *  @return a pointer to the newly created element,
+ *      or NULL on error
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  blist_t *list = blist_new(sizeof(int));
+ *
+ *  int d = 5;
+ *  if(NULL == blist_append(list, &d)) {
+ *      // error!
+ *  }
+ *  ```
+ */
+void *blist_append (blist_t *list, const void *data);
+
+/*! Prepends some data to the beginning of a list.
+ *
+ *  @param list the list to prepend to
+ *  @param data the data to prepend, or NULL
+ *  @return a pointer to the newly created element,
+ *      valid until the next mutating call, or NULL
+ *      on error
+ */
+void *blist_prepend(blist_t *list, const void *data);
+
+/*! Inserts an element at the given position in
+ *  O(log n).
+ *
+ *  @param list the list to insert data to
+ *  @param pos the position to insert that data in
+ *  @param data the data to insert, or `NULL`
+ *  @return a pointer to the inserted element, valid
+ *      until the next mutating call, or NULL on error
+ */
+void *blist_insert (blist_t *list, size_t pos, const void *data);
+
+/*! Removes the element at the given position in
+ *  O(log n).
+ *
+ *  @param list the list to remove the element from
+ *  @param pos the position of the element to remove
+ *  @return 0 on success, negative if the element does
+ *      not exist
+ */
+int   blist_remove (blist_t *list, size_t pos);
+
+/* ACCESS/MODIFICATION */
+
+/*! Sets the data of the element at the given index
+ *  in O(log n).
+ *
+ *  @param list the list to work on
+ *  @param pos the position of the element to set
+ *  @param data a non-`NULL` pointer to the data that
+ *      is copied into the element
+ *  @return a pointer to the element, or NULL on error
+ */
+void *blist_set(blist_t *list, size_t pos, const void *data);
+
+/*! Gets a pointer to the data at pos in O(log n).
+ *
+ *  @param list the list to work on
+ *  @param pos the position of the element
+ *  @param data optionally, a non-NULL pointer that the
+ *      element is copied into
+ *  @return a pointer to the element, or NULL on error
+ */
+void *blist_get(const blist_t *list, size_t pos, void *data);
+
+/*! Removes the first element of the list.
+ *
+ *  @param list the list to work on
+ *  @param data optionally, a non-NULL pointer
+ *      to store the data of the popped element in
+ *  @return if data was non-NULL, returns data on
+ *      success and NULL on failure
+ */
+void *blist_pop(blist_t *list, void *data);
+
+/*! Swaps two elements in the list by position.
+ *
+ *  @param list the list to operate on
+ *  @param a the index of the first element
+ *  @param b the index of the second element
+ *  @return 0 on success, negative on error
+ */
+int blist_swap(blist_t *list, size_t a, size_t b);
+
+/* MODIFICATION OF LISTS */
+
+/*! Splits the list into two lists, so that the
+ *  element at pos is the first element of the
+ *  second (split-off) list.
+ *
+ *  The tree is cut along the path to pos, so this
+ *  is O(log n).
+ *
+ *  @param list the list to split
+ *  @param pos the position of the first element of the
+ *      resulting split list.
+ *  @return a new list containing all elements starting
+ *      at pos from the passed list, or NULL on error
+ */
+blist_t *blist_split(blist_t *list, size_t pos);
+
+/*! Joins two lists together to one big one.
+ *
+ *  This function moves all elements from `src` into
+ *  `dest`, leaving `src` as an empty list. The smaller
+ *  tree is hung into the larger one, so this is
+ *  O(log n).
+ *
+ *  @param dest the list to add all elements from
+ *      src to
+ *  @param src the list from which the elements
+ *      are taken
+ *  @return dest on success, or NULL on error
+ */
+blist_t *blist_join(blist_t *dest, blist_t *src);
+
+/*! Creates a copy of a list.
+ *
+ *  @param list the list to copy
+ *  @return a copy of the list, or NULL on error
+ */
+blist_t *blist_copy(const blist_t *list);
+
+/*! Verifies that a list is correct.
+ *
+ *  It exists only for internal testing purposes.
+ */
+int blist_verify(const blist_t *list);
+
+#ifdef __cplusplus
+}
+#endif
@@ -36,6 +36,10 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include "pool.h"
+#include "arena.h"
+#include "allocator.h"
+#include "locality.h"
 
 /*  macro foreach loop implementations for dlist
  *
@@ -112,6 +116,25 @@ typedef struct dlist_node dlist_node_t;
  *  as well as some convenience data like the 
  *  `length` of the list of the last node `tail`
  *  so we don't have to compute them all the time.
+ *
+ *  If `pool` is not NULL, nodes are allocated from
+ *  it and put back into it when they are removed,
+ *  instead of using malloc() and free().
+ *
+ *  If `arena` is not NULL, nodes are allocated from
+ *  it and never released individually, they go away
+ *  when the arena is reset.
+ *
+ *  If `allocator` is not NULL, nodes are allocated and
+ *  released with it.
+ *
+ *  Otherwise, nodes are allocated with malloc(), going
+ *  through the node cache if it is enabled (see
+ *  nodecache.h).
+ *
+ *  If `index` is not NULL, the list keeps a skip-list
+ *  style index over its nodes which makes access by
+ *  position O(log n), see dlist_index_enable().
  */
 struct dlist
 {
@@ -128,10 +151,94 @@ struct dlist
     //! the size of the elements of the
     //! list
     size_t size;
+
+    //! pool to allocate nodes from, or NULL
+    struct pool *pool;
+
+    //! arena to allocate nodes from, or NULL
+    struct arena *arena;
+
+    //! allocator to allocate nodes with, or NULL
+    const struct allocator *allocator;
+
+    //! index for positional access, or NULL
+    struct dlist_index *index;
 };
 
 typedef struct dlist dlist_t;
 
+/*! Function to compare two elements.
+ *
+ *  Used by dlist_sort() to order the elements
+ *  of a list.
+ *
+ *  @param a the first element
+ *  @param b the second element
+ *  @return
+ *      - 0 if they are equal
+ *      - -1 if a > b
+ *      - 1 if a < b
+ */
+typedef int dlist_compare_elements(void *a, void *b);
+
+/*! Element classification function.
+ *
+ *  Used by dlist_partition() to decide which list an
+ *  element should be moved to.
+ *
+ *  @param data the element
+ *  @param ctx the context pointer passed to
+ *      dlist_partition()
+ *  @return the index of the list to move the element to
+ */
+typedef size_t dlist_classify_element(void *data, void *ctx);
+
+/*! Element initialization function.
+ *
+ *  Used by dlist_append_with() and friends to build an
+ *  element directly inside its node, instead of copying
+ *  it there from somewhere else.
+ *
+ *  @param data the uninitialized element
+ *  @param ctx the context pointer passed along with
+ *      the function
+ *  @return 0 on success, or negative if the element
+ *      could not be initialized
+ */
+typedef int dlist_init_element(void *data, void *ctx);
+
+/*! Cursor pointing at a node of a dlist.
+ *
+ *  Cursors allow walking a list and modifying it at the
+ *  current position without looking up nodes by their
+ *  position every time. See dlist_cursor_init().
+ *
+ *  ### Invariants
+ *
+ *  `node` is the node at position `pos` in `list`, or
+ *  NULL if the cursor is past the end of the list, in
+ *  which case `pos` is the length of the list.
+ *
+ *  @warning A cursor is only valid as long as the list
+ *      is modified only through it. Any other change to
+ *      the list (including through another cursor) can
+ *      leave it pointing to a freed node or make `pos`
+ *      wrong, so it must be initialized again.
+ */
+struct dlist_cursor
+{
+    //! the list the cursor belongs to
+    struct dlist *list;
+
+    //! the current node, or NULL if past the end
+    struct dlist_node *node;
+
+    //! position of the current node
+    size_t pos;
+};
+
+typedef struct dlist_cursor dlist_cursor_t;
+
 /*! Returns the size of the elements that the list
  *  holds in bytes.
  *
@@ -312,9 +419,266 @@ dlist_t *dlist_new(size_t size);
  */
 dlist_t *dlist_init(dlist_t *list, size_t size);
 
+/*! Creates a new dlist_t object on the heap whose
+ *  nodes are allocated from a pool.
+ *
+ *  See dlist_init_pooled() for details.
+ *
+ *  @param size the size of the elements that this
+ *      list contains
+ *  @param nodes_per_slab how many nodes to allocate
+ *      at once, or 0 for a sensible default
+ *  @return a pointer to the allocated list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ */
+dlist_t *dlist_new_pooled(size_t size, size_t nodes_per_slab);
+
+/*! Initializes a given dlist object whose nodes are
+ *  allocated from a pool.
+ *
+ *  Instead of calling malloc() and free() for every
+ *  node, the list carves nodes out of slabs holding
+ *  `nodes_per_slab` nodes each, and recycles nodes
+ *  that are removed or popped. Once the list has
+ *  reached its working size, appending and popping
+ *  does not call malloc() or free() at all.
+ *
+ *  The pool is shared with lists that are split off
+ *  or copied from this list. Purging the list keeps
+ *  the pool, so a purged list reuses its nodes; it is
+ *  released when the last list using it is freed (or
+ *  released with dlist_release()).
+ *
+ *  @warning Assumes that the list is either 
+ *      uninitialized or empty. If not, it will 
+ *      leak memory!
+ *
+ *  @param list the list to be initialized
+ *  @param size the size of the elements that the
+ *      list should hold
+ *  @param nodes_per_slab how many nodes to allocate
+ *      at once, or 0 for a sensible default
+ *  @return a pointer to the initialized list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  dlist_t list;
+ *  
+ *  if(NULL == dlist_init_pooled(&list, sizeof(int), 64)) {
+ *      // error!
+ *  }
+ *  ```
+ */
+dlist_t *dlist_init_pooled(dlist_t *list, size_t size, size_t nodes_per_slab);
+
+/*! Creates a new dlist_t object inside of an arena.
+ *
+ *  Both the list itself and all of its nodes are
+ *  allocated from the arena. See dlist_init_arena()
+ *  for details.
+ *
+ *  @param size the size of the elements that this
+ *      list contains
+ *  @param arena the arena to allocate from
+ *  @return a pointer to the allocated list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ */
+dlist_t *dlist_new_arena(size_t size, arena_t *arena);
+
+/*! Initializes a given dlist object whose nodes are
+ *  allocated from an arena.
+ *
+ *  Nodes of such a list are never released one by
+ *  one: removing or popping elements does not free
+ *  anything, and dlist_purge() and dlist_free() don't
+ *  have to walk the list at all. All memory of the
+ *  list is released at once with arena_reset() or
+ *  arena_free().
+ *
+ *  Lists that are split off or copied from this
+ *  list use the same arena. Lists using an arena
+ *  can only be joined with lists using the same
+ *  arena.
+ *
+ *  @warning dlist_free() does not free() a list that
+ *      uses an arena, so the list itself must either
+ *      be allocated with dlist_new_arena() or live in
+ *      memory owned by the caller.
+ *
+ *  @param list the list to be initialized
+ *  @param size the size of the elements that the
+ *      list should hold
+ *  @param arena the arena to allocate from
+ *  @return a pointer to the initialized list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  arena_t *arena = arena_new(0);
+ *
+ *  for(int request = 0; request < 100; request++) {
+ *      dlist_t *list = dlist_new_arena(sizeof(int), arena);
+ *
+ *      dlist_append(list, &request);
+ *      dlist_append(list, &request);
+ *
+ *      // throw away all lists at once
+ *      arena_reset(arena);
+ *  }
+ *
+ *  arena_free(arena);
+ *  ```
+ */
+dlist_t *dlist_init_arena(dlist_t *list, size_t size, arena_t *arena);
+
+/*! Creates a new dlist_t object using a custom
+ *  allocator.
+ *
+ *  Both the list itself and all of its nodes are
+ *  allocated with the allocator. See
+ *  dlist_init_allocator() for details.
+ *
+ *  @param size the size of the elements that this
+ *      list contains
+ *  @param allocator the allocator to use, or NULL
+ *      to use malloc()
+ *  @return a pointer to the allocated list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ */
+dlist_t *dlist_new_allocator(size_t size, const allocator_t *allocator);
+
+/*! Initializes a given dlist object whose nodes are
+ *  allocated with a custom allocator.
+ *
+ *  The list keeps a pointer to the allocator, so it
+ *  needs to stay valid for as long as the list is
+ *  in use. Lists that are split off or copied from
+ *  this list use the same allocator, and lists can
+ *  only be joined with lists using the same
+ *  allocator.
+ *
+ *  If the allocator has no `free` function, nodes
+ *  are never released individually and
+ *  dlist_purge() does not walk the list.
+ *
+ *  @warning dlist_free() releases the list itself with
+ *      the allocator, so lists that were not created
+ *      with dlist_new_allocator() should only be purged.
+ *
+ *  @param list the list to be initialized
+ *  @param size the size of the elements that the
+ *      list should hold
+ *  @param allocator the allocator to use, or NULL
+ *      to use malloc()
+ *  @return a pointer to the initialized list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  allocator_t huge = {huge_alloc, huge_free, region};
+ *  dlist_t list;
+ *  
+ *  if(NULL == dlist_init_allocator(&list, sizeof(int), &huge)) {
+ *      // error!
+ *  }
+ *  ```
+ */
+dlist_t *dlist_init_allocator(dlist_t *list, size_t size, const allocator_t *allocator);
+
+/*! Enables the positional index of a list.
+ *
+ *  The index is a skip list laid over the nodes of
+ *  the list: about every fourth node gets a tower of
+ *  express lanes, and every lane remembers how many
+ *  elements it skips. This makes dlist_get(),
+ *  dlist_set(), dlist_insert(), dlist_remove() and
+ *  dlist_swap() O(log n) instead of O(n), at the cost
+ *  of some memory and a little work on every insertion
+ *  and removal. The nodes themselves are not changed,
+ *  so dlist_foreach() works as usual.
+ *
+ *  Operations that add or remove a range of nodes, like
+ *  dlist_insert_range(), dlist_remove_range(),
+ *  dlist_generate(), dlist_pop_many(), dlist_splice(),
+ *  dlist_split() or dlist_join(), update the index in
+ *  place, in O(log n + count) time. Operations that
+ *  reorder the whole list (dlist_partition(),
+ *  dlist_reverse() and the sorting functions) don't,
+ *  the index is rebuilt the next time it is needed
+ *  instead, which takes O(n) time and allocates a new
+ *  set of towers.
+ *
+ *  The index is released when the list is purged.
+ *
+ *  @param list the list to index
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative value if the index could not
+ *  be allocated. The list can still be used, but
+ *  positional access stays O(n).
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  dlist_t *list = dlist_new(sizeof(int));
+ *
+ *  if(dlist_index_enable(list) < 0) {
+ *      // error!
+ *  }
+ *
+ *  for(int i = 0; i < 1000000; i++) {
+ *      dlist_append(list, &i);
+ *  }
+ *
+ *  // this doesn't walk half of the list
+ *  int *elem = dlist_get(list, 500000, NULL);
+ *  assert(*elem == 500000);
+ *  ```
+ */
+int dlist_index_enable(dlist_t *list);
+
+/*! Disables the positional index of a list and
+ *  releases it.
+ *
+ *  @param list the list
+ *  @return 0 on success, negative on error
+ */
+int dlist_index_disable(dlist_t *list);
+
 /*! Takes an existing (already initialized) list,
  *  removes all its elements and frees it.
  *
+ *  If the list uses a pool, the nodes are put back
+ *  into it and the list keeps using the pool, so
+ *  appending to the purged list reuses them. Use
+ *  dlist_release() to drop the pool as well. If the
+ *  list uses an arena, this does not need to walk the
+ *  list. The index (if any) is released as well.
+ *
  *  @warning Make sure that the list has been initialized,
  *      otherwise this function will cause undefined
  *      behavior!
@@ -342,6 +706,38 @@ dlist_t *dlist_init(dlist_t *list, size_t size);
  */
 dlist_t *dlist_purge(dlist_t *list);
 
+/*! Purges a list and drops its reference to its pool.
+ *
+ *  This is what dlist_free() does before freeing the list
+ *  itself. Use it to clean up a pooled list that was
+ *  initialized in place with dlist_init_pooled(), since
+ *  dlist_purge() keeps the pool around. Lists without a
+ *  pool are just purged. Afterwards, the list allocates
+ *  its nodes like a list created with dlist_init().
+ *
+ *  @param list the list to be released
+ *  @return the released list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL in case of error.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  dlist_t list;
+ *  dlist_init_pooled(&list, sizeof(int), 64);
+ *
+ *  int i = 5;
+ *  dlist_append(&list, &i);
+ *
+ *  if(NULL == dlist_release(&list)) {
+ *      // error!
+ *  }
+ *  ```
+ */
+dlist_t *dlist_release(dlist_t *list);
+
 /*! Takes an existing list that has been allocated 
  *  on the heap (for example withwith dlist_new()),
  *  free()s all of the data and then the list itself.
@@ -504,6 +900,99 @@ void *dlist_prepend(dlist_t *list, void *data);
  */
 void *dlist_insert (dlist_t *list, size_t pos, void *data);
 
+/*! Appends an element that is built in place.
+ *
+ *  Allocates a new node at the end of the list and
+ *  calls `init` to build the element inside of it, so
+ *  that large elements don't have to be built somewhere
+ *  else first and then copied.
+ *
+ *  @param list the list to append to
+ *  @param init the function that initializes the element
+ *  @param ctx a pointer passed on to init
+ *  @return a pointer to the new element, or NULL on
+ *      error
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL and leaves the list unchanged if init
+ *  is NULL, if the node can't be allocated or if init
+ *  returns a negative integer.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int read_record(void *data, void *ctx) {
+ *      return (fread(data, sizeof(record_t), 1, ctx) == 1) ? 0 : -1;
+ *  }
+ *
+ *  while(dlist_append_with(list, read_record, file) != NULL);
+ *  ```
+ */
+void *dlist_append_with(dlist_t *list, dlist_init_element *init, void *ctx);
+
+/*! Prepends an element that is built in place.
+ *
+ *  Works like dlist_append_with(), but puts the new
+ *  element at the front of the list.
+ *
+ *  @param list the list to prepend to
+ *  @param init the function that initializes the element
+ *  @param ctx a pointer passed on to init
+ *  @return a pointer to the new element, or NULL on
+ *      error
+ */
+void *dlist_prepend_with(dlist_t *list, dlist_init_element *init, void *ctx);
+
+/*! Inserts an element that is built in place.
+ *
+ *  Works like dlist_append_with(), but puts the new
+ *  element at `pos`.
+ *
+ *  @param list the list to insert into
+ *  @param pos the position of the new element, up to
+ *      the length of the list
+ *  @param init the function that initializes the element
+ *  @param ctx a pointer passed on to init
+ *  @return a pointer to the new element, or NULL on
+ *      error (also if pos is past the end of the list)
+ */
+void *dlist_insert_with(dlist_t *list, size_t pos, dlist_init_element *init, void *ctx);
+
+/*! Appends a number of elements that are built in place.
+ *
+ *  Allocates `count` nodes in one batch (for pooled
+ *  lists, from a single slab), calls `init` on each of
+ *  them in order, and then appends them all to the list.
+ *
+ *  @param list the list to append to
+ *  @param count how many elements to append
+ *  @param init the function that initializes the elements
+ *  @param ctx a pointer passed on to init
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves the list
+ *  unchanged if init is NULL, if the nodes can't be
+ *  allocated or if init returns a negative integer
+ *  for any of the elements.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int count_up(void *data, void *ctx) {
+ *      *((int*)data) = (*((int*)ctx))++;
+ *      return 0;
+ *  }
+ *
+ *  // append the numbers 0 to 99
+ *  int next = 0;
+ *  assert(dlist_generate(list, 100, count_up, &next) == 0);
+ *  ```
+ */
+int dlist_generate(dlist_t *list, size_t count, dlist_init_element *init, void *ctx);
+
 /*! Removes a given element from the list.
  *  
  *  This function attempts to remove the element
@@ -601,6 +1090,101 @@ void *dlist_set(dlist_t *list, size_t pos, void *data);
  */
 void *dlist_get(dlist_t *list, size_t pos, void *data);
 
+/*! Copies a range of elements out of the list.
+ *
+ *  Copies the `count` elements starting at `pos` into
+ *  the array `out`, one after another. The position is
+ *  looked up once, and the range is read in one pass,
+ *  which is much faster than calling dlist_get() for
+ *  every element.
+ *
+ *  @param list the list to read from
+ *  @param pos the position of the first element
+ *  @param count how many elements to copy
+ *  @param out an array with room for `count` elements
+ *  @return out on success, or NULL on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL if out is NULL or if the range does not
+ *  lie within the list.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int window[16];
+ *  assert(dlist_get_range(list, 32, 16, window) == window);
+ *  ```
+ */
+void *dlist_get_range(dlist_t *list, size_t pos, size_t count, void *out);
+
+/*! Overwrites a range of elements of the list.
+ *
+ *  Copies `count` elements from the array `data` into
+ *  the elements starting at `pos`, in one pass.
+ *
+ *  @param list the list to write to
+ *  @param pos the position of the first element
+ *  @param count how many elements to overwrite
+ *  @param data an array holding `count` elements
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves the list
+ *  unchanged if data is NULL or if the range does not
+ *  lie within the list.
+ */
+int dlist_set_range(dlist_t *list, size_t pos, size_t count, const void *data);
+
+/*! Inserts a range of elements into the list.
+ *
+ *  Inserts `count` elements copied from the array
+ *  `data`, so that the first of them ends up at `pos`.
+ *  All nodes are allocated before the list is changed,
+ *  and for pooled lists they are taken from a single
+ *  slab, so they lie next to each other in memory.
+ *
+ *  @param list the list to insert into
+ *  @param pos the position to insert at, up to the
+ *      length of the list
+ *  @param data an array holding `count` elements, or
+ *      NULL to leave the new elements uninitialized
+ *  @param count how many elements to insert
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves the list
+ *  unchanged if pos is past the end of the list or
+ *  if the nodes can't be allocated.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int batch[] = { 1, 2, 3, 4 };
+ *  assert(dlist_insert_range(list, 0, batch, 4) == 0);
+ *  ```
+ */
+int dlist_insert_range(dlist_t *list, size_t pos, const void *data, size_t count);
+
+/*! Removes a range of elements from the list.
+ *
+ *  Removes the `count` elements starting at `pos` in a
+ *  single pass.
+ *
+ *  @param list the list to remove from
+ *  @param pos the position of the first element
+ *  @param count how many elements to remove
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves the list
+ *  unchanged if the range does not lie within the list.
+ */
+int dlist_remove_range(dlist_t *list, size_t pos, size_t count);
+
 /*! Removes the first element of the list.
  *
  *  If a non-NULL `data` pointer is provided, 
@@ -640,6 +1224,52 @@ void *dlist_get(dlist_t *list, size_t pos, void *data);
  */
 void *dlist_pop(dlist_t *list, void *data);
 
+/*! Removes up to `max` elements from the front of the
+ *  list.
+ *
+ *  The elements are detached from the list in one go,
+ *  their data is copied into `out` one after another,
+ *  and then their nodes are released. This saves the
+ *  per-element bookkeeping of calling dlist_pop() in a
+ *  loop.
+ *
+ *  @param list the list to work on
+ *  @param out optionally, an array with room for `max`
+ *      elements to store the popped elements in
+ *  @param max the maximum number of elements to pop
+ *  @return the number of elements popped, which is less
+ *      than max if the list held fewer elements
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int batch[64];
+ *  size_t count;
+ *
+ *  while((count = dlist_pop_many(queue, batch, 64)) > 0) {
+ *      process(batch, count);
+ *  }
+ *  ```
+ */
+size_t dlist_pop_many(dlist_t *list, void *out, size_t max);
+
+/*! Removes up to `max` elements from the back of the
+ *  list.
+ *
+ *  Works like dlist_pop_many(), but takes the elements
+ *  from the end of the list. They are stored in `out`
+ *  in the order they are popped, so the last element
+ *  of the list comes first.
+ *
+ *  @param list the list to work on
+ *  @param out optionally, an array with room for `max`
+ *      elements to store the popped elements in
+ *  @param max the maximum number of elements to pop
+ *  @return the number of elements popped, which is less
+ *      than max if the list held fewer elements
+ */
+size_t dlist_pop_back_many(dlist_t *list, void *out, size_t max);
+
 /*! Swaps two elements in the list by position.
  *
  *  Given two valid positions in the list, this
@@ -680,6 +1310,133 @@ void *dlist_pop(dlist_t *list, void *data);
  */
 int dlist_swap(dlist_t *list, size_t a, size_t b);
 
+/* CURSORS */
+
+/*! Points a cursor at the given position of a list.
+ *
+ *  This takes as long as dlist_get(), all other cursor
+ *  functions take O(1) time. If the list has an index
+ *  (see dlist_index_enable()), the functions that add
+ *  or remove nodes have to update it as well, which
+ *  makes them O(log n).
+ *
+ *  @param cursor the cursor to initialize
+ *  @param list the list it should point into
+ *  @param pos the position, which may be the length of
+ *      the list to point past the end
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if cursor or list is NULL, or if pos is
+ *  larger than the length of the list.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  dlist_cursor_t cursor;
+ *  dlist_cursor_init(&cursor, list, 0);
+ *
+ *  // remove all negative numbers
+ *  while(dlist_cursor_get(&cursor) != NULL) {
+ *      if(*((int*)dlist_cursor_get(&cursor)) < 0) {
+ *          dlist_remove_at(&cursor);
+ *      } else {
+ *          dlist_cursor_next(&cursor);
+ *      }
+ *  }
+ *  ```
+ */
+int dlist_cursor_init(dlist_cursor_t *cursor, dlist_t *list, size_t pos);
+
+/*! Moves a cursor to the next node.
+ *
+ *  Moving past the last node puts the cursor past the
+ *  end of the list.
+ *
+ *  @param cursor the cursor to move
+ *  @return 0 on success, or negative if the cursor is
+ *      already past the end
+ */
+int dlist_cursor_next(dlist_cursor_t *cursor);
+
+/*! Moves a cursor to the previous node.
+ *
+ *  Moving back from past the end of the list puts the
+ *  cursor on the last node.
+ *
+ *  @param cursor the cursor to move
+ *  @return 0 on success, or negative if the cursor is
+ *      on the first node (or the list is empty)
+ */
+int dlist_cursor_prev(dlist_cursor_t *cursor);
+
+/*! Returns the element the cursor points to.
+ *
+ *  @param cursor the cursor
+ *  @return a pointer to the element, or NULL if the
+ *      cursor is past the end of the list
+ */
+void *dlist_cursor_get(const dlist_cursor_t *cursor);
+
+/*! Returns the position of the cursor.
+ *
+ *  @param cursor the cursor
+ *  @return the position of the node the cursor points
+ *      to, or the length of the list if it is past the
+ *      end
+ */
+size_t dlist_cursor_pos(const dlist_cursor_t *cursor);
+
+/*! Inserts an element before the cursor.
+ *
+ *  If the cursor is past the end of the list, the
+ *  element is appended. The cursor stays on the same
+ *  node (so its position goes up by one).
+ *
+ *  @param cursor the cursor
+ *  @param data the data to insert, or NULL
+ *  @return a pointer to the new element, or NULL on
+ *      error
+ */
+void *dlist_insert_before(dlist_cursor_t *cursor, void *data);
+
+/*! Inserts an element after the cursor.
+ *
+ *  The cursor stays on the same node.
+ *
+ *  @param cursor the cursor
+ *  @param data the data to insert, or NULL
+ *  @return a pointer to the new element, or NULL on
+ *      error (also if the cursor is past the end)
+ */
+void *dlist_insert_after(dlist_cursor_t *cursor, void *data);
+
+/*! Removes the element the cursor points to.
+ *
+ *  The cursor moves on to the following node (or past
+ *  the end of the list), which is now at the same
+ *  position.
+ *
+ *  @param cursor the cursor
+ *  @return 0 on success, or negative if the cursor is
+ *      past the end of the list
+ */
+int dlist_remove_at(dlist_cursor_t *cursor);
+
+/*! Moves the node the cursor points to to the front of
+ *  the list.
+ *
+ *  The node itself is moved, not the element, so
+ *  pointers to it stay valid. The cursor follows the
+ *  node, and is at position 0 afterwards.
+ *
+ *  @param cursor the cursor
+ *  @return 0 on success, or negative if the cursor is
+ *      past the end of the list
+ */
+int dlist_move_to_front(dlist_cursor_t *cursor);
+
 /*! Splits the list into two lists, so that the
  *  element at pos is the first element of the
  *  second (split-off) list. 
@@ -720,6 +1477,12 @@ dlist_t *dlist_split(dlist_t *list, size_t pos);
  *  This function copies all elements from `src`
  *  into `dest`, leaving `src` as an empty list.
  *
+ *  If the lists use different pools, the pools
+ *  are merged, so that nodes can be put back
+ *  into either of them. Lists that use an arena
+ *  or an allocator can only be joined with lists
+ *  using the same arena or allocator.
+ *
  *  @param dest the list to add all elements from
  *      src to
  *  @param src the list from which the elements
@@ -751,12 +1514,139 @@ dlist_t *dlist_split(dlist_t *list, size_t pos);
  */
 dlist_t *dlist_join(dlist_t *dest, dlist_t *src);
 
+/*! Moves a range of elements from one list into
+ *  another.
+ *
+ *  The `count` elements starting at position `from`
+ *  of `src` are taken out of `src` and inserted into
+ *  `dest`, so that the first of them ends up at
+ *  position `dest_pos`. The nodes are relinked, so
+ *  no element is copied and nothing is allocated.
+ *
+ *  Like with dlist_join(), the pools of both lists are
+ *  merged if necessary, and lists that use an arena
+ *  or an allocator can only exchange nodes with lists
+ *  using the same arena or allocator.
+ *
+ *  @param dest the list to move the elements to
+ *  @param dest_pos the position in dest to insert the
+ *      elements at, up to the length of dest
+ *  @param src the list to take the elements from, which
+ *      may not be dest
+ *  @param from the position of the first element to move
+ *  @param count how many elements to move
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves both lists
+ *  unchanged if the element sizes differ, if src and
+ *  dest are the same list, if a position is out of
+ *  range or if the nodes of src can't be moved to dest.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  // move the first ten jobs of one queue to the
+ *  // end of another one
+ *  assert(dlist_splice(other, dlist_length(other), queue, 0, 10) == 0);
+ *  ```
+ */
+int dlist_splice(dlist_t *dest, size_t dest_pos, dlist_t *src, size_t from, size_t count);
+
+/*! Moves the elements between two cursors into another
+ *  list.
+ *
+ *  This works like dlist_splice(), but takes the range
+ *  `[first, end)` of one list and inserts it in front
+ *  of the cursor `dest` of another list, which may be
+ *  past its end. Since the cursors already point to the
+ *  nodes, this takes O(1) time, plus O(log n + count)
+ *  time for updating the index of either list, if they
+ *  have one.
+ *
+ *  Afterwards, `dest` still points to the same node,
+ *  `first` and `end` both point to the node `end`
+ *  pointed to before.
+ *
+ *  @param dest the cursor to insert in front of
+ *  @param first the cursor on the first element to move
+ *  @param end the cursor after the last element to move,
+ *      in the same list as first
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves both lists
+ *  unchanged if first and end are in different lists,
+ *  if end is before first, or in the same cases as
+ *  dlist_splice().
+ */
+int dlist_splice_at(dlist_cursor_t *dest, dlist_cursor_t *first, dlist_cursor_t *end);
+
+/*! Moves every element of a list into one of several
+ *  other lists.
+ *
+ *  Calls `classify` on every element in order, and
+ *  appends the element to `outs[i]`, where `i` is the
+ *  value it returned. Elements for which it returns `n`
+ *  or more stay in `list`. The nodes are relinked, so
+ *  no element is copied and nothing is allocated, and
+ *  every list keeps the original order of the elements.
+ *
+ *  Like with dlist_join(), the pools of the lists are
+ *  merged if necessary, and lists that use an arena or
+ *  an allocator can only exchange nodes with lists
+ *  using the same arena or allocator.
+ *
+ *  @param list the list to partition
+ *  @param classify the function picking the list for
+ *      every element
+ *  @param ctx a pointer passed on to classify
+ *  @param outs the lists to move the elements to, none
+ *      of which may be list. The same list may appear
+ *      more than once.
+ *  @param n the number of lists in outs
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves all lists
+ *  unchanged if classify or outs is NULL, n is zero,
+ *  an output list is NULL, list itself or has a
+ *  different element size, or if the nodes of list
+ *  can't be moved to one of the output lists.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  size_t sign(void *data, void *ctx) {
+ *      return (*((int*)data) < 0) ? 0 : 1;
+ *  }
+ *
+ *  dlist_t *outs[2] = { negative, positive };
+ *  assert(dlist_partition(list, sign, NULL, outs, 2) == 0);
+ *  assert(dlist_length(list) == 0);
+ *  ```
+ */
+int dlist_partition(dlist_t *list, dlist_classify_element *classify, void *ctx, dlist_t **outs, size_t n);
+
 /*! Creates a copy of a list
  *
  *  This function creates a new list, and fills
  *  it up by copying all the elements of the
  *  list passed as parameter.
  *
+ *  The nodes of the copy are allocated as one block
+ *  from a pool, in list order, so that traversing the
+ *  copy touches memory sequentially. If the list uses
+ *  a pool, the copy shares it. If it allocates its
+ *  nodes one by one, the copy gets a pool of its own,
+ *  so it is a pooled list, just as if it had been
+ *  created with dlist_new_pooled(). Lists using an arena
+ *  or an allocator are copied into the same arena or
+ *  allocator, node by node.
+ *
  *  @param list the list to copy
  *  @return a copy of the list passed as parameter,
  *      or NULL on error
@@ -783,6 +1673,169 @@ dlist_t *dlist_join(dlist_t *dest, dlist_t *src);
  */
 dlist_t *dlist_copy(const dlist_t *list);
 
+/*! Creates a new list from an array of elements.
+ *
+ *  The list gets its own pool (see dlist_new_pooled()),
+ *  and all `count` nodes are allocated from a single
+ *  slab of it, one after the other. This means that the
+ *  nodes of the new list lie next to each other in
+ *  memory in list order, so traversing it is as cache
+ *  friendly as it gets, and building it only takes one
+ *  allocation for the nodes.
+ *
+ *  @param data pointer to `count` elements of `size`
+ *      bytes each
+ *  @param count how many elements to copy
+ *  @param size the size of the elements
+ *  @return a new list holding copies of the elements,
+ *      or NULL on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL if memory can't be allocated, or if
+ *  `data` is NULL while `count` isn't zero.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int numbers[] = {1, 2, 3, 4};
+ *
+ *  dlist_t *list = dlist_from_array(numbers, 4, sizeof(int));
+ *  assert(dlist_length(list) == 4);
+ *  ```
+ */
+dlist_t *dlist_from_array(const void *data, size_t count, size_t size);
+
+/*! Copies the elements of a list into an array.
+ *
+ *  @param list the list to copy the elements of
+ *  @param out array with room for all elements of the
+ *      list, or NULL to have one allocated with malloc()
+ *  @return the array the elements were copied to, or
+ *      NULL on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL if list is NULL, or if `out` is NULL
+ *  and memory can't be allocated.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int numbers[4];
+ *  assert(dlist_to_array(list, numbers) == numbers);
+ *  ```
+ */
+void *dlist_to_array(const dlist_t *list, void *out);
+
+/*! Moves all nodes of a list into contiguous memory.
+ *
+ *  After many insertions and removals, the nodes of a
+ *  long-lived list end up spread all over the heap,
+ *  which makes traversing it slow. This allocates new
+ *  nodes as one block from the pool of the list, in
+ *  list order, copies the elements over and releases
+ *  the old nodes.
+ *
+ *  A list that doesn't have a pool gets one, and keeps
+ *  using it afterwards: it becomes a pooled list, just
+ *  as if it had been created with dlist_new_pooled().
+ *  Its old nodes are handed to the node cache. A list
+ *  initialized in place has to be cleaned up with
+ *  dlist_release() after that. Lists using an arena
+ *  or an allocator can't be compacted,
+ *  as there is no way to get contiguous memory from
+ *  them (or to release the old nodes, for arenas).
+ *
+ *  @warning This moves every element, so pointers to
+ *      elements of the list become invalid.
+ *
+ *  @param list the list to compact
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list is NULL, uses an arena or an
+ *  allocator, or if memory can't be allocated. In all
+ *  of these cases, the list is left untouched.
+ */
+int dlist_compact(dlist_t *list);
+
+/*! Compacts a part of a list, so that compaction can
+ *  be done in small steps, for example when idle.
+ *
+ *  Works like dlist_compact() (including giving a list
+ *  without a pool one on the first step), but only
+ *  moves up to `count` nodes starting at position
+ *  `*pos` into a new block, and then advances `*pos`
+ *  past them. Once the end of the list is reached,
+ *  `*pos` is set back to 0. The list can be modified in between steps,
+ *  which at worst means that some nodes are compacted
+ *  twice or not at all in that round.
+ *
+ *  @warning This moves the elements that are compacted,
+ *      so pointers to them become invalid.
+ *
+ *  @param list the list to compact
+ *  @param pos position to start at, which is updated to
+ *      where the next step should start
+ *  @param count maximum amount of nodes to move
+ *  @return 1 if there are nodes left to compact in this
+ *      round, 0 if the end of the list was reached, or
+ *      negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list or pos is NULL, if the list uses
+ *  an arena or an allocator, or if memory can't be
+ *  allocated. The list is left untouched.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  size_t pos = 0;
+ *
+ *  // move 64 nodes every time there is nothing else to do
+ *  while(idle()) {
+ *      if(dlist_compact_step(list, &pos, 64) < 0) {
+ *          // error!
+ *      }
+ *  }
+ *  ```
+ */
+int dlist_compact_step(dlist_t *list, size_t *pos, size_t count);
+
+/*! Reports how well the nodes of a list are laid out in
+ *  memory.
+ *
+ *  Walks the list in order and measures the distances
+ *  between consecutive nodes, how often a step crosses
+ *  into another page and how many pages the nodes are
+ *  on (see locality_stats_t). This can be used to
+ *  decide when a list should be compacted with
+ *  dlist_compact().
+ *
+ *  @param list the list to measure
+ *  @param stats where to store the results
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list or stats is NULL, or if memory
+ *  for the measurement can't be allocated.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  locality_stats_t stats;
+ *
+ *  if(dlist_locality_stats(list, &stats) == 0 && stats.page_cross_fraction > 0.5) {
+ *      dlist_compact(list);
+ *  }
+ *  ```
+ */
+int dlist_locality_stats(const dlist_t *list, locality_stats_t *stats);
+
 /*! Reverses a dlist.
  *
  *  @param list the list to reverse
@@ -791,12 +1844,157 @@ dlist_t *dlist_copy(const dlist_t *list);
  */
 int      dlist_reverse(dlist_t *list);
 
+/*! Sorts a dlist in ascending order.
+ *
+ *  The list is sorted with a bottom-up merge sort,
+ *  which only relinks the nodes: elements are never
+ *  copied and no memory is allocated. It takes
+ *  O(n log n) comparisons and is stable, equal
+ *  elements keep their order.
+ *
+ *  Pointers to elements stay valid, but they will
+ *  (most likely) be at a different position.
+ *
+ *  @param list the list to sort
+ *  @param cmp the function to compare elements with
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list or cmp is NULL.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int compare_ints(void *a, void *b) {
+ *      return *((int*)b) - *((int*)a);
+ *  }
+ *
+ *  dlist_t *list = dlist_new(sizeof(int));
+ *
+ *  int numbers[] = {3, 1, 2};
+ *  for(int i = 0; i < 3; i++) {
+ *      dlist_append(list, &numbers[i]);
+ *  }
+ *
+ *  assert(dlist_sort(list, compare_ints) == 0);
+ *  assert(*((int*)dlist_first(list)) == 1);
+ *  ```
+ */
+int dlist_sort(dlist_t *list, dlist_compare_elements *cmp);
+
+/*! Sorts a dlist in ascending order, using several
+ *  threads.
+ *
+ *  The list is cut into up to `nthreads` chunks, which
+ *  are sorted at the same time with the same merge sort
+ *  as dlist_sort(), each in its own thread. Samples of
+ *  the sorted chunks are used to pick one range of
+ *  values per thread, and every thread then merges the
+ *  parts of all chunks that fall into its range. The
+ *  ranges follow each other, so they only need to be
+ *  chained together at the end. Like dlist_sort(), this
+ *  only relinks nodes, is stable and gives the same
+ *  result.
+ *
+ *  Every chunk gets at least a few thousand elements, so
+ *  short lists use fewer threads (or just the calling
+ *  one), and no more than 64 threads are used at all.
+ *  The threads are started once and do the sorting,
+ *  splitting and merging one after the other. Apart from
+ *  cutting the list into chunks, all of the work is done
+ *  in parallel. If most elements are
+ *  equal, they all end up in the same range, and merging
+ *  them is left to a single thread.
+ *
+ *  @warning `cmp` is called from several threads at
+ *      once, so it must be thread-safe.
+ *
+ *  @param list the list to sort
+ *  @param cmp the function to compare elements with
+ *  @param nthreads the maximum amount of threads to use,
+ *      including the calling one
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list or cmp is NULL. If threads can't
+ *  be started, their share of the work is done by the
+ *  calling thread instead.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  dlist_t *list = dlist_new(sizeof(int));
+ *
+ *  for(int i = 0; i < 1000000; i++) {
+ *      int number = rand();
+ *      dlist_append(list, &number);
+ *  }
+ *
+ *  assert(dlist_sort_parallel(list, compare_ints, 8) == 0);
+ *  ```
+ */
+int dlist_sort_parallel(dlist_t *list, dlist_compare_elements *cmp, size_t nthreads);
+
+/*! Sorts a dlist by an unsigned integer key in ascending
+ *  order.
+ *
+ *  Every element has to contain the key as an unsigned
+ *  integer of `key_width` bytes (in native byte order)
+ *  at `key_offset`, for example a `uint32_t` member of
+ *  a struct.
+ *
+ *  The list is sorted with a least significant digit
+ *  radix sort, which distributes the nodes into bucket
+ *  chains one byte of the key at a time and then
+ *  concatenates the chains. It takes O(n * key_width)
+ *  time, never compares or copies elements and needs no
+ *  memory besides the bucket heads on the stack. It is
+ *  stable, equal keys keep their order.
+ *
+ *  @param list the list to sort
+ *  @param key_offset offset of the key in the elements
+ *  @param key_width size of the key in bytes, 1, 2, 4
+ *      or 8
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list is NULL, if key_width is not one
+ *  of the supported sizes or if the key doesn't fit into
+ *  the elements.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  struct entry {
+ *      uint32_t id;
+ *      double value;
+ *  };
+ *
+ *  dlist_t *list = dlist_new(sizeof(struct entry));
+ *  // ...
+ *
+ *  assert(dlist_radix_sort(list, offsetof(struct entry, id), sizeof(uint32_t)) == 0);
+ *  ```
+ */
+int dlist_radix_sort(dlist_t *list, size_t key_offset, size_t key_width);
+
 /*! Verifies that a list is correct.
  *
  *  This method verifies that a list is correct and
- *  does not have any cycles.
+ *  does not have any cycles, that its length and tail
+ *  match the nodes and that every
+ *  node's `prev` points back to the node before it.
+ *
+ *  It takes O(n) time and doesn't allocate any memory,
+ *  so it can be used on large lists.
  *
  *  It exists only for internal testing purposes.
+ *
+ *  @param list the list to verify
+ *  @return 0 if the list is correct, negative otherwise
  */
 int dlist_verify(const dlist_t *list);
 
@@ -0,0 +1,455 @@
+/*! @file dlist_define.h
+ *  @author Patrick Elsen
+ *  @date 9 Sep 2012
+ *  @copyright 2011, Patrick M. Elsen
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  ### Design Specifications
+ *  - generate a doubly linked list for one element type,
+ *    with the same node layout and semantics as dlist.h
+ *  - header-only: everything is `static inline`, so
+ *    element copies are plain assignments and the
+ *    comparator can be inlined into sorting and searching
+ *  - nodes are allocated with malloc(), there are no
+ *    pools, arenas or allocators
+ */
+
+#pragma once
+
+#include <stdlib.h>
+
+/*! Defines a doubly linked list holding elements of
+ *  type `type`.
+ *
+ *  Expands to the types `name_t` and `name_node_t` and to
+ *  `static inline` functions that work like their
+ *  counterparts in dlist.h, except that elements are
+ *  passed as `type*` instead of `void*`:
+ *
+ *  - `name_t *name_new(void)`, `name_t *name_init(name_t *list)`
+ *  - `name_t *name_purge(name_t *list)`, `int name_free(name_t *list)`
+ *  - `size_t name_length(const name_t *list)`
+ *  - `type *name_first(const name_t *list)`, `type *name_last(const name_t *list)`
+ *  - `type *name_append(name_t *list, const type *data)`
+ *  - `type *name_prepend(name_t *list, const type *data)`
+ *  - `type *name_insert(name_t *list, size_t pos, const type *data)`
+ *  - `int name_remove(name_t *list, size_t pos)`
+ *  - `type *name_set(name_t *list, size_t pos, const type *data)`
+ *  - `type *name_get(const name_t *list, size_t pos, type *data)`
+ *  - `type *name_pop(name_t *list, type *data)`
+ *  - `int name_verify(const name_t *list)`
+ *
+ *  `type` has to be usable as `type*`, so pointer types
+ *  need a typedef first.
+ *
+ *  @param name the prefix of the generated names
+ *  @param type the element type
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  DLIST_DEFINE(intlist, int)
+ *
+ *  intlist_t *list = intlist_new();
+ *  int five = 5;
+ *  assert(intlist_append(list, &five) != NULL);
+ *  assert(*intlist_first(list) == 5);
+ *  intlist_free(list);
+ *  ```
+ */
+#define DLIST_DEFINE(name, type)                                                      \
+    struct name##_node                                                                \
+    {                                                                                 \
+        struct name##_node *prev;                                                     \
+        struct name##_node *next;                                                     \
+        type data;                                                                    \
+    };                                                                                \
+                                                                                      \
+    typedef struct name##_node name##_node_t;                                         \
+                                                                                      \
+    struct name                                                                       \
+    {                                                                                 \
+        struct name##_node *head;                                                     \
+        struct name##_node *tail;                                                     \
+        size_t length;                                                                \
+    };                                                                                \
+                                                                                      \
+    typedef struct name name##_t;                                                     \
+                                                                                      \
+    static inline size_t name##_length(const name##_t *list)                          \
+    {                                                                                 \
+        return list->length;                                                          \
+    }                                                                                 \
+                                                                                      \
+    static inline type *name##_first(const name##_t *list)                            \
+    {                                                                                 \
+        return (list->head != NULL) ? &list->head->data : NULL;                       \
+    }                                                                                 \
+                                                                                      \
+    static inline type *name##_last(const name##_t *list)                             \
+    {                                                                                 \
+        return (list->tail != NULL) ? &list->tail->data : NULL;                       \
+    }                                                                                 \
+                                                                                      \
+    static inline name##_t *name##_init(name##_t *list)                               \
+    {                                                                                 \
+        list->head = NULL;                                                            \
+        list->tail = NULL;                                                            \
+        list->length = 0;                                                             \
+                                                                                      \
+        return list;                                                                  \
+    }                                                                                 \
+                                                                                      \
+    static inline name##_t *name##_new(void)                                          \
+    {                                                                                 \
+        name##_t *list = malloc(sizeof(name##_t));                                    \
+                                                                                      \
+        if(list == NULL) {                                                            \
+            return NULL;                                                              \
+        }                                                                             \
+                                                                                      \
+        return name##_init(list);                                                     \
+    }                                                                                 \
+                                                                                      \
+    static inline name##_t *name##_purge(name##_t *list)                              \
+    {                                                                                 \
+        name##_node_t *node = list->head;                                             \
+                                                                                      \
+        while(node != NULL) {                                                         \
+            name##_node_t *next = node->next;                                         \
+            free(node);                                                               \
+            node = next;                                                              \
+        }                                                                             \
+                                                                                      \
+        return name##_init(list);                                                     \
+    }                                                                                 \
+                                                                                      \
+    static inline int name##_free(name##_t *list)                                     \
+    {                                                                                 \
+        name##_purge(list);                                                           \
+        free(list);                                                                   \
+                                                                                      \
+        return 0;                                                                     \
+    }                                                                                 \
+                                                                                      \
+    static inline name##_node_t *name##_node_get(const name##_t *list, size_t pos)    \
+    {                                                                                 \
+        if(pos >= list->length) {                                                     \
+            return NULL;                                                              \
+        }                                                                             \
+                                                                                      \
+        name##_node_t *node;                                                          \
+                                                                                      \
+        /* walk from whichever end is closer */                                       \
+        if(pos < (list->length / 2)) {                                                \
+            node = list->head;                                                        \
+                                                                                      \
+            while(pos-- > 0) {                                                        \
+                node = node->next;                                                    \
+            }                                                                         \
+        } else {                                                                      \
+            node = list->tail;                                                        \
+                                                                                      \
+            for(pos = list->length - 1 - pos; pos > 0; pos--) {                       \
+                node = node->prev;                                                    \
+            }                                                                         \
+        }                                                                             \
+                                                                                      \
+        return node;                                                                  \
+    }                                                                                 \
+                                                                                      \
+    static inline void name##_node_link(name##_t *list, name##_node_t *node, name##_node_t *next)\
+    {                                                                                 \
+        name##_node_t *prev = (next != NULL) ? next->prev : list->tail;               \
+                                                                                      \
+        node->prev = prev;                                                            \
+        node->next = next;                                                            \
+                                                                                      \
+        if(prev != NULL) {                                                            \
+            prev->next = node;                                                        \
+        } else {                                                                      \
+            list->head = node;                                                        \
+        }                                                                             \
+                                                                                      \
+        if(next != NULL) {                                                            \
+            next->prev = node;                                                        \
+        } else {                                                                      \
+            list->tail = node;                                                        \
+        }                                                                             \
+                                                                                      \
+        list->length++;                                                               \
+    }                                                                                 \
+                                                                                      \
+    static inline type *name##_insert(name##_t *list, size_t pos, const type *data)   \
+    {                                                                                 \
+        if(pos > list->length) {                                                      \
+            return NULL;                                                              \
+        }                                                                             \
+                                                                                      \
+        name##_node_t *node = malloc(sizeof(name##_node_t));                          \
+                                                                                      \
+        if(node == NULL) {                                                            \
+            return NULL;                                                              \
+        }                                                                             \
+                                                                                      \
+        if(data != NULL) {                                                            \
+            node->data = *data;                                                       \
+        }                                                                             \
+                                                                                      \
+        name##_node_link(list, node, name##_node_get(list, pos));                     \
+                                                                                      \
+        return &node->data;                                                           \
+    }                                                                                 \
+                                                                                      \
+    static inline type *name##_append(name##_t *list, const type *data)               \
+    {                                                                                 \
+        return name##_insert(list, list->length, data);                               \
+    }                                                                                 \
+                                                                                      \
+    static inline type *name##_prepend(name##_t *list, const type *data)              \
+    {                                                                                 \
+        return name##_insert(list, 0, data);                                          \
+    }                                                                                 \
+                                                                                      \
+    static inline int name##_remove(name##_t *list, size_t pos)                       \
+    {                                                                                 \
+        if(list->length == 0) {                                                       \
+            return -1;                                                                \
+        } else if(pos >= list->length) {                                              \
+            return -2;                                                                \
+        }                                                                             \
+                                                                                      \
+        name##_node_t *node = name##_node_get(list, pos);                             \
+                                                                                      \
+        if(node->prev != NULL) {                                                      \
+            node->prev->next = node->next;                                            \
+        } else {                                                                      \
+            list->head = node->next;                                                  \
+        }                                                                             \
+                                                                                      \
+        if(node->next != NULL) {                                                      \
+            node->next->prev = node->prev;                                            \
+        } else {                                                                      \
+            list->tail = node->prev;                                                  \
+        }                                                                             \
+                                                                                      \
+        list->length--;                                                               \
+        free(node);                                                                   \
+                                                                                      \
+        return 0;                                                                     \
+    }                                                                                 \
+                                                                                      \
+    static inline type *name##_set(name##_t *list, size_t pos, const type *data)      \
+    {                                                                                 \
+        name##_node_t *node = name##_node_get(list, pos);                             \
+                                                                                      \
+        if(node == NULL || data == NULL) {                                            \
+            return NULL;                                                              \
+        }                                                                             \
+                                                                                      \
+        node->data = *data;                                                           \
+                                                                                      \
+        return &node->data;                                                           \
+    }                                                                                 \
+                                                                                      \
+    static inline type *name##_get(const name##_t *list, size_t pos, type *data)      \
+    {                                                                                 \
+        name##_node_t *node = name##_node_get(list, pos);                             \
+                                                                                      \
+        if(node == NULL) {                                                            \
+            return NULL;                                                              \
+        }                                                                             \
+                                                                                      \
+        if(data != NULL) {                                                            \
+            *data = node->data;                                                       \
+        }                                                                             \
+                                                                                      \
+        return &node->data;                                                           \
+    }                                                                                 \
+                                                                                      \
+    static inline type *name##_pop(name##_t *list, type *data)                        \
+    {                                                                                 \
+        name##_node_t *node = list->head;                                             \
+                                                                                      \
+        if(node == NULL) {                                                            \
+            return NULL;                                                              \
+        }                                                                             \
+                                                                                      \
+        list->head = node->next;                                                      \
+                                                                                      \
+        if(list->head != NULL) {                                                      \
+            list->head->prev = NULL;                                                  \
+        } else {                                                                      \
+            list->tail = NULL;                                                        \
+        }                                                                             \
+                                                                                      \
+        list->length--;                                                               \
+                                                                                      \
+        if(data != NULL) {                                                            \
+            *data = node->data;                                                       \
+        }                                                                             \
+                                                                                      \
+        free(node);                                                                   \
+                                                                                      \
+        return data;                                                                  \
+    }                                                                                 \
+                                                                                      \
+    static inline int name##_verify(const name##_t *list)                             \
+    {                                                                                 \
+        size_t length = 0;                                                            \
+        name##_node_t *prev = NULL;                                                   \
+                                                                                      \
+        for(name##_node_t *node = list->head; node != NULL; node = node->next) {      \
+            /* more nodes than the list claims means a                                \
+             * cycle or a wrong length, stop either way */                            \
+            if(length++ == list->length) {                                            \
+                return -1;                                                            \
+            }                                                                         \
+                                                                                      \
+            if(node->prev != prev) {                                                  \
+                return -4;                                                            \
+            }                                                                         \
+                                                                                      \
+            prev = node;                                                              \
+        }                                                                             \
+                                                                                      \
+        if(length != list->length) {                                                  \
+            return -2;                                                                \
+        }                                                                             \
+                                                                                      \
+        if(prev != list->tail) {                                                      \
+            return -3;                                                                \
+        }                                                                             \
+                                                                                      \
+        return 0;                                                                     \
+    }
+
+/*! Defines sorting and searching for a list defined with
+ *  DLIST_DEFINE().
+ *
+ *  Expands to:
+ *
+ *  - `int name_sort(name_t *list)`, a stable merge sort
+ *    like dlist_sort()
+ *  - `type *name_find(const name_t *list, const type *key)`,
+ *    which returns the first element equal to key, or NULL
+ *
+ *  `cmp` is called as `cmp(const type *a, const type *b)`
+ *  and has to return like dlist_compare_elements: 0 if
+ *  the elements are equal, -1 if a > b and 1 if a < b.
+ *  It can be a function or a macro, and is inlined if the
+ *  compiler can see it.
+ *
+ *  @param name the prefix used with DLIST_DEFINE()
+ *  @param type the element type used with DLIST_DEFINE()
+ *  @param cmp the comparator
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  static inline int int_compare(const int *a, const int *b) {
+ *      return (*a > *b) ? -1 : (*a < *b);
+ *  }
+ *
+ *  DLIST_DEFINE(intlist, int)
+ *  DLIST_DEFINE_SORT(intlist, int, int_compare)
+ *  ```
+ */
+#define DLIST_DEFINE_SORT(name, type, cmp)                                            \
+    static inline name##_node_t *name##_node_cut(name##_node_t *node, size_t count)   \
+    {                                                                                 \
+        for(size_t i = 1; node != NULL && i < count; i++) {                           \
+            node = node->next;                                                        \
+        }                                                                             \
+                                                                                      \
+        if(node == NULL) {                                                            \
+            return NULL;                                                              \
+        }                                                                             \
+                                                                                      \
+        name##_node_t *rest = node->next;                                             \
+        node->next = NULL;                                                            \
+                                                                                      \
+        return rest;                                                                  \
+    }                                                                                 \
+                                                                                      \
+    static inline int name##_sort(name##_t *list)                                     \
+    {                                                                                 \
+        if(list->length < 2) {                                                        \
+            return 0;                                                                 \
+        }                                                                             \
+                                                                                      \
+        name##_node_t *head = list->head;                                             \
+                                                                                      \
+        /* merge runs of width nodes into runs of twice                               \
+         * that by their next pointers, until there is                                \
+         * only one run left */                                                       \
+        for(size_t width = 1; width < list->length; width *= 2) {                     \
+            name##_node_t *rest = head;                                               \
+            name##_node_t **link = &head;                                             \
+                                                                                      \
+            while(rest != NULL) {                                                     \
+                name##_node_t *a = rest;                                              \
+                name##_node_t *b = name##_node_cut(a, width);                         \
+                rest = name##_node_cut(b, width);                                     \
+                                                                                      \
+                /* take from a when equal, to stay stable */                          \
+                while(a != NULL && b != NULL) {                                       \
+                    if(cmp(&a->data, &b->data) >= 0) {                                \
+                        *link = a;                                                    \
+                        a = a->next;                                                  \
+                    } else {                                                          \
+                        *link = b;                                                    \
+                        b = b->next;                                                  \
+                    }                                                                 \
+                                                                                      \
+                    link = &(*link)->next;                                            \
+                }                                                                     \
+                                                                                      \
+                *link = (a != NULL) ? a : b;                                          \
+                                                                                      \
+                while(*link != NULL) {                                                \
+                    link = &(*link)->next;                                            \
+                }                                                                     \
+            }                                                                         \
+        }                                                                             \
+                                                                                      \
+        /* restore the prev pointers and the tail */                                  \
+        name##_node_t *prev = NULL;                                                   \
+                                                                                      \
+        for(name##_node_t *node = head; node != NULL; node = node->next) {            \
+            node->prev = prev;                                                        \
+            prev = node;                                                              \
+        }                                                                             \
+                                                                                      \
+        list->head = head;                                                            \
+        list->tail = prev;                                                            \
+                                                                                      \
+        return 0;                                                                     \
+    }                                                                                 \
+                                                                                      \
+    static inline type *name##_find(const name##_t *list, const type *key)            \
+    {                                                                                 \
+        for(name##_node_t *node = list->head; node != NULL; node = node->next) {      \
+            if(cmp(&node->data, key) == 0) {                                          \
+                return &node->data;                                                   \
+            }                                                                         \
+        }                                                                             \
+                                                                                      \
+        return NULL;                                                                  \
+    }
@@ -0,0 +1,116 @@
+/*! @file locality.h
+ *  @author Patrick Elsen
+ *  @date 9 Sep 2012
+ *  @copyright 2011, Patrick M. Elsen
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  ### Design Specifications
+ *  - measure how well the nodes of a linked container
+ *    are laid out in memory for traversal
+ *  - shared by all linked containers, which pass their
+ *    first node and where the `next` pointer is
+ */
+
+#pragma once
+
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Memory locality of a linked container.
+ *
+ *  Describes how far apart consecutive nodes are in
+ *  memory when the container is traversed. A freshly
+ *  compacted list has all distances equal to the node
+ *  size, hardly crosses any pages and touches about as
+ *  many pages as its nodes need.
+ *
+ *  Distances are measured between the start addresses
+ *  of consecutive nodes, in bytes, regardless of the
+ *  direction. Pages are counted by the page that the
+ *  start of each node is on.
+ */
+struct locality_stats
+{
+    //! how many nodes were visited
+    size_t nodes;
+
+    //! how many steps from one node to the next were
+    //! taken, one less than nodes (or zero)
+    size_t steps;
+
+    //! average distance of a step
+    double mean_distance;
+
+    //! median distance of a step
+    size_t p50_distance;
+
+    //! 90th percentile of the distances of steps
+    size_t p90_distance;
+
+    //! 99th percentile of the distances of steps
+    size_t p99_distance;
+
+    //! largest distance of a step
+    size_t max_distance;
+
+    //! fraction of steps that go to a different page,
+    //! between 0 and 1
+    double page_cross_fraction;
+
+    //! how many distinct pages the nodes are on
+    size_t pages;
+
+    //! the page size used
+    size_t page_size;
+};
+
+typedef struct locality_stats locality_stats_t;
+
+/*! Measures the locality of a chain of nodes.
+ *
+ *  This is used by the containers to implement their
+ *  `*_locality_stats()` functions. It follows the chain
+ *  starting at `first`, reading the pointer to the next
+ *  node at `next_offset` in each node, until it reaches
+ *  NULL.
+ *
+ *  Computing percentiles and distinct pages needs a
+ *  temporary array with one entry per node, so this
+ *  takes O(n log n) time and O(n) memory.
+ *
+ *  @param stats where to store the results
+ *  @param first the first node of the chain, or NULL
+ *  @param next_offset offset of the next pointer in
+ *      the nodes
+ *  @param count how many nodes the chain has
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if stats is NULL, if the chain is longer
+ *  than `count` or if memory can't be allocated.
+ */
+int locality_measure(locality_stats_t *stats, const void *first, size_t next_offset, size_t count);
+
+#ifdef __cplusplus
+}
+#endif
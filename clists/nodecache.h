@@ -0,0 +1,114 @@
+/*! @file nodecache.h
+ *  @author Patrick Elsen
+ *  @date 9 Sep 2012
+ *  @copyright 2011, Patrick M. Elsen
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  ### Design Specifications
+ *  - library-wide cache of free list nodes, keyed by
+ *    the size class of the node
+ *  - every thread has its own magazines of free nodes,
+ *    so allocating and freeing does not take a lock
+ *  - full and empty magazines are exchanged with a
+ *    shared depot, which lets nodes freed by one thread
+ *    be reused by another
+ *  - nodes are always plain malloc() allocations rounded
+ *    up to their size class, so enabling or disabling the
+ *    cache at any point is safe
+ *
+ *  Nodes of slist and dlist lists that don't use a pool,
+ *  an arena or a custom allocator go through this cache.
+ *  It is disabled by default.
+ *
+ *  @warning Code using the cache needs to be linked with
+ *      `-lpthread`.
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Size classes are multiples of this many bytes. */
+#define NODECACHE_GRANULARITY 16
+
+/*! Objects larger than this are not cached. */
+#define NODECACHE_MAX_SIZE 512
+
+/*! How many objects a magazine holds. */
+#define NODECACHE_MAGAZINE_SIZE 64
+
+/*! Enables the cache for all threads. */
+void nodecache_enable(void);
+
+/*! Disables the cache for all threads.
+ *
+ *  Objects that are already cached stay cached until
+ *  nodecache_flush() and nodecache_trim() are called.
+ */
+void nodecache_disable(void);
+
+/*! Returns true if the cache is enabled. */
+bool nodecache_enabled(void);
+
+/*! Allocates an object of the given size.
+ *
+ *  If the cache is enabled, the object is taken
+ *  from the magazines of the calling thread if
+ *  possible. Otherwise, it's allocated with
+ *  malloc().
+ *
+ *  @param size the size of the object
+ *  @return a pointer to the object, or NULL on error
+ */
+void *nodecache_alloc(size_t size);
+
+/*! Releases an object of the given size.
+ *
+ *  If the cache is enabled, the object is kept in
+ *  the magazines of the calling thread. Otherwise,
+ *  it's released with free().
+ *
+ *  @warning The object must have been allocated with
+ *      nodecache_alloc(), with the same size.
+ *
+ *  @param ptr the object to release
+ *  @param size the size of the object
+ */
+void  nodecache_free(void *ptr, size_t size);
+
+/*! Moves all objects cached by the calling thread
+ *  to the shared depot.
+ *
+ *  This happens automatically when a thread exits.
+ */
+void nodecache_flush(void);
+
+/*! Releases all objects held in the shared depot
+ *  with free().
+ */
+void nodecache_trim(void);
+
+#ifdef __cplusplus
+}
+#endif
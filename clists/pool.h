@@ -0,0 +1,215 @@
+/*! @file pool.h
+ *  @author Patrick Elsen
+ *  @date 9 Sep 2012
+ *  @copyright 2011, Patrick M. Elsen
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  ### Design Specifications
+ *  - fixed-size object pool, used for list nodes
+ *  - objects are carved out of slabs owned by the pool
+ *  - released objects are recycled, so steady-state
+ *    allocation does not call malloc() or free()
+ *  - pools are reference counted so that lists sharing
+ *    nodes (after a split, for example) can share a pool
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! Slab of objects.
+ *
+ *  A slab is a single allocation holding `count`
+ *  objects. The first `fresh` objects have been
+ *  handed out at some point, the rest have never
+ *  been touched. Objects that were handed out and
+ *  then put back are kept in the `free` list.
+ */
+struct pool_slab
+{
+    //! start of the object storage
+    char *base;
+
+    //! how many objects fit into this slab
+    size_t count;
+
+    //! how many objects are currently handed out
+    size_t used;
+
+    //! how many objects have been carved out so far
+    size_t fresh;
+
+    //! singly linked list of released objects
+    void *free;
+
+    //! next slab with available objects
+    struct pool_slab *next;
+
+    //! previous slab with available objects
+    struct pool_slab *prev;
+};
+
+typedef struct pool_slab pool_slab_t;
+
+/*! The main pool struct.
+ *
+ *  ### Invariants
+ *
+ *  `slabs` holds `slabs_count` pointers to slabs, sorted
+ *  by their `base` address, so that the slab an object
+ *  belongs to can be found with a binary search.
+ *
+ *  `partial` is a doubly linked list of all slabs that
+ *  still have objects available.
+ *
+ *  If `parent` is not NULL, this pool has been merged
+ *  into `parent` and does not own any slabs anymore,
+ *  all operations are forwarded to the parent.
+ */
+struct pool
+{
+    //! size of each object (rounded up for alignment)
+    size_t size;
+
+    //! how many objects to put in a new slab
+    size_t per_slab;
+
+    //! reference count
+    size_t refs;
+
+    //! pool this one has been merged into, or NULL
+    struct pool *parent;
+
+    //! slabs owned by the pool, sorted by address
+    struct pool_slab **slabs;
+
+    //! how many slabs the pool owns
+    size_t slabs_count;
+
+    //! how many slab pointers `slabs` has room for
+    size_t slabs_alloc;
+
+    //! slabs that have objects available
+    struct pool_slab *partial;
+
+    //! a completely unused slab kept around for reuse
+    struct pool_slab *spare;
+};
+
+typedef struct pool pool_t;
+
+/*! Creates a new pool for objects of the given size.
+ *
+ *  @param size the size of each object
+ *  @param per_slab how many objects to allocate at
+ *      once when the pool runs out, or 0 to use a
+ *      default
+ *  @return the new pool with a reference count of one,
+ *      or NULL on error
+ */
+pool_t *pool_new(size_t size, size_t per_slab);
+
+/*! Takes another reference to a pool.
+ *
+ *  @param pool the pool
+ *  @return the pool
+ */
+pool_t *pool_ref(pool_t *pool);
+
+/*! Drops a reference to a pool.
+ *
+ *  Once the last reference is dropped, all slabs of
+ *  the pool are free()d, which means that all objects
+ *  that were handed out by the pool become invalid.
+ *
+ *  @param pool the pool
+ *  @return 0 on success, negative on error
+ */
+int pool_free(pool_t *pool);
+
+/*! Gets an object from the pool.
+ *
+ *  @param pool the pool
+ *  @return a pointer to an uninitialized object, or
+ *      NULL on error
+ */
+void *pool_get(pool_t *pool);
+
+/*! Reserves space for a number of objects.
+ *
+ *  Makes sure that the next `count` calls to pool_get()
+ *  hand out objects of a single slab one after the
+ *  other, in address order, so objects that are
+ *  allocated together also end up next to each other
+ *  in memory.
+ *
+ *  If the slab objects are taken from first still has
+ *  enough untouched objects, or the spare slab is large
+ *  enough, no memory is allocated. Otherwise, a new
+ *  slab is added, with room for `count` objects rounded
+ *  up to a multiple of the slab size of the pool, so
+ *  that small reservations don't pile up tiny slabs.
+ *
+ *  @param pool the pool
+ *  @param count how many objects to reserve space for
+ *  @return 0 on success, negative on error
+ */
+int pool_reserve(pool_t *pool, size_t count);
+
+/*! Puts an object back into the pool.
+ *
+ *  @param pool the pool
+ *  @param ptr the object to put back
+ *  @return 0 on success, or negative if the object
+ *      does not belong to this pool (in which case
+ *      nothing happens)
+ */
+int pool_put(pool_t *pool, void *ptr);
+
+/*! Checks if an object belongs to a pool.
+ *
+ *  @param pool the pool
+ *  @param ptr the object
+ *  @return true if `ptr` was handed out by `pool`
+ */
+bool pool_owns(const pool_t *pool, const void *ptr);
+
+/*! Merges two pools.
+ *
+ *  After merging, objects from either of the pools
+ *  can be put back into either one. This is needed
+ *  when lists that use different pools are joined.
+ *
+ *  @warning Both pools must use the same object size.
+ *
+ *  @param dest the pool to merge into
+ *  @param src the pool to merge
+ *  @return dest on success, NULL on error
+ */
+pool_t *pool_merge(pool_t *dest, pool_t *src);
+
+#ifdef __cplusplus
+}
+#endif
@@ -25,6 +25,7 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include "allocator.h"
 #include "bitvec.h"
 
 #ifdef __cplusplus
@@ -40,6 +41,8 @@ struct sarray
     size_t capacity;
 
     sarray_word *data;
+
+    const struct allocator *allocator;
 };
 
 typedef struct sarray sarray_t;
@@ -62,6 +65,10 @@ sarray_t *sarray_new(size_t size, size_t capacity);
 
 sarray_t *sarray_init(sarray_t *array, size_t size, size_t capacity);
 
+sarray_t *sarray_new_allocator(size_t size, size_t capacity, const allocator_t *allocator);
+
+sarray_t *sarray_init_allocator(sarray_t *array, size_t size, size_t capacity, const allocator_t *allocator);
+
 sarray_t *sarray_purge(sarray_t *array);
 
 int     sarray_free (sarray_t *array);
@@ -34,6 +34,10 @@
 
 #include <stdlib.h>
 #include <string.h>
+#include "pool.h"
+#include "arena.h"
+#include "allocator.h"
+#include "locality.h"
 
 /*  foreach loop implementation for slist, use like this, assuming the
  *  list that is to be iterated is called 'list' and of type slist_t*:
@@ -119,6 +123,30 @@ typedef struct slist_node slist_node_t;
  *  `size` is the size of each elements, which stays the same
  *  during the whole lifetime of the list.
  *
+ *  If `pool` is not NULL, nodes are allocated from it and
+ *  put back into it when they are removed, instead of
+ *  using malloc() and free().
+ *
+ *  If `arena` is not NULL, nodes are allocated from it
+ *  and never released individually, they go away when
+ *  the arena is reset.
+ *
+ *  If `allocator` is not NULL, nodes are allocated and
+ *  released with it.
+ *
+ *  Otherwise, nodes are allocated with malloc(), going
+ *  through the node cache if it is enabled (see
+ *  nodecache.h).
+ *
+ *  If `finger` is not NULL, it points to the node at
+ *  position `finger_pos`. Lookups by position at or after
+ *  `finger_pos` start walking from there instead of from
+ *  `head`, which makes sequential access by index cheap.
+ *  Mutations that move or remove that node reset `finger`
+ *  to NULL. The finger is only a cache, so lookups update
+ *  it even though they take a `const` list, which makes
+ *  concurrent lookups on a shared list unsafe.
+ *
  *  The list may not be  circular.
  */
 struct slist
@@ -134,6 +162,21 @@ struct slist
 
     //! size of data in each node (same for all nodes)
     size_t size;
+
+    //! pool to allocate nodes from, or NULL
+    struct pool *pool;
+
+    //! arena to allocate nodes from, or NULL
+    struct arena *arena;
+
+    //! allocator to allocate nodes with, or NULL
+    const struct allocator *allocator;
+
+    //! last node looked up by position, or NULL
+    struct slist_node *finger;
+
+    //! position of finger in the list
+    size_t finger_pos;
 };
 
 typedef struct slist slist_t;
@@ -141,7 +184,8 @@ typedef struct slist slist_t;
 /*! Function to compare two elements. 
  *
  *  Used by slist_compare() to compare two lists
- *  by their elements.
+ *  by their elements, and by slist_sort() to order
+ *  the elements of a list.
  *  
  *  @param a the first element
  *  @param b the second element
@@ -152,6 +196,64 @@ typedef struct slist slist_t;
  */
 typedef int slist_compare_elements(void *a, void *b);
 
+/*! Element classification function.
+ *
+ *  Used by slist_partition() to decide which list an
+ *  element should be moved to.
+ *
+ *  @param data the element
+ *  @param ctx the context pointer passed to
+ *      slist_partition()
+ *  @return the index of the list to move the element to
+ */
+typedef size_t slist_classify_element(void *data, void *ctx);
+
+/*! Element initialization function.
+ *
+ *  Used by slist_append_with() and friends to build an
+ *  element directly inside its node, instead of copying
+ *  it there from somewhere else.
+ *
+ *  @param data the uninitialized element
+ *  @param ctx the context pointer passed along with
+ *      the function
+ *  @return 0 on success, or negative if the element
+ *      could not be initialized
+ */
+typedef int slist_init_element(void *data, void *ctx);
+
+/*! Iterator over the nodes of an slist.
+ *
+ *  Besides the current node, it remembers the node
+ *  before it, so that the current node can be removed
+ *  without searching for its predecessor. See
+ *  slist_iter_init().
+ *
+ *  ### Invariants
+ *
+ *  `node` is the current node, or NULL if the iterator
+ *  is past the end of the list. `prev` is the node
+ *  before `node`, or NULL if `node` is the head (or the
+ *  list is empty).
+ *
+ *  @warning An iterator is only valid as long as the
+ *      list is modified only through it, or by inserting
+ *      after its current node.
+ */
+struct slist_iter
+{
+    //! the list that is iterated
+    struct slist *list;
+
+    //! the node before the current one, or NULL
+    struct slist_node *prev;
+
+    //! the current node, or NULL if past the end
+    struct slist_node *node;
+};
+
+typedef struct slist_iter slist_iter_t;
+
 /* BASIC DATA ACCESS */
 
 /*! Returns the size of the elements that the list
@@ -332,9 +434,210 @@ slist_t *slist_new(size_t size);
  */
 slist_t *slist_init(slist_t *list, size_t size);
 
+/*! Creates a new slist_t object on the heap whose
+ *  nodes are allocated from a pool.
+ *
+ *  See slist_init_pooled() for details.
+ *
+ *  @param size the size of the elements that this
+ *      list contains
+ *  @param nodes_per_slab how many nodes to allocate
+ *      at once, or 0 for a sensible default
+ *  @return a pointer to the allocated list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ */
+slist_t *slist_new_pooled(size_t size, size_t nodes_per_slab);
+
+/*! Initializes a given slist object whose nodes are
+ *  allocated from a pool.
+ *
+ *  Instead of calling malloc() and free() for every
+ *  node, the list carves nodes out of slabs holding
+ *  `nodes_per_slab` nodes each, and recycles nodes
+ *  that are removed or popped. Once the list has
+ *  reached its working size, appending and popping
+ *  does not call malloc() or free() at all.
+ *
+ *  The pool is shared with lists that are split off
+ *  or copied from this list. Purging the list keeps
+ *  the pool, so a purged list reuses its nodes; it is
+ *  released when the last list using it is freed (or
+ *  released with slist_release()).
+ *
+ *  @warning Assumes that the list is either 
+ *      uninitialized or empty. If not, it will 
+ *      leak memory!
+ *
+ *  @param list the list to be initialized
+ *  @param size the size of the elements that the
+ *      list should hold
+ *  @param nodes_per_slab how many nodes to allocate
+ *      at once, or 0 for a sensible default
+ *  @return a pointer to the initialized list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  slist_t list;
+ *  
+ *  if(NULL == slist_init_pooled(&list, sizeof(int), 64)) {
+ *      // error!
+ *  }
+ *
+ *  // no allocations after the first one
+ *  int i = 5;
+ *  for(int n = 0; n < 1000; n++) {
+ *      slist_append(&list, &i);
+ *      slist_pop(&list, NULL);
+ *  }
+ *  ```
+ */
+slist_t *slist_init_pooled(slist_t *list, size_t size, size_t nodes_per_slab);
+
+/*! Creates a new slist_t object inside of an arena.
+ *
+ *  Both the list itself and all of its nodes are
+ *  allocated from the arena. See slist_init_arena()
+ *  for details.
+ *
+ *  @param size the size of the elements that this
+ *      list contains
+ *  @param arena the arena to allocate from
+ *  @return a pointer to the allocated list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ */
+slist_t *slist_new_arena(size_t size, arena_t *arena);
+
+/*! Initializes a given slist object whose nodes are
+ *  allocated from an arena.
+ *
+ *  Nodes of such a list are never released one by
+ *  one: removing or popping elements does not free
+ *  anything, and slist_purge() and slist_free() don't
+ *  have to walk the list at all. All memory of the
+ *  list is released at once with arena_reset() or
+ *  arena_free().
+ *
+ *  Lists that are split off or copied from this
+ *  list use the same arena. Lists using an arena
+ *  can only be joined with lists using the same
+ *  arena.
+ *
+ *  @warning slist_free() does not free() a list that
+ *      uses an arena, so the list itself must either
+ *      be allocated with slist_new_arena() or live in
+ *      memory owned by the caller.
+ *
+ *  @param list the list to be initialized
+ *  @param size the size of the elements that the
+ *      list should hold
+ *  @param arena the arena to allocate from
+ *  @return a pointer to the initialized list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  arena_t *arena = arena_new(0);
+ *
+ *  for(int request = 0; request < 100; request++) {
+ *      slist_t *list = slist_new_arena(sizeof(int), arena);
+ *
+ *      slist_append(list, &request);
+ *      slist_append(list, &request);
+ *
+ *      // throw away all lists at once
+ *      arena_reset(arena);
+ *  }
+ *
+ *  arena_free(arena);
+ *  ```
+ */
+slist_t *slist_init_arena(slist_t *list, size_t size, arena_t *arena);
+
+/*! Creates a new slist_t object using a custom
+ *  allocator.
+ *
+ *  Both the list itself and all of its nodes are
+ *  allocated with the allocator. See
+ *  slist_init_allocator() for details.
+ *
+ *  @param size the size of the elements that this
+ *      list contains
+ *  @param allocator the allocator to use, or NULL
+ *      to use malloc()
+ *  @return a pointer to the allocated list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ */
+slist_t *slist_new_allocator(size_t size, const allocator_t *allocator);
+
+/*! Initializes a given slist object whose nodes are
+ *  allocated with a custom allocator.
+ *
+ *  The list keeps a pointer to the allocator, so it
+ *  needs to stay valid for as long as the list is
+ *  in use. Lists that are split off or copied from
+ *  this list use the same allocator, and lists can
+ *  only be joined with lists using the same
+ *  allocator.
+ *
+ *  If the allocator has no `free` function, nodes
+ *  are never released individually and
+ *  slist_purge() does not walk the list.
+ *
+ *  @warning slist_free() releases the list itself with
+ *      the allocator, so lists that were not created
+ *      with slist_new_allocator() should only be purged.
+ *
+ *  @param list the list to be initialized
+ *  @param size the size of the elements that the
+ *      list should hold
+ *  @param allocator the allocator to use, or NULL
+ *      to use malloc()
+ *  @return a pointer to the initialized list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL on error.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  allocator_t huge = {huge_alloc, huge_free, region};
+ *  slist_t list;
+ *  
+ *  if(NULL == slist_init_allocator(&list, sizeof(int), &huge)) {
+ *      // error!
+ *  }
+ *  ```
+ */
+slist_t *slist_init_allocator(slist_t *list, size_t size, const allocator_t *allocator);
+
 /*! Takes an existing (already initialized) list,
  *  removes all its elements and frees it.
  *
+ *  If the list uses a pool, the nodes are put back
+ *  into it and the list keeps using the pool, so
+ *  appending to the purged list reuses them. Use
+ *  slist_release() to drop the pool as well. If the list
+ *  uses an arena, this does not need to walk the list.
+ *
  *  @warning Make sure that the list has been initialized,
  *      otherwise this function will cause undefined
  *      behavior!
@@ -362,6 +665,38 @@ slist_t *slist_init(slist_t *list, size_t size);
  */
 slist_t *slist_purge(slist_t *list);
 
+/*! Purges a list and drops its reference to its pool.
+ *
+ *  This is what slist_free() does before freeing the list
+ *  itself. Use it to clean up a pooled list that was
+ *  initialized in place with slist_init_pooled(), since
+ *  slist_purge() keeps the pool around. Lists without a
+ *  pool are just purged. Afterwards, the list allocates
+ *  its nodes like a list created with slist_init().
+ *
+ *  @param list the list to be released
+ *  @return the released list
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL in case of error.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  slist_t list;
+ *  slist_init_pooled(&list, sizeof(int), 64);
+ *
+ *  int i = 5;
+ *  slist_append(&list, &i);
+ *
+ *  if(NULL == slist_release(&list)) {
+ *      // error!
+ *  }
+ *  ```
+ */
+slist_t *slist_release(slist_t *list);
+
 /*! Takes an existing list that has been allocated 
  *  on the heap (for example withwith slist_new()),
  *  free()s all of the data and then the list itself.
@@ -527,6 +862,99 @@ void *slist_prepend(slist_t *list, const void *data);
  */
 void *slist_insert (slist_t *list, size_t pos, const void *data);
 
+/*! Appends an element that is built in place.
+ *
+ *  Allocates a new node at the end of the list and
+ *  calls `init` to build the element inside of it, so
+ *  that large elements don't have to be built somewhere
+ *  else first and then copied.
+ *
+ *  @param list the list to append to
+ *  @param init the function that initializes the element
+ *  @param ctx a pointer passed on to init
+ *  @return a pointer to the new element, or NULL on
+ *      error
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL and leaves the list unchanged if init
+ *  is NULL, if the node can't be allocated or if init
+ *  returns a negative integer.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int read_record(void *data, void *ctx) {
+ *      return (fread(data, sizeof(record_t), 1, ctx) == 1) ? 0 : -1;
+ *  }
+ *
+ *  while(slist_append_with(list, read_record, file) != NULL);
+ *  ```
+ */
+void *slist_append_with(slist_t *list, slist_init_element *init, void *ctx);
+
+/*! Prepends an element that is built in place.
+ *
+ *  Works like slist_append_with(), but puts the new
+ *  element at the front of the list.
+ *
+ *  @param list the list to prepend to
+ *  @param init the function that initializes the element
+ *  @param ctx a pointer passed on to init
+ *  @return a pointer to the new element, or NULL on
+ *      error
+ */
+void *slist_prepend_with(slist_t *list, slist_init_element *init, void *ctx);
+
+/*! Inserts an element that is built in place.
+ *
+ *  Works like slist_append_with(), but puts the new
+ *  element at `pos`.
+ *
+ *  @param list the list to insert into
+ *  @param pos the position of the new element, up to
+ *      the length of the list
+ *  @param init the function that initializes the element
+ *  @param ctx a pointer passed on to init
+ *  @return a pointer to the new element, or NULL on
+ *      error (also if pos is past the end of the list)
+ */
+void *slist_insert_with(slist_t *list, size_t pos, slist_init_element *init, void *ctx);
+
+/*! Appends a number of elements that are built in place.
+ *
+ *  Allocates `count` nodes in one batch (for pooled
+ *  lists, from a single slab), calls `init` on each of
+ *  them in order, and then appends them all to the list.
+ *
+ *  @param list the list to append to
+ *  @param count how many elements to append
+ *  @param init the function that initializes the elements
+ *  @param ctx a pointer passed on to init
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves the list
+ *  unchanged if init is NULL, if the nodes can't be
+ *  allocated or if init returns a negative integer
+ *  for any of the elements.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int count_up(void *data, void *ctx) {
+ *      *((int*)data) = (*((int*)ctx))++;
+ *      return 0;
+ *  }
+ *
+ *  // append the numbers 0 to 99
+ *  int next = 0;
+ *  assert(slist_generate(list, 100, count_up, &next) == 0);
+ *  ```
+ */
+int slist_generate(slist_t *list, size_t count, slist_init_element *init, void *ctx);
+
 /*! Removes a given element from the list.
  *  
  *  This function attempts to remove the element
@@ -595,6 +1023,14 @@ void *slist_set(slist_t *list, size_t pos, const void *data);
  *  This function will return a pointer to the element
  *  at `pos`, or `NULL` on error.
  *
+ *  The node that was found is remembered in the list, so
+ *  getting elements in ascending order of position only
+ *  walks the list once overall.
+ *
+ *  @warning Because of this, calling this function on the
+ *      same list from multiple threads at the same time
+ *      is not safe, even though the list is `const`.
+ *
  *  @warning if data is not NULL, it must point to 
  *  memory that is at least as large as the size of
  *  the elements in the list!
@@ -624,6 +1060,104 @@ void *slist_set(slist_t *list, size_t pos, const void *data);
  */
 void *slist_get(const slist_t *list, size_t pos, void *data);
 
+/*! Copies a range of elements out of the list.
+ *
+ *  Copies the `count` elements starting at `pos` into
+ *  the array `out`, one after another. The position is
+ *  looked up once, and the range is read in one pass,
+ *  which is much faster than calling slist_get() for
+ *  every element. Like slist_get(), this moves the
+ *  list's finger to the last element copied, so it is
+ *  not safe to call on the same list from multiple
+ *  threads at the same time either.
+ *
+ *  @param list the list to read from
+ *  @param pos the position of the first element
+ *  @param count how many elements to copy
+ *  @param out an array with room for `count` elements
+ *  @return out on success, or NULL on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL if out is NULL or if the range does not
+ *  lie within the list.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int window[16];
+ *  assert(slist_get_range(list, 32, 16, window) == window);
+ *  ```
+ */
+void *slist_get_range(const slist_t *list, size_t pos, size_t count, void *out);
+
+/*! Overwrites a range of elements of the list.
+ *
+ *  Copies `count` elements from the array `data` into
+ *  the elements starting at `pos`, in one pass.
+ *
+ *  @param list the list to write to
+ *  @param pos the position of the first element
+ *  @param count how many elements to overwrite
+ *  @param data an array holding `count` elements
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves the list
+ *  unchanged if data is NULL or if the range does not
+ *  lie within the list.
+ */
+int slist_set_range(slist_t *list, size_t pos, size_t count, const void *data);
+
+/*! Inserts a range of elements into the list.
+ *
+ *  Inserts `count` elements copied from the array
+ *  `data`, so that the first of them ends up at `pos`.
+ *  All nodes are allocated before the list is changed,
+ *  and for pooled lists they are taken from a single
+ *  slab, so they lie next to each other in memory.
+ *
+ *  @param list the list to insert into
+ *  @param pos the position to insert at, up to the
+ *      length of the list
+ *  @param data an array holding `count` elements, or
+ *      NULL to leave the new elements uninitialized
+ *  @param count how many elements to insert
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves the list
+ *  unchanged if pos is past the end of the list or
+ *  if the nodes can't be allocated.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int batch[] = { 1, 2, 3, 4 };
+ *  assert(slist_insert_range(list, 0, batch, 4) == 0);
+ *  ```
+ */
+int slist_insert_range(slist_t *list, size_t pos, const void *data, size_t count);
+
+/*! Removes a range of elements from the list.
+ *
+ *  Removes the `count` elements starting at `pos` in a
+ *  single pass.
+ *
+ *  @param list the list to remove from
+ *  @param pos the position of the first element
+ *  @param count how many elements to remove
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves the list
+ *  unchanged if the range does not lie within the list.
+ */
+int slist_remove_range(slist_t *list, size_t pos, size_t count);
+
 /*! Removes the first element of the list.
  *
  *  If a non-NULL `data` pointer is provided, 
@@ -663,6 +1197,35 @@ void *slist_get(const slist_t *list, size_t pos, void *data);
  */
 void *slist_pop(slist_t *list, void *data);
 
+/*! Removes up to `max` elements from the front of the
+ *  list.
+ *
+ *  The elements are detached from the list in one go,
+ *  their data is copied into `out` one after another,
+ *  and then their nodes are released. This saves the
+ *  per-element bookkeeping of calling slist_pop() in a
+ *  loop.
+ *
+ *  @param list the list to work on
+ *  @param out optionally, an array with room for `max`
+ *      elements to store the popped elements in
+ *  @param max the maximum number of elements to pop
+ *  @return the number of elements popped, which is less
+ *      than max if the list held fewer elements
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int batch[64];
+ *  size_t count;
+ *
+ *  while((count = slist_pop_many(queue, batch, 64)) > 0) {
+ *      process(batch, count);
+ *  }
+ *  ```
+ */
+size_t slist_pop_many(slist_t *list, void *out, size_t max);
+
 /*! Swaps two elements in the list by position.
  *
  *  Given two valid positions in the list, this
@@ -704,6 +1267,137 @@ void *slist_pop(slist_t *list, void *data);
  */
 int slist_swap(slist_t *list, size_t a, size_t b);
 
+/* NODE HANDLES */
+
+/*! Inserts an element after the given node.
+ *
+ *  Unlike slist_insert(), this does not need to look
+ *  up a node by its position, so it takes O(1) time.
+ *  Passing NULL as node inserts at the front of the
+ *  list.
+ *
+ *  @param list the list to insert into
+ *  @param node a node of list, or NULL
+ *  @param data the data to insert, or NULL
+ *  @return a pointer to the new element, or NULL on
+ *      error
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL if a new node can't be allocated.
+ *  The node is not checked to be part of the list,
+ *  passing a node of another list breaks both lists.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  // put a zero after every negative number
+ *  int zero = 0;
+ *  for(slist_node_t *node = list->head; node != NULL; node = node->next) {
+ *      if(*((int*)node->data) < 0) {
+ *          node = slist_node_of(slist_insert_after(list, node, &zero));
+ *      }
+ *  }
+ *  ```
+ */
+void *slist_insert_after(slist_t *list, slist_node_t *node, const void *data);
+
+/*! Removes the element after the given node.
+ *
+ *  Unlike slist_remove(), this does not need to look
+ *  up a node by its position, so it takes O(1) time.
+ *  Passing NULL as node removes the first element.
+ *
+ *  @param list the list to remove from
+ *  @param node a node of list, or NULL
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer if there is no element
+ *  after node (or the list is empty, if node is NULL).
+ */
+int slist_remove_after(slist_t *list, slist_node_t *node);
+
+/*! Returns the node that holds the given element.
+ *
+ *  @param data a pointer to an element of an slist,
+ *      as returned by slist_get() and friends
+ *  @return the node of the element, or NULL if data
+ *      is NULL
+ */
+slist_node_t *slist_node_of(void *data);
+
+/*! Starts iterating over a list.
+ *
+ *  The iterator starts at the first node. Walking the
+ *  list with it and removing the current node both take
+ *  O(1) time, so filtering a list can be done in a
+ *  single pass.
+ *
+ *  @param iter the iterator to initialize
+ *  @param list the list to iterate over
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if iter or list is NULL.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  slist_iter_t iter;
+ *  slist_iter_init(&iter, list);
+ *
+ *  // remove all negative numbers
+ *  while(slist_iter_node(&iter) != NULL) {
+ *      if(*((int*)slist_iter_get(&iter)) < 0) {
+ *          slist_iter_remove(&iter);
+ *      } else {
+ *          slist_iter_next(&iter);
+ *      }
+ *  }
+ *  ```
+ */
+int slist_iter_init(slist_iter_t *iter, slist_t *list);
+
+/*! Moves an iterator to the next node.
+ *
+ *  @param iter the iterator
+ *  @return 0 on success, or negative if the iterator
+ *      is already past the end of the list
+ */
+int slist_iter_next(slist_iter_t *iter);
+
+/*! Returns the current node of an iterator.
+ *
+ *  The node can be passed to slist_insert_after() and
+ *  slist_remove_after().
+ *
+ *  @param iter the iterator
+ *  @return the current node, or NULL if the iterator
+ *      is past the end of the list
+ */
+slist_node_t *slist_iter_node(const slist_iter_t *iter);
+
+/*! Returns the current element of an iterator.
+ *
+ *  @param iter the iterator
+ *  @return a pointer to the current element, or NULL
+ *      if the iterator is past the end of the list
+ */
+void *slist_iter_get(const slist_iter_t *iter);
+
+/*! Removes the current node of an iterator.
+ *
+ *  The iterator moves on to the following node.
+ *
+ *  @param iter the iterator
+ *  @return 0 on success, or negative if the iterator
+ *      is past the end of the list
+ */
+int slist_iter_remove(slist_iter_t *iter);
+
 /*! Splits the list into two lists, so that the
  *  element at pos is the first element of the
  *  second (split-off) list. 
@@ -744,6 +1438,12 @@ slist_t *slist_split(slist_t *list, size_t pos);
  *  This function copies all elements from `src`
  *  into `dest`, leaving `src` as an empty list.
  *
+ *  If the lists use different pools, the pools
+ *  are merged, so that nodes can be put back
+ *  into either of them. Lists that use an arena
+ *  or an allocator can only be joined with lists
+ *  using the same arena or allocator.
+ *
  *  @warning The element sizes of both lists
  *  must be identical!
  *
@@ -778,12 +1478,109 @@ slist_t *slist_split(slist_t *list, size_t pos);
  */
 slist_t *slist_join(slist_t *dest, slist_t *src);
 
+/*! Moves a range of elements from one list into
+ *  another.
+ *
+ *  The `count` elements starting at position `from`
+ *  of `src` are taken out of `src` and inserted into
+ *  `dest`, so that the first of them ends up at
+ *  position `dest_pos`. The nodes are relinked, so
+ *  no element is copied and nothing is allocated.
+ *
+ *  Like with slist_join(), the pools of both lists are
+ *  merged if necessary, and lists that use an arena
+ *  or an allocator can only exchange nodes with lists
+ *  using the same arena or allocator.
+ *
+ *  @param dest the list to move the elements to
+ *  @param dest_pos the position in dest to insert the
+ *      elements at, up to the length of dest
+ *  @param src the list to take the elements from, which
+ *      may not be dest
+ *  @param from the position of the first element to move
+ *  @param count how many elements to move
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves both lists
+ *  unchanged if the element sizes differ, if src and
+ *  dest are the same list, if a position is out of
+ *  range or if the nodes of src can't be moved to dest.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  // move the first ten jobs of one queue to the
+ *  // end of another one
+ *  assert(slist_splice(other, slist_length(other), queue, 0, 10) == 0);
+ *  ```
+ */
+int slist_splice(slist_t *dest, size_t dest_pos, slist_t *src, size_t from, size_t count);
+
+/*! Moves every element of a list into one of several
+ *  other lists.
+ *
+ *  Calls `classify` on every element in order, and
+ *  appends the element to `outs[i]`, where `i` is the
+ *  value it returned. Elements for which it returns `n`
+ *  or more stay in `list`. The nodes are relinked, so
+ *  no element is copied and nothing is allocated, and
+ *  every list keeps the original order of the elements.
+ *
+ *  Like with slist_join(), the pools of the lists are
+ *  merged if necessary, and lists that use an arena or
+ *  an allocator can only exchange nodes with lists
+ *  using the same arena or allocator.
+ *
+ *  @param list the list to partition
+ *  @param classify the function picking the list for
+ *      every element
+ *  @param ctx a pointer passed on to classify
+ *  @param outs the lists to move the elements to, none
+ *      of which may be list. The same list may appear
+ *      more than once.
+ *  @param n the number of lists in outs
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns a negative integer and leaves all lists
+ *  unchanged if classify or outs is NULL, n is zero,
+ *  an output list is NULL, list itself or has a
+ *  different element size, or if the nodes of list
+ *  can't be moved to one of the output lists.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  size_t sign(void *data, void *ctx) {
+ *      return (*((int*)data) < 0) ? 0 : 1;
+ *  }
+ *
+ *  slist_t *outs[2] = { negative, positive };
+ *  assert(slist_partition(list, sign, NULL, outs, 2) == 0);
+ *  assert(slist_length(list) == 0);
+ *  ```
+ */
+int slist_partition(slist_t *list, slist_classify_element *classify, void *ctx, slist_t **outs, size_t n);
+
 /*! Creates a copy of a list
  *
  *  This function creates a new list, and fills
  *  it up by copying all the elements of the
  *  list passed as parameter.
  *
+ *  The nodes of the copy are allocated as one block
+ *  from a pool, in list order, so that traversing the
+ *  copy touches memory sequentially. If the list uses
+ *  a pool, the copy shares it. If it allocates its
+ *  nodes one by one, the copy gets a pool of its own,
+ *  so it is a pooled list, just as if it had been
+ *  created with slist_new_pooled(). Lists using an arena
+ *  or an allocator are copied into the same arena or
+ *  allocator, node by node.
+ *
  *  @param list the list to copy
  *  @return a copy of the list passed as parameter,
  *      or NULL on error
@@ -810,6 +1607,169 @@ slist_t *slist_join(slist_t *dest, slist_t *src);
  */
 slist_t *slist_copy(const slist_t *list);
 
+/*! Creates a new list from an array of elements.
+ *
+ *  The list gets its own pool (see slist_new_pooled()),
+ *  and all `count` nodes are allocated from a single
+ *  slab of it, one after the other. This means that the
+ *  nodes of the new list lie next to each other in
+ *  memory in list order, so traversing it is as cache
+ *  friendly as it gets, and building it only takes one
+ *  allocation for the nodes.
+ *
+ *  @param data pointer to `count` elements of `size`
+ *      bytes each
+ *  @param count how many elements to copy
+ *  @param size the size of the elements
+ *  @return a new list holding copies of the elements,
+ *      or NULL on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL if memory can't be allocated, or if
+ *  `data` is NULL while `count` isn't zero.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int numbers[] = {1, 2, 3, 4};
+ *
+ *  slist_t *list = slist_from_array(numbers, 4, sizeof(int));
+ *  assert(slist_length(list) == 4);
+ *  ```
+ */
+slist_t *slist_from_array(const void *data, size_t count, size_t size);
+
+/*! Copies the elements of a list into an array.
+ *
+ *  @param list the list to copy the elements of
+ *  @param out array with room for all elements of the
+ *      list, or NULL to have one allocated with malloc()
+ *  @return the array the elements were copied to, or
+ *      NULL on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns NULL if list is NULL, or if `out` is NULL
+ *  and memory can't be allocated.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int numbers[4];
+ *  assert(slist_to_array(list, numbers) == numbers);
+ *  ```
+ */
+void *slist_to_array(const slist_t *list, void *out);
+
+/*! Moves all nodes of a list into contiguous memory.
+ *
+ *  After many insertions and removals, the nodes of a
+ *  long-lived list end up spread all over the heap,
+ *  which makes traversing it slow. This allocates new
+ *  nodes as one block from the pool of the list, in
+ *  list order, copies the elements over and releases
+ *  the old nodes.
+ *
+ *  A list that doesn't have a pool gets one, and keeps
+ *  using it afterwards: it becomes a pooled list, just
+ *  as if it had been created with slist_new_pooled().
+ *  Its old nodes are handed to the node cache. A list
+ *  initialized in place has to be cleaned up with
+ *  slist_release() after that. Lists using an arena
+ *  or an allocator can't be compacted,
+ *  as there is no way to get contiguous memory from
+ *  them (or to release the old nodes, for arenas).
+ *
+ *  @warning This moves every element, so pointers to
+ *      elements of the list become invalid.
+ *
+ *  @param list the list to compact
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list is NULL, uses an arena or an
+ *  allocator, or if memory can't be allocated. In all
+ *  of these cases, the list is left untouched.
+ */
+int slist_compact(slist_t *list);
+
+/*! Compacts a part of a list, so that compaction can
+ *  be done in small steps, for example when idle.
+ *
+ *  Works like slist_compact() (including giving a list
+ *  without a pool one on the first step), but only
+ *  moves up to `count` nodes starting at position
+ *  `*pos` into a new block, and then advances `*pos`
+ *  past them. Once the end of the list is reached,
+ *  `*pos` is set back to 0. The list can be modified in between steps,
+ *  which at worst means that some nodes are compacted
+ *  twice or not at all in that round.
+ *
+ *  @warning This moves the elements that are compacted,
+ *      so pointers to them become invalid.
+ *
+ *  @param list the list to compact
+ *  @param pos position to start at, which is updated to
+ *      where the next step should start
+ *  @param count maximum amount of nodes to move
+ *  @return 1 if there are nodes left to compact in this
+ *      round, 0 if the end of the list was reached, or
+ *      negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list or pos is NULL, if the list uses
+ *  an arena or an allocator, or if memory can't be
+ *  allocated. The list is left untouched.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  size_t pos = 0;
+ *
+ *  // move 64 nodes every time there is nothing else to do
+ *  while(idle()) {
+ *      if(slist_compact_step(list, &pos, 64) < 0) {
+ *          // error!
+ *      }
+ *  }
+ *  ```
+ */
+int slist_compact_step(slist_t *list, size_t *pos, size_t count);
+
+/*! Reports how well the nodes of a list are laid out in
+ *  memory.
+ *
+ *  Walks the list in order and measures the distances
+ *  between consecutive nodes, how often a step crosses
+ *  into another page and how many pages the nodes are
+ *  on (see locality_stats_t). This can be used to
+ *  decide when a list should be compacted with
+ *  slist_compact().
+ *
+ *  @param list the list to measure
+ *  @param stats where to store the results
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list or stats is NULL, or if memory
+ *  for the measurement can't be allocated.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  locality_stats_t stats;
+ *
+ *  if(slist_locality_stats(list, &stats) == 0 && stats.page_cross_fraction > 0.5) {
+ *      slist_compact(list);
+ *  }
+ *  ```
+ */
+int slist_locality_stats(const slist_t *list, locality_stats_t *stats);
+
 /*! Compares two lists, optionally using a 
  *  supplied comparison function.
  *
@@ -833,12 +1793,102 @@ slist_t *slist_copy(const slist_t *list);
  */
 int slist_compare(slist_t *a, slist_t *b, slist_compare_elements *cmp);
 
+/*! Sorts a slist in ascending order.
+ *
+ *  The list is sorted with a bottom-up merge sort,
+ *  which only relinks the nodes: elements are never
+ *  copied and no memory is allocated. It takes
+ *  O(n log n) comparisons and is stable, equal
+ *  elements keep their order.
+ *
+ *  Pointers to elements stay valid, but they will
+ *  (most likely) be at a different position.
+ *
+ *  @param list the list to sort
+ *  @param cmp the function to compare elements with
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list or cmp is NULL.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  int compare_ints(void *a, void *b) {
+ *      return *((int*)b) - *((int*)a);
+ *  }
+ *
+ *  slist_t *list = slist_new(sizeof(int));
+ *
+ *  int numbers[] = {3, 1, 2};
+ *  for(int i = 0; i < 3; i++) {
+ *      slist_append(list, &numbers[i]);
+ *  }
+ *
+ *  assert(slist_sort(list, compare_ints) == 0);
+ *  assert(*((int*)slist_first(list)) == 1);
+ *  ```
+ */
+int slist_sort(slist_t *list, slist_compare_elements *cmp);
+
+/*! Sorts a slist by an unsigned integer key in ascending
+ *  order.
+ *
+ *  Every element has to contain the key as an unsigned
+ *  integer of `key_width` bytes (in native byte order)
+ *  at `key_offset`, for example a `uint32_t` member of
+ *  a struct.
+ *
+ *  The list is sorted with a least significant digit
+ *  radix sort, which distributes the nodes into bucket
+ *  chains one byte of the key at a time and then
+ *  concatenates the chains. It takes O(n * key_width)
+ *  time, never compares or copies elements and needs no
+ *  memory besides the bucket heads on the stack. It is
+ *  stable, equal keys keep their order.
+ *
+ *  @param list the list to sort
+ *  @param key_offset offset of the key in the elements
+ *  @param key_width size of the key in bytes, 1, 2, 4
+ *      or 8
+ *  @return 0 on success, negative on error
+ *
+ *  ### Error Handling
+ *
+ *  Returns -1 if list is NULL, if key_width is not one
+ *  of the supported sizes or if the key doesn't fit into
+ *  the elements.
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  struct entry {
+ *      uint32_t id;
+ *      double value;
+ *  };
+ *
+ *  slist_t *list = slist_new(sizeof(struct entry));
+ *  // ...
+ *
+ *  assert(slist_radix_sort(list, offsetof(struct entry, id), sizeof(uint32_t)) == 0);
+ *  ```
+ */
+int slist_radix_sort(slist_t *list, size_t key_offset, size_t key_width);
+
 /*! Verifies that a list is correct.
  *
  *  This method verifies that a list is correct and
- *  does not have any cycles.
+ *  does not have any cycles, that its length and tail
+ *  match the nodes.
+ *
+ *  It takes O(n) time and doesn't allocate any memory,
+ *  so it can be used on large lists.
  *
  *  It exists only for internal testing purposes.
+ *
+ *  @param list the list to verify
+ *  @return 0 if the list is correct, negative otherwise
  */
 int slist_verify(const slist_t *list);
 
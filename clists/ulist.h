@@ -0,0 +1,365 @@
+/*! @file ulist.h
+ *  @author Patrick Elsen
+ *  @date 9 Sep 2012
+ *  @copyright 2011, Patrick M. Elsen
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ *  ### Design Specifications
+ *  - implementation of unrolled (single) linked lists in C
+ *  - every node holds several elements, so small elements
+ *    don't waste most of the node on the `next` pointer
+ *    and traversal needs fewer pointer chases
+ *  - same interface as slist
+ *
+ *  @todo test the code extensively
+ */
+
+#pragma once
+
+#include <stdlib.h>
+#include <string.h>
+
+/*  foreach loop implementation for ulist, use like this, assuming the
+ *  list that is to be iterated is called 'list' and of type ulist_t*:
+ *
+ *      ulist_foreach(list, item) {
+ *          printf("%p", item);
+ *      }
+ *
+ *  since this is implemented as two nested loops, `break` only leaves
+ *  the current node, use `goto` to leave the loop early.
+ */
+#define ulist_foreach(list, __data) \
+    for(ulist_node_t *__node = (list)->head; __node != NULL; __node = __node->next) \
+        for(void *__data = __node->data; \
+                (char*)__data < (__node->data + __node->count * (list)->size); \
+                __data = (char*)__data + (list)->size)
+
+/*! How many bytes a node should take up (including
+ *  the header) if the elements are small enough. */
+#define ULIST_NODE_BYTES 64
+
+/*! The minimum amount of elements per node. */
+#define ULIST_MIN_PER_NODE 4
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*! List node.
+ *
+ *  Stores up to `per_node` elements (as set in the list)
+ *  in `data`, as well as a pointer to the next node in
+ *  the list.
+ *
+ *  ### Invariants
+ *
+ *  `count` is the number of elements stored in `data`,
+ *  it is never zero and never larger than the `per_node`
+ *  of the list the node belongs to.
+ *
+ *  If `next` is NULL, this is the last node of the list.
+ */
+struct ulist_node
+{
+    //! pointer to next node in list
+    struct ulist_node *next;
+
+    //! how many elements this node holds
+    size_t count;
+
+    //! elements
+    char data[];
+};
+
+typedef struct ulist_node ulist_node_t;
+
+/*! The main ulist struct.
+ *
+ *  ### Invariants
+ *
+ *  If the list is not empty, `head` points to the first node
+ *  in the list and `tail` to the last, otherwise both are NULL.
+ *
+ *  `length` is the amount of elements in the list, which is
+ *  the sum of the `count` of all nodes.
+ *
+ *  `size` is the size of each element and `per_node` the
+ *  maximum amount of elements a node can hold, both stay
+ *  the same during the whole lifetime of the list.
+ */
+struct ulist
+{
+    //! head of the list (first node)
+    struct ulist_node *head;
+
+    //! tail of the list (last node)
+    struct ulist_node *tail;
+
+    //! length of the list (how many elements)
+    size_t length;
+
+    //! size of each element
+    size_t size;
+
+    //! maximum amount of elements per node
+    size_t per_node;
+};
+
+typedef struct ulist ulist_t;
+
+/* BASIC DATA ACCESS */
+
+/*! Returns the size of the elements that the list
+ *  holds in bytes.
+ *
+ *  @param list the list in question
+ *  @return the size of the elements, or 0 if passed NULL
+ */
+size_t ulist_size(const ulist_t *list);
+
+/*! Returns the length of the list (how many elements
+ *  are in it).
+ *
+ *  @param list the list in question
+ *  @return the length of the list, or 0 if passed NULL
+ */
+size_t ulist_length(const ulist_t *list);
+
+/*! Returns a pointer to the first element in the list.
+ *
+ *  @param list the list in question
+ *  @return a pointer to the first element, or NULL if
+ *      the list is NULL or empty
+ */
+void *ulist_first(const ulist_t *list);
+
+/*! Returns a pointer to the last element in the list.
+ *
+ *  @param list the list in question
+ *  @return a pointer to the last element, or NULL if
+ *      the list is NULL or empty
+ */
+void *ulist_last(const ulist_t *list);
+
+/* CREATION/DESTRUCTION FUNCTIONS */
+
+/*! Creates a new ulist_t object on the heap with
+ *  elements of the given size.
+ *
+ *  As many elements as fit into ULIST_NODE_BYTES
+ *  (but at least ULIST_MIN_PER_NODE) are stored
+ *  per node.
+ *
+ *  @param size the size of the elements that this
+ *      list contains
+ *  @return a pointer to the allocated list, or NULL
+ *      on error
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  ulist_t *list = ulist_new(sizeof(int));
+ *
+ *  if(list == NULL) {
+ *      // error!
+ *  }
+ *  ```
+ */
+ulist_t *ulist_new(size_t size);
+
+/*! Initializes a given ulist object for use with
+ *  objects of the given size.
+ *
+ *  @warning Assumes that the list is either
+ *      uninitialized or empty. If not, it will
+ *      leak memory!
+ *
+ *  @param list the list to be initialized
+ *  @param size the size of the elements that the
+ *      list should hold
+ *  @return a pointer to the initialized list, or
+ *      NULL on error
+ */
+ulist_t *ulist_init(ulist_t *list, size_t size);
+
+/*! Takes an existing (already initialized) list and
+ *  removes all its elements.
+ *
+ *  @param list the list to be purged
+ *  @return the purged list
+ */
+ulist_t *ulist_purge(ulist_t *list);
+
+/*! Takes an existing list that has been allocated
+ *  on the heap (for example with ulist_new()),
+ *  free()s all of the data and then the list itself.
+ *
+ *  @param list the list to free
+ *  @return 0 on success, negative on error
+ */
+int     ulist_free (ulist_t *list);
+
+/* INSERTION/REMOVAL */
+
+/*! Appends some data to the end of a list.
+ *
+ *  @warning This function returns a pointer to the
+ *      newly created element. Please note that
+ *      this pointer is only valid until the next
+ *      mutating library call.
+ *
+ *  @param list the list to append data to
+ *  @param data the data to append, or NULL
+ *  @return a pointer to the newly created element,
+ *      or NULL on error
+ *
+ *  ### Example
+ *
+ *  ```c
+ *  ulist_t *list = ulist_new(sizeof(int));
+ *
+ *  int d = 5;
+ *  if(NULL == ulist_append(list, &d)) {
+ *      // error!
+ *  }
+ *  ```
+ */
+void *ulist_append (ulist_t *list, const void *data);
+
+/*! Prepends some data to the beginning of a list.
+ *
+ *  @param list the list to prepend to
+ *  @param data the data to prepend, or NULL
+ *  @return a pointer to the newly created element,
+ *      valid until the next mutating call, or NULL
+ *      on error
+ */
+void *ulist_prepend(ulist_t *list, const void *data);
+
+/*! Inserts an element at the given position.
+ *
+ *  If the node the element goes into is full, it
+ *  is split into two half-full nodes.
+ *
+ *  @param list the list to insert data to
+ *  @param pos the position to insert that data in
+ *  @param data the data to insert, or `NULL`
+ *  @return a pointer to the inserted element, valid
+ *      until the next mutating call, or NULL on error
+ */
+void *ulist_insert (ulist_t *list, size_t pos, const void *data);
+
+/*! Removes the element at the given position.
+ *
+ *  Nodes that become empty are freed, and nodes that
+ *  become less than half full are merged with the
+ *  following node if that fits.
+ *
+ *  @param list the list to remove the element from
+ *  @param pos the position of the element to remove
+ *  @return 0 on success, negative if the element does
+ *      not exist
+ */
+int   ulist_remove (ulist_t *list, size_t pos);
+
+/* ACCESS/MODIFICATION */
+
+/*! Sets the data of the element at the given index.
+ *
+ *  @param list the list to work on
+ *  @param pos the position of the element to set
+ *  @param data a non-`NULL` pointer to the data that
+ *      is copied into the element
+ *  @return a pointer to the element, or NULL on error
+ */
+void *ulist_set(ulist_t *list, size_t pos, const void *data);
+
+/*! Gets a pointer to the data at pos.
+ *
+ *  @param list the list to work on
+ *  @param pos the position of the element
+ *  @param data optionally, a non-NULL pointer that the
+ *      element is copied into
+ *  @return a pointer to the element, or NULL on error
+ */
+void *ulist_get(const ulist_t *list, size_t pos, void *data);
+
+/*! Removes the first element of the list.
+ *
+ *  @param list the list to work on
+ *  @param data optionally, a non-NULL pointer
+ *      to store the data of the popped element in
+ *  @return if data was non-NULL, returns data on
+ *      success and NULL on failure
+ */
+void *ulist_pop(ulist_t *list, void *data);
+
+/*! Swaps two elements in the list by position.
+ *
+ *  @param list the list to operate on
+ *  @param a the index of the first element
+ *  @param b the index of the second element
+ *  @return 0 on success, negative on error
+ */
+int ulist_swap(ulist_t *list, size_t a, size_t b);
+
+/* MODIFICATION OF LISTS */
+
+/*! Splits the list into two lists, so that the
+ *  element at pos is the first element of the
+ *  second (split-off) list.
+ *
+ *  @param list the list to split
+ *  @param pos the position of the first element of the
+ *      resulting split list.
+ *  @return a new list containing all elements starting
+ *      at pos from the passed list, or NULL on error
+ */
+ulist_t *ulist_split(ulist_t *list, size_t pos);
+
+/*! Joins two lists together to one big one.
+ *
+ *  This function moves all nodes from `src` into
+ *  `dest`, leaving `src` as an empty list.
+ *
+ *  @param dest the list to add all elements from
+ *      src to
+ *  @param src the list from which the elements
+ *      are taken
+ *  @return dest on success, or NULL on error
+ */
+ulist_t *ulist_join(ulist_t *dest, ulist_t *src);
+
+/*! Creates a copy of a list.
+ *
+ *  @param list the list to copy
+ *  @return a copy of the list, or NULL on error
+ */
+ulist_t *ulist_copy(const ulist_t *list);
+
+/*! Verifies that a list is correct.
+ *
+ *  It exists only for internal testing purposes.
+ */
+int ulist_verify(const ulist_t *list);
+
+#ifdef __cplusplus
+}
+#endif
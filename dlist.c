@@ -23,11 +23,115 @@
  */
 
 #include "clists/dlist.h"
+#include "clists/nodecache.h"
 #include <assert.h>
+#include <stddef.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <pthread.h>
+
+// maximum height of a tower in the index
+#define DLIST_INDEX_MAX_HEIGHT 16
+
+/* A lane of a tower in the index. It points to the
+ * next tower at the same height, and knows how many
+ * positions it skips to get there. The last tower of
+ * a lane points to NULL, and its width is the distance
+ * to one past the end of the list. */
+struct dlist_index_lane {
+    struct dlist_index_tower *next;
+    size_t width;
+};
+
+/* Every indexed node has a tower with one or more
+ * lanes. The tower of the index itself sits in front
+ * of the first node at position 0, so node positions
+ * in the index are one more than in the list. */
+struct dlist_index_tower {
+    dlist_node_t *node;
+    size_t height;
+    struct dlist_index_lane lanes[];
+};
+
+struct dlist_index {
+    // the tower in front of the list, with all lanes
+    struct dlist_index_tower *head;
+
+    // how many lanes are currently used
+    size_t height;
+
+    // true if the towers don't match the list anymore
+    // and need to be rebuilt before use
+    bool stale;
+
+    // state of the random number generator which
+    // decides the height of new towers
+    uint32_t seed;
+};
+
+typedef struct dlist_index_tower dlist_index_tower_t;
+
+// mark the index of a list as not matching the list
+// anymore, for operations that move many nodes at once
+#define dlist_index_invalidate(list) \
+    do { if((list)->index != NULL) (list)->index->stale = true; } while(0)
+
+// allocate a tower of the given height for node
+static dlist_index_tower_t *dlist_index_tower_new(dlist_node_t *node, size_t height);
+
+// release all towers of the index (but not its head)
+static void dlist_index_clear(struct dlist_index *index);
+
+// rebuild the index from scratch, if it is stale
+static int dlist_index_build(dlist_t *list);
+
+// find the last tower at or before target (which is a
+// position in the index, so one more than in the list)
+// and store the last tower before target on each lane
+// in update (and their positions in update_pos).
+static dlist_index_tower_t *dlist_index_find(const struct dlist_index *index, size_t target, size_t *found_pos, dlist_index_tower_t **update, size_t *update_pos);
+
+// update the index after node was inserted at pos
+static void dlist_index_insert(dlist_t *list, size_t pos, dlist_node_t *node);
+
+// update the index after the chain of count nodes
+// starting at node was inserted at pos, in O(log n +
+// count) time
+static void dlist_index_insert_range(dlist_t *list, size_t pos, size_t count, dlist_node_t *node);
+
+// pick the height of the tower for a new node, which
+// is 0 if it shouldn't get one
+static size_t dlist_index_height(struct dlist_index *index);
+
+// update the index before the node at pos is removed
+static void dlist_index_remove(dlist_t *list, size_t pos, dlist_node_t *node);
+
+// update the index before the count nodes starting at
+// pos are removed, in O(log n + count) time
+static void dlist_index_remove_range(dlist_t *list, size_t pos, size_t count);
 
-// allocate new node with given size
-#define malloc_node(size) malloc(sizeof(dlist_node_t) + (size))
+// update the index after the nodes at a and b were swapped
+static void dlist_index_swap(dlist_t *list, size_t a, size_t b, dlist_node_t *node_a, dlist_node_t *node_b);
+
+// point the towers of the count nodes starting at pos
+// to the chain of nodes starting at node instead
+static void dlist_index_replace(dlist_t *list, size_t pos, size_t count, dlist_node_t *node);
+
+// check that the index matches the list
+static int dlist_index_verify(const dlist_t *list);
+
+// allocate a new node for the list
+static dlist_node_t *dlist_node_alloc(dlist_t *list);
+
+// release a node that belonged to the list
+static void dlist_node_free(dlist_t *list, dlist_node_t *node);
+
+// create a new list that allocates nodes the same
+// way as the given list
+static dlist_t *dlist_new_like(const dlist_t *list);
+
+// make sure nodes of src can be released by dest
+static int dlist_adopt(dlist_t *dest, const dlist_t *src);
 
 // swap two variables
 #define swap(x,y) do {   \
@@ -37,9 +141,152 @@
     y = _x;                \
     } while(0)
 
+// copy an element of size bytes from src to dest
+static inline void dlist_data_copy(void *dest, const void *src, size_t size);
+
 // get the node at pos, or NULL
 static dlist_node_t *dlist_node_get(dlist_t *list, size_t pos);
 
+// link node into list, in front of next (or at the
+// end if next is NULL)
+static void dlist_node_link(dlist_t *list, dlist_node_t *node, dlist_node_t *next);
+
+// take node out of list, without releasing it
+static void dlist_node_unlink(dlist_t *list, dlist_node_t *node);
+
+// move the count nodes from first (at from) to last
+// out of src and into dest, in front of next (which
+// is at dest_pos, or NULL at the end)
+static void dlist_node_splice(dlist_t *dest, size_t dest_pos, dlist_node_t *next, dlist_t *src, size_t from, dlist_node_t *first, dlist_node_t *last, size_t count);
+
+// allocate a node and build its element with init,
+// returning NULL if either fails
+static dlist_node_t *dlist_node_new_with(dlist_t *list, dlist_init_element *init, void *ctx);
+
+// release a chain of nodes that belonged to the list
+static void dlist_node_free_chain(dlist_t *list, dlist_node_t *node);
+
+// allocate a chain of count nodes holding the elements
+// of data, storing the last one in last. returns the
+// first node, or NULL if allocation failed
+static dlist_node_t *dlist_node_chain(dlist_t *list, const void *data, size_t count, dlist_node_t **last);
+
+// cut the chain starting at node after count nodes,
+// returning the rest of the chain (or NULL). only the
+// next pointers are touched.
+static dlist_node_t *dlist_node_cut(dlist_node_t *node, size_t count);
+
+// merge the sorted chains a and b into *link, returning
+// the link at the end of the merged chain
+static dlist_node_t **dlist_node_merge(dlist_node_t **link, dlist_node_t *a, dlist_node_t *b, dlist_compare_elements *cmp);
+
+// sort the chain of length nodes starting at head by
+// their next pointers, returning the new head
+static dlist_node_t *dlist_node_sort(dlist_node_t *head, size_t length, dlist_compare_elements *cmp);
+
+// restore the prev pointers and the tail of a list after
+// its nodes were relinked by their next pointers
+static void dlist_node_relink(dlist_t *list);
+
+// read the unsigned integer key of width bytes at
+// offset in the element of node
+static uint64_t dlist_node_key(const dlist_node_t *node, size_t offset, size_t width);
+
+// radix sort takes this many bits of the key per
+// pass, and needs a bucket for every value of them
+#define DLIST_RADIX_BITS 8
+#define DLIST_RADIX_BUCKETS (1 << DLIST_RADIX_BITS)
+
+// chains with fewer nodes than this are not worth
+// handing to a thread of their own
+#define DLIST_SORT_CHUNK_MIN 4096
+
+// how many elements of every sorted chunk are used to
+// pick the values that split the list into buckets
+#define DLIST_SORT_SAMPLES 32
+
+// dlist_sort_parallel() never uses more threads than
+// this, which also bounds the table of segments
+#define DLIST_SORT_THREADS_MAX 64
+
+struct dlist_sort_job;
+
+/* State shared by all threads of dlist_sort_parallel(). */
+struct dlist_sort_state {
+    // how many chunks (and buckets) there are
+    size_t chunks;
+
+    dlist_compare_elements *cmp;
+
+    // DLIST_SORT_SAMPLES elements of every sorted chunk,
+    // in ascending order
+    void **samples;
+
+    // chunks - 1 elements. bucket k gets the elements
+    // after splitters[k-1] up to and including splitters[k]
+    void **splitters;
+
+    // segments[j * chunks + k] is the part of chunk j
+    // that belongs into bucket k
+    dlist_node_t **segments;
+
+    // the threads wait on work for the next phase, and
+    // the calling thread on done for the end of one.
+    // all of the fields below are guarded by lock.
+    pthread_mutex_t lock;
+    pthread_cond_t work;
+    pthread_cond_t done;
+
+    // the jobs of the current phase and what to do with
+    // them. phase counts up for every new one.
+    struct dlist_sort_job *jobs;
+    void (*worker)(struct dlist_sort_job *job);
+    size_t phase;
+
+    // the next job that nobody has claimed yet, and how
+    // many jobs of this phase are done
+    size_t next;
+    size_t finished;
+
+    // set when the threads should exit
+    bool quit;
+};
+
+/* A chunk (and later a bucket) of nodes that one
+ * thread of dlist_sort_parallel() works on. */
+struct dlist_sort_job {
+    dlist_node_t *head;
+    dlist_node_t *tail;
+    size_t length;
+    size_t id;
+    struct dlist_sort_state *state;
+};
+
+// sort the chunk of a job and take samples from it
+static void dlist_sort_worker(struct dlist_sort_job *job);
+
+// cut the sorted chunk of a job into segments
+static void dlist_split_worker(struct dlist_sort_job *job);
+
+// merge the segments of a bucket into one chain
+static void dlist_merge_worker(struct dlist_sort_job *job);
+
+// pick the splitters from the samples of all chunks
+static void dlist_sort_splitters(struct dlist_sort_state *state);
+
+// the loop of every thread of dlist_sort_parallel(),
+// which works on the jobs of every phase until it is
+// told to quit
+static void *dlist_sort_thread(void *state);
+
+// claim and run jobs of the current phase until none
+// are left. expects state->lock to be held.
+static void dlist_sort_claim(struct dlist_sort_state *state);
+
+// run worker on every job, using all threads, and wait
+// for all of them to finish
+static void dlist_sort_run(struct dlist_sort_state *state, void (*worker)(struct dlist_sort_job *job));
+
 size_t dlist_size(const dlist_t *list) {
     if(list != NULL) {
         return list->size;
@@ -107,6 +354,147 @@ dlist_t *dlist_init(dlist_t *list, size_t size)
     return list;
 }
 
+dlist_t *dlist_new_pooled(size_t size, size_t nodes_per_slab)
+{
+    // allocate memory for new list
+    dlist_t *list = malloc(sizeof(dlist_t));
+
+    // check if memory allocation worked
+    if(list == NULL) {
+        return NULL;
+    }
+
+    // initialize list
+    if(dlist_init_pooled(list, size, nodes_per_slab) == NULL) {
+        free(list);
+        return NULL;
+    }
+
+    return list;
+}
+
+dlist_t *dlist_init_pooled(dlist_t *list, size_t size, size_t nodes_per_slab)
+{
+    // initialize as usual
+    if(dlist_init(list, size) == NULL) {
+        return NULL;
+    }
+
+    // create the pool the nodes are taken from
+    list->pool = pool_new(sizeof(dlist_node_t) + size, nodes_per_slab);
+
+    // make sure that worked
+    if(list->pool == NULL) {
+        return NULL;
+    }
+
+    return list;
+}
+
+dlist_t *dlist_new_arena(size_t size, arena_t *arena)
+{
+    // make sure we have an arena
+    if(arena == NULL) {
+        return NULL;
+    }
+
+    // allocate memory for new list from the arena
+    dlist_t *list = arena_alloc(arena, sizeof(dlist_t));
+
+    // check if memory allocation worked
+    if(list == NULL) {
+        return NULL;
+    }
+
+    return dlist_init_arena(list, size, arena);
+}
+
+dlist_t *dlist_init_arena(dlist_t *list, size_t size, arena_t *arena)
+{
+    // make sure we have an arena
+    if(arena == NULL) {
+        return NULL;
+    }
+
+    // initialize as usual
+    if(dlist_init(list, size) == NULL) {
+        return NULL;
+    }
+
+    list->arena = arena;
+
+    return list;
+}
+
+dlist_t *dlist_new_allocator(size_t size, const allocator_t *allocator)
+{
+    // allocate memory for new list with the allocator
+    dlist_t *list = allocator_alloc(allocator, sizeof(dlist_t));
+
+    // check if memory allocation worked
+    if(list == NULL) {
+        return NULL;
+    }
+
+    return dlist_init_allocator(list, size, allocator);
+}
+
+dlist_t *dlist_init_allocator(dlist_t *list, size_t size, const allocator_t *allocator)
+{
+    // initialize as usual
+    if(dlist_init(list, size) == NULL) {
+        return NULL;
+    }
+
+    list->allocator = allocator;
+
+    return list;
+}
+
+int dlist_index_enable(dlist_t *list)
+{
+    // nothing to do if there already is an index
+    if(list->index != NULL) {
+        return 0;
+    }
+
+    struct dlist_index *index = malloc(sizeof(struct dlist_index));
+
+    if(index == NULL) {
+        return -1;
+    }
+
+    index->head = dlist_index_tower_new(NULL, DLIST_INDEX_MAX_HEIGHT);
+
+    if(index->head == NULL) {
+        free(index);
+        return -1;
+    }
+
+    index->height = 0;
+    index->seed = 0x9e3779b9;
+
+    // towers are created the first time they are needed
+    index->stale = true;
+    list->index = index;
+
+    return 0;
+}
+
+int dlist_index_disable(dlist_t *list)
+{
+    if(list->index == NULL) {
+        return -1;
+    }
+
+    dlist_index_clear(list->index);
+    free(list->index->head);
+    free(list->index);
+    list->index = NULL;
+
+    return 0;
+}
+
 dlist_t *dlist_purge(dlist_t *list)
 {
     // start with the first node, pointed to
@@ -114,18 +502,30 @@ dlist_t *dlist_purge(dlist_t *list)
     dlist_node_t *cur = list->head;
     dlist_node_t *next;
 
+    // nodes from an arena (or an allocator that can't
+    // free) don't need to be released, but pooled nodes
+    // go back to the pool so it can hand them out again
+    if(list->pool == NULL && (list->arena != NULL || (list->allocator != NULL && list->allocator->free == NULL))) {
+        cur = NULL;
+    }
+
     while (cur != NULL) {
         // remember which node was supposed to
         // come next so we can safely free cur
         next = cur->next;
 
         // free current node
-        free(cur);
+        dlist_node_free(list, cur);
 
         // advance to next node
         cur = next;
     }
 
+    // release the index, if any
+    if(list->index != NULL) {
+        dlist_index_disable(list);
+    }
+
     // reset everything but list->size
     list->head = NULL;
     list->tail = NULL;
@@ -134,17 +534,34 @@ dlist_t *dlist_purge(dlist_t *list)
     return list;
 }
 
+dlist_t *dlist_release(dlist_t *list)
+{
+    // free nodes, putting pooled ones back
+    dlist_purge(list);
+
+    // drop the reference to the pool, if any
+    if(list->pool != NULL) {
+        pool_free(list->pool);
+        list->pool = NULL;
+    }
+
+    return list;
+}
+
 int dlist_free(dlist_t *list)
 {
     // can't free a NULL pointer
     if(list == NULL)
         return -1;
 
-    // free nodes
-    dlist_purge(list);
+    // free nodes and drop the pool
+    dlist_release(list);
 
-    // free list itself
-    free(list);
+    // free list itself, unless it lives in an arena
+    // (or in memory owned by the user)
+    if(list->arena == NULL) {
+        allocator_free(list->allocator, list, sizeof(dlist_t));
+    }
 
     return 0;
 }
@@ -152,7 +569,7 @@ int dlist_free(dlist_t *list)
 void *dlist_append(dlist_t *list, void *data)
 {
     // allocate new node
-    dlist_node_t *node = malloc_node(list->size);
+    dlist_node_t *node = dlist_node_alloc(list);
 
     // make sure the malloc call worked 
     if(node == NULL) {
@@ -165,7 +582,7 @@ void *dlist_append(dlist_t *list, void *data)
 
     // set node data, if necessary
     if(data != NULL) {
-        memcpy(node->data, data, list->size);
+        dlist_data_copy(node->data, data, list->size);
     }
 
     // the list could be empty, in which
@@ -190,13 +607,15 @@ void *dlist_append(dlist_t *list, void *data)
     // increase length to reflect added node
     list->length++;
 
+    dlist_index_insert(list, list->length - 1, node);
+
     return node->data;
 }
 
 void *dlist_prepend(dlist_t *list, void *data)
 {
     // allocate new node
-    dlist_node_t *node = malloc_node(list->size);
+    dlist_node_t *node = dlist_node_alloc(list);
 
     // make sure allocation worked
     if(node == NULL) {
@@ -209,7 +628,7 @@ void *dlist_prepend(dlist_t *list, void *data)
 
     // set node data, if necessary
     if(data != NULL) {
-        memcpy(node->data, data, list->size);
+        dlist_data_copy(node->data, data, list->size);
     }
 
     // we have to check if the list was empty
@@ -229,6 +648,8 @@ void *dlist_prepend(dlist_t *list, void *data)
     // increase length to reflect added node
     list->length++;
 
+    dlist_index_insert(list, 0, node);
+
     return node->data;
 }
 
@@ -249,7 +670,7 @@ void *dlist_insert(dlist_t *list, size_t pos, void *data)
     } else {
         // we now know that pos does not point to the
         // first, last or pase the end of the list
-        dlist_node_t *new = malloc_node(list->size);
+        dlist_node_t *new = dlist_node_alloc(list);
 
         if(new == NULL) {
             return NULL;
@@ -257,7 +678,7 @@ void *dlist_insert(dlist_t *list, size_t pos, void *data)
 
         // set node data, if neccessary
         if(data != NULL) {
-            memcpy(new->data, data, list->size);
+            dlist_data_copy(new->data, data, list->size);
         }
 
         // get a pointer to the node before
@@ -265,7 +686,7 @@ void *dlist_insert(dlist_t *list, size_t pos, void *data)
         dlist_node_t *node = dlist_node_get(list, pos-1);
 
         if(node == NULL) {
-            free(new);
+            dlist_node_free(list, new);
             return NULL;
         }
 
@@ -280,9 +701,103 @@ void *dlist_insert(dlist_t *list, size_t pos, void *data)
 
         // increase list length
         list->length++;
-        
-        return new->data;;
+
+        dlist_index_insert(list, pos, new);
+
+        return new->data;
+    }
+}
+
+void *dlist_append_with(dlist_t *list, dlist_init_element *init, void *ctx)
+{
+    dlist_node_t *node = dlist_node_new_with(list, init, ctx);
+
+    if(node == NULL) {
+        return NULL;
+    }
+
+    dlist_node_link(list, node, NULL);
+    dlist_index_insert(list, list->length - 1, node);
+
+    return node->data;
+}
+
+void *dlist_prepend_with(dlist_t *list, dlist_init_element *init, void *ctx)
+{
+    dlist_node_t *node = dlist_node_new_with(list, init, ctx);
+
+    if(node == NULL) {
+        return NULL;
+    }
+
+    dlist_node_link(list, node, list->head);
+    dlist_index_insert(list, 0, node);
+
+    return node->data;
+}
+
+void *dlist_insert_with(dlist_t *list, size_t pos, dlist_init_element *init, void *ctx)
+{
+    // can't add data past the end of the list
+    if(pos > list->length) {
+        return NULL;
+    }
+
+    // find the node to insert in front of
+    dlist_node_t *next = (pos < list->length) ? dlist_node_get(list, pos) : NULL;
+    dlist_node_t *node = dlist_node_new_with(list, init, ctx);
+
+    if(node == NULL) {
+        return NULL;
+    }
+
+    dlist_node_link(list, node, next);
+    dlist_index_insert(list, pos, node);
+
+    return node->data;
+}
+
+int dlist_generate(dlist_t *list, size_t count, dlist_init_element *init, void *ctx)
+{
+    if(init == NULL) {
+        return -1;
+    }
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    // allocate all nodes before touching the list
+    dlist_node_t *last;
+    dlist_node_t *first = dlist_node_chain(list, NULL, count, &last);
+
+    if(first == NULL) {
+        return -2;
+    }
+
+    // build the elements
+    for(dlist_node_t *node = first; node != NULL; node = node->next) {
+        if(init(node->data, ctx) < 0) {
+            dlist_node_free_chain(list, first);
+            return -3;
+        }
+    }
+
+    // append the chain
+    first->prev = list->tail;
+
+    if(list->tail != NULL) {
+        list->tail->next = first;
+    } else {
+        list->head = first;
     }
+
+    list->tail = last;
+    list->length += count;
+    dlist_index_insert_range(list, list->length - count, count, first);
+
+    return 0;
 }
 
 int dlist_remove(dlist_t *list, size_t pos)
@@ -313,6 +828,8 @@ int dlist_remove(dlist_t *list, size_t pos)
         return -1;
     }
 
+    dlist_index_remove(list, pos, node);
+
     // the node could now be in the middle 
     // or at the end of the list
     if(node == list->tail) {
@@ -339,7 +856,7 @@ int dlist_remove(dlist_t *list, size_t pos)
     // update list size to reflect removed node
     list->length--;
 
-    free(node);
+    dlist_node_free(list, node);
     return 0;
 }
 
@@ -355,7 +872,7 @@ void *dlist_set(dlist_t *list, size_t pos, void *data)
     }
 
     // set data
-    memcpy(node->data, data, list->size);
+    dlist_data_copy(node->data, data, list->size);
 
     return node->data;
 }
@@ -372,88 +889,317 @@ void *dlist_get(dlist_t *list, size_t pos, void *data)
 
     // if given, get data
     if(data != NULL) {
-        memcpy(data, node->data, list->size);
+        dlist_data_copy(data, node->data, list->size);
     }
 
     return node->data;
 }
 
-void *dlist_pop(dlist_t *list, void *data)
+void *dlist_get_range(dlist_t *list, size_t pos, size_t count, void *out)
 {
-    // this is the node to be popped
-    dlist_node_t *node = list->head;
-
-    // make sure it exists
-    if(node == NULL) {
-        assert(list->tail == NULL);
-        assert(list->length == 0);
+    // make sure the range exists
+    if(out == NULL || pos > list->length || count > (list->length - pos)) {
         return NULL;
     }
 
-    // check if the list will be empty after
-    // popping
-    if(node->next) {
-        // make the second node the first
-        // node
-        node->next->prev = NULL;
-        list->head = node->next;
-    } else {
-        assert(list->length == 1);
+    // nothing to do
+    if(count == 0) {
+        return out;
+    }
 
-        // if we popped the last node, we
-        // reset the list
-        list->head = NULL;
-        list->tail = NULL;
+    dlist_node_t *node = dlist_node_get(list, pos);
+    char *dest = out;
+
+    for(size_t i = 0; i < count; i++, node = node->next) {
+        dlist_data_copy(dest, node->data, list->size);
+        dest += list->size;
     }
 
-    // update list info
-    list->length--;
+    return out;
+}
 
-    // copy data if requested
-    if(data != NULL) {
-        memcpy(data, node->data, list->size);
+int dlist_set_range(dlist_t *list, size_t pos, size_t count, const void *data)
+{
+    // make sure the range exists
+    if(data == NULL || pos > list->length || count > (list->length - pos)) {
+        return -1;
     }
 
-    free(node);
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
 
-    return data;
+    dlist_node_t *node = dlist_node_get(list, pos);
+    const char *src = data;
+
+    for(size_t i = 0; i < count; i++, node = node->next) {
+        dlist_data_copy(node->data, src, list->size);
+        src += list->size;
+    }
+
+    return 0;
 }
 
-int dlist_swap(dlist_t *list, size_t pos_a, size_t pos_b) {
-    // swapping an element with itself is a nop
-    if(list->length > 0 && pos_a == pos_b) {
+int dlist_insert_range(dlist_t *list, size_t pos, const void *data, size_t count)
+{
+    // make sure the position exists
+    if(pos > list->length) {
+        return -1;
+    }
+
+    // nothing to do
+    if(count == 0) {
         return 0;
     }
 
-    // make sure that pos_a is smaller than pos_b
-    if(pos_a > pos_b) {
-        swap(pos_a, pos_b);
+    // allocate all nodes before touching the list
+    dlist_node_t *last;
+    dlist_node_t *first = dlist_node_chain(list, data, count, &last);
+
+    if(first == NULL) {
+        return -2;
     }
 
-    dlist_node_t *node_a = NULL;
-    dlist_node_t *node_b = NULL;
-    dlist_node_t *node;
+    // find the node to insert in front of
+    dlist_node_t *next = (pos < list->length) ? dlist_node_get(list, pos) : NULL;
+    dlist_node_t *prev = (next != NULL) ? next->prev : list->tail;
 
-    // determine if it makes more sense to scan the
-    // list forward or backwards to get both
-    // nodes
-    if(pos_a < ((list->length - pos_b)-1)) {
-        // scan forwards
-        node = list->head;
+    // link the chain into the list
+    first->prev = prev;
+    last->next = next;
 
-        for(size_t i = 0; 
-            node != NULL && (node_a == NULL || node_b == NULL); 
-            i++, node = node->next) 
-        {
-            if(i == pos_a) node_a = node;
-            if(i == pos_b) node_b = node;
-        }
+    if(prev != NULL) {
+        prev->next = first;
     } else {
-        // scan backwards
-        node = list->tail;
+        list->head = first;
+    }
 
-        for(size_t i = list->length-1;
-            node != NULL && (node_a == NULL || node_b == NULL);
+    if(next != NULL) {
+        next->prev = last;
+    } else {
+        list->tail = last;
+    }
+
+    list->length += count;
+    dlist_index_insert_range(list, pos, count, first);
+
+    return 0;
+}
+
+int dlist_remove_range(dlist_t *list, size_t pos, size_t count)
+{
+    // make sure the range exists
+    if(pos > list->length || count > (list->length - pos)) {
+        return -1;
+    }
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    dlist_node_t *node = dlist_node_get(list, pos);
+    dlist_node_t *prev = node->prev;
+
+    dlist_index_remove_range(list, pos, count);
+
+    // free the nodes of the range
+    for(size_t i = 0; i < count; i++) {
+        dlist_node_t *next = node->next;
+        dlist_node_free(list, node);
+        node = next;
+    }
+
+    // connect the rest of the list
+    if(prev != NULL) {
+        prev->next = node;
+    } else {
+        list->head = node;
+    }
+
+    if(node != NULL) {
+        node->prev = prev;
+    } else {
+        list->tail = prev;
+    }
+
+    list->length -= count;
+
+    return 0;
+}
+
+void *dlist_pop(dlist_t *list, void *data)
+{
+    // this is the node to be popped
+    dlist_node_t *node = list->head;
+
+    // make sure it exists
+    if(node == NULL) {
+        assert(list->tail == NULL);
+        assert(list->length == 0);
+        return NULL;
+    }
+
+    dlist_index_remove(list, 0, node);
+
+    // check if the list will be empty after
+    // popping
+    if(node->next) {
+        // make the second node the first
+        // node
+        node->next->prev = NULL;
+        list->head = node->next;
+    } else {
+        assert(list->length == 1);
+
+        // if we popped the last node, we
+        // reset the list
+        list->head = NULL;
+        list->tail = NULL;
+    }
+
+    // update list info
+    list->length--;
+
+    // copy data if requested
+    if(data != NULL) {
+        dlist_data_copy(data, node->data, list->size);
+    }
+
+    dlist_node_free(list, node);
+
+    return data;
+}
+
+size_t dlist_pop_many(dlist_t *list, void *out, size_t max)
+{
+    size_t count = (max < list->length) ? max : list->length;
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    dlist_index_remove_range(list, 0, count);
+
+    // detach the first count nodes from the list
+    dlist_node_t *node = list->head;
+    list->head = dlist_node_cut(node, count);
+
+    if(list->head != NULL) {
+        list->head->prev = NULL;
+    } else {
+        list->tail = NULL;
+    }
+
+    list->length -= count;
+
+    // copy out the data and release the nodes
+    char *dest = out;
+
+    while(node != NULL) {
+        dlist_node_t *next = node->next;
+
+        if(dest != NULL) {
+            dlist_data_copy(dest, node->data, list->size);
+            dest += list->size;
+        }
+
+        dlist_node_free(list, node);
+        node = next;
+    }
+
+    return count;
+}
+
+size_t dlist_pop_back_many(dlist_t *list, void *out, size_t max)
+{
+    size_t count = (max < list->length) ? max : list->length;
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    dlist_index_remove_range(list, list->length - count, count);
+
+    // find the first node to pop
+    dlist_node_t *first = list->tail;
+
+    for(size_t i = 1; i < count; i++) {
+        first = first->prev;
+    }
+
+    // detach the last count nodes from the list
+    dlist_node_t *node = list->tail;
+    list->tail = first->prev;
+
+    if(list->tail != NULL) {
+        list->tail->next = NULL;
+    } else {
+        list->head = NULL;
+    }
+
+    list->length -= count;
+
+    // copy out the data and release the nodes, from
+    // the back to the front
+    char *dest = out;
+
+    for(size_t i = 0; i < count; i++) {
+        dlist_node_t *prev = node->prev;
+
+        if(dest != NULL) {
+            dlist_data_copy(dest, node->data, list->size);
+            dest += list->size;
+        }
+
+        dlist_node_free(list, node);
+        node = prev;
+    }
+
+    return count;
+}
+
+int dlist_swap(dlist_t *list, size_t pos_a, size_t pos_b) {
+    // swapping an element with itself is a nop
+    if(list->length > 0 && pos_a == pos_b) {
+        return 0;
+    }
+
+    // make sure that pos_a is smaller than pos_b
+    if(pos_a > pos_b) {
+        swap(pos_a, pos_b);
+    }
+
+    dlist_node_t *node_a = NULL;
+    dlist_node_t *node_b = NULL;
+    dlist_node_t *node;
+
+    // determine if it makes more sense to use the
+    // index, or to scan the list forward or backwards
+    // to get both nodes
+    if(list->index != NULL && pos_b < list->length) {
+        node_a = dlist_node_get(list, pos_a);
+        node_b = dlist_node_get(list, pos_b);
+    } else if(pos_a < ((list->length - pos_b)-1)) {
+        // scan forwards
+        node = list->head;
+
+        for(size_t i = 0; 
+            node != NULL && (node_a == NULL || node_b == NULL); 
+            i++, node = node->next) 
+        {
+            if(i == pos_a) node_a = node;
+            if(i == pos_b) node_b = node;
+        }
+    } else {
+        // scan backwards
+        node = list->tail;
+
+        for(size_t i = list->length-1;
+            node != NULL && (node_a == NULL || node_b == NULL);
             i--, node = node->prev)
         {
             if(i == pos_a) node_a = node;
@@ -537,9 +1283,161 @@ int dlist_swap(dlist_t *list, size_t pos_a, size_t pos_b) {
         assert(node_a->next == NULL);
     }
 
+    dlist_index_swap(list, pos_a, pos_b, node_a, node_b);
+
+    return 0;
+}
+
+
+int dlist_cursor_init(dlist_cursor_t *cursor, dlist_t *list, size_t pos)
+{
+    if(cursor == NULL || list == NULL || pos > list->length) {
+        return -1;
+    }
+
+    cursor->list = list;
+    cursor->pos = pos;
+    cursor->node = (pos < list->length) ? dlist_node_get(list, pos) : NULL;
+
+    return 0;
+}
+
+int dlist_cursor_next(dlist_cursor_t *cursor)
+{
+    // can't go past the end
+    if(cursor->node == NULL) {
+        return -1;
+    }
+
+    cursor->node = cursor->node->next;
+    cursor->pos++;
+
+    return 0;
+}
+
+int dlist_cursor_prev(dlist_cursor_t *cursor)
+{
+    // from past the end, go to the last node
+    dlist_node_t *prev = (cursor->node != NULL) ? cursor->node->prev : cursor->list->tail;
+
+    // can't go before the first node
+    if(prev == NULL) {
+        return -1;
+    }
+
+    cursor->node = prev;
+    cursor->pos--;
+
+    return 0;
+}
+
+void *dlist_cursor_get(const dlist_cursor_t *cursor)
+{
+    if(cursor->node == NULL) {
+        return NULL;
+    }
+
+    return cursor->node->data;
+}
+
+size_t dlist_cursor_pos(const dlist_cursor_t *cursor)
+{
+    return cursor->pos;
+}
+
+void *dlist_insert_before(dlist_cursor_t *cursor, void *data)
+{
+    dlist_t *list = cursor->list;
+    dlist_node_t *new = dlist_node_alloc(list);
+
+    if(new == NULL) {
+        return NULL;
+    }
+
+    // set node data, if neccessary
+    if(data != NULL) {
+        dlist_data_copy(new->data, data, list->size);
+    }
+
+    dlist_node_link(list, new, cursor->node);
+    dlist_index_insert(list, cursor->pos, new);
+
+    // the cursor's node moved back by one
+    cursor->pos++;
+
+    return new->data;
+}
+
+void *dlist_insert_after(dlist_cursor_t *cursor, void *data)
+{
+    // there is nothing after past the end
+    if(cursor->node == NULL) {
+        return NULL;
+    }
+
+    dlist_t *list = cursor->list;
+    dlist_node_t *new = dlist_node_alloc(list);
+
+    if(new == NULL) {
+        return NULL;
+    }
+
+    // set node data, if neccessary
+    if(data != NULL) {
+        dlist_data_copy(new->data, data, list->size);
+    }
+
+    dlist_node_link(list, new, cursor->node->next);
+    dlist_index_insert(list, cursor->pos + 1, new);
+
+    return new->data;
+}
+
+int dlist_remove_at(dlist_cursor_t *cursor)
+{
+    dlist_node_t *node = cursor->node;
+
+    // can't remove past the end
+    if(node == NULL) {
+        return -1;
+    }
+
+    dlist_index_remove(cursor->list, cursor->pos, node);
+
+    // the next node takes the place of this one
+    cursor->node = node->next;
+
+    dlist_node_unlink(cursor->list, node);
+    dlist_node_free(cursor->list, node);
+
     return 0;
 }
 
+int dlist_move_to_front(dlist_cursor_t *cursor)
+{
+    dlist_t *list = cursor->list;
+    dlist_node_t *node = cursor->node;
+
+    // can't move what isn't there
+    if(node == NULL) {
+        return -1;
+    }
+
+    // already at the front
+    if(node == list->head) {
+        return 0;
+    }
+
+    dlist_index_remove(list, cursor->pos, node);
+    dlist_node_unlink(list, node);
+
+    dlist_node_link(list, node, list->head);
+    dlist_index_insert(list, 0, node);
+
+    cursor->pos = 0;
+
+    return 0;
+}
 
 dlist_t *dlist_split(dlist_t *list, size_t pos)
 {
@@ -549,23 +1447,36 @@ dlist_t *dlist_split(dlist_t *list, size_t pos)
         return NULL;
     }
 
-    // allocate new dlist
-    dlist_t *new = dlist_new(list->size);
-    assert(new != NULL);
+    // allocate new dlist, sharing the pool (if any)
+    dlist_t *new = dlist_new_like(list);
+
+    // make sure that worked
+    if(new == NULL) {
+        return NULL;
+    }
 
     // check if we should transfer the
     // whole list
     if(pos == 0) {
-        memcpy(new, list, sizeof(dlist_t));
-        memset(list,   0, sizeof(dlist_t));
+        dlist_index_remove_range(list, 0, list->length);
+
+        new->head = list->head;
+        new->tail = list->tail;
+        new->length = list->length;
 
-        // data size stays the same
-        list->size = new->size;
+        list->head = NULL;
+        list->tail = NULL;
+        list->length = 0;
     } else {
         // get the node just before pos
         dlist_node_t *node = dlist_node_get(list, pos-1);
         assert(node != NULL);
 
+        // the nodes from pos on leave the list. looking
+        // up node may have rebuilt the index, so this has
+        // to come after it.
+        dlist_index_remove_range(list, pos, list->length - pos);
+
         // set head and tail of new list
         new->tail = list->tail;
         new->head = node->next;
@@ -598,10 +1509,23 @@ dlist_t *dlist_join(dlist_t *dest, dlist_t *src)
         return dest;
     }
 
+    // dest needs to be able to get rid of the
+    // nodes of src later on
+    if(dlist_adopt(dest, src) < 0) {
+        return NULL;
+    }
+
+    // all nodes of src move to the end of dest
+    size_t pos = dest->length;
+    dlist_node_t *first = src->head;
+    dlist_index_remove_range(src, 0, src->length);
+
     // if dest is empty, we can get away with
-    // simply copying data */
+    // simply taking over the nodes of src
     if(dest->length == 0) {
-        memcpy(dest, src, sizeof(dlist_t));
+        dest->head   = src->head;
+        dest->tail   = src->tail;
+        dest->length = src->length;
     } else {
         assert(dest->tail != NULL);
         assert(src->head != NULL);
@@ -615,100 +1539,1260 @@ dlist_t *dlist_join(dlist_t *dest, dlist_t *src)
         dest->length    += src->length;
     }
 
-    // reset src, but keep data size
-    memset(src, 0, sizeof(dlist_t));
-    src->size = dest->size;
+    // reset src, but keep data size and pool
+    src->head = NULL;
+    src->tail = NULL;
+    src->length = 0;
+
+    dlist_index_insert_range(dest, pos, dest->length - pos, first);
 
     return dest;
 }
 
-int dlist_reverse(dlist_t *list)
+int dlist_splice(dlist_t *dest, size_t dest_pos, dlist_t *src, size_t from, size_t count)
 {
-    for(dlist_node_t *node = list->head; node != NULL; node = node->prev) {
-        // for every node, swap node->next and
-        // node->prev
-        swap(node->next, node->prev);
+    // moving within one list or between lists of
+    // different sizes is not supported
+    if(dest == src || dest->size != src->size) {
+        return -1;
     }
-    
+
+    // make sure all positions exist
+    if(dest_pos > dest->length || from > src->length || count > (src->length - from)) {
+        return -2;
+    }
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    // dest needs to be able to get rid of the
+    // nodes of src later on
+    if(dlist_adopt(dest, src) < 0) {
+        return -3;
+    }
+
+    dlist_node_t *first = dlist_node_get(src, from);
+    dlist_node_t *last = dlist_node_get(src, from + count - 1);
+    dlist_node_t *next = (dest_pos < dest->length) ? dlist_node_get(dest, dest_pos) : NULL;
+    assert(first != NULL);
+    assert(last != NULL);
+
+    dlist_node_splice(dest, dest_pos, next, src, from, first, last, count);
+
+    return 0;
+}
+
+int dlist_splice_at(dlist_cursor_t *dest, dlist_cursor_t *first, dlist_cursor_t *end)
+{
+    dlist_t *src = first->list;
+
+    // the range has to be in one list, and another
+    // one than dest
+    if(end->list != src || dest->list == src || dest->list->size != src->size) {
+        return -1;
+    }
+
+    // the range can't end before it starts
+    if(end->pos < first->pos) {
+        return -2;
+    }
+
+    size_t count = end->pos - first->pos;
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    // dest needs to be able to get rid of the
+    // nodes of src later on
+    if(dlist_adopt(dest->list, src) < 0) {
+        return -3;
+    }
+
+    dlist_node_t *last = (end->node != NULL) ? end->node->prev : src->tail;
+    dlist_node_splice(dest->list, dest->pos, dest->node, src, first->pos, first->node, last, count);
+
+    // the range is now in front of dest, and gone from
+    // between first and end
+    dest->pos += count;
+    first->node = end->node;
+    end->pos = first->pos;
+
+    return 0;
+}
+
+int dlist_partition(dlist_t *list, dlist_classify_element *classify, void *ctx, dlist_t **outs, size_t n)
+{
+    if(classify == NULL || outs == NULL || n == 0) {
+        return -1;
+    }
+
+    // check all lists before moving anything
+    for(size_t i = 0; i < n; i++) {
+        if(outs[i] == NULL || outs[i] == list || outs[i]->size != list->size) {
+            return -1;
+        }
+    }
+
+    // the lists need to be able to get rid of the
+    // nodes of list later on
+    for(size_t i = 0; i < n; i++) {
+        if(dlist_adopt(outs[i], list) < 0) {
+            return -2;
+        }
+        dlist_index_invalidate(outs[i]);
+    }
+
+    // take all nodes out of list, the ones that stay
+    // are appended to it again
+    dlist_node_t *node = list->head;
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+    dlist_index_invalidate(list);
+
+    while(node != NULL) {
+        dlist_node_t *next = node->next;
+        size_t i = classify(node->data, ctx);
+        dlist_t *out = (i < n) ? outs[i] : list;
+
+        // append node to out
+        node->next = NULL;
+        node->prev = out->tail;
+
+        if(out->tail != NULL) {
+            out->tail->next = node;
+        } else {
+            out->head = node;
+        }
+
+        out->tail = node;
+        out->length++;
+
+        node = next;
+    }
+
+    return 0;
+}
+
+int dlist_reverse(dlist_t *list)
+{
+    for(dlist_node_t *node = list->head; node != NULL; node = node->prev) {
+        // for every node, swap node->next and
+        // node->prev
+        swap(node->next, node->prev);
+    }
+    
     // also swap list head and tail
     swap(list->head, list->tail);
 
-    return 0;
+    dlist_index_invalidate(list);
+
+    return 0;
+}
+
+int dlist_sort(dlist_t *list, dlist_compare_elements *cmp)
+{
+    if(list == NULL || cmp == NULL) {
+        return -1;
+    }
+
+    // lists of zero or one element are always sorted
+    if(list->length < 2) {
+        return 0;
+    }
+
+    list->head = dlist_node_sort(list->head, list->length, cmp);
+    dlist_node_relink(list);
+
+    return 0;
+}
+
+int dlist_sort_parallel(dlist_t *list, dlist_compare_elements *cmp, size_t nthreads)
+{
+    if(list == NULL || cmp == NULL) {
+        return -1;
+    }
+
+    // every thread should get a decent amount of work,
+    // otherwise starting it costs more than it saves
+    size_t chunks = nthreads;
+    if(chunks > DLIST_SORT_THREADS_MAX) {
+        chunks = DLIST_SORT_THREADS_MAX;
+    }
+
+    if(chunks > (list->length / DLIST_SORT_CHUNK_MIN)) {
+        chunks = list->length / DLIST_SORT_CHUNK_MIN;
+    }
+
+    if(chunks < 2) {
+        return dlist_sort(list, cmp);
+    }
+
+    struct dlist_sort_state state;
+    state.chunks = chunks;
+    state.cmp = cmp;
+    state.samples = malloc(chunks * DLIST_SORT_SAMPLES * sizeof(void*));
+    state.splitters = malloc((chunks - 1) * sizeof(void*));
+    state.segments = malloc(chunks * chunks * sizeof(dlist_node_t*));
+    struct dlist_sort_job *jobs = malloc(chunks * sizeof(struct dlist_sort_job));
+
+    // if we can't get memory for the jobs, sorting with
+    // one thread is better than not sorting at all
+    if(state.samples == NULL || state.splitters == NULL || state.segments == NULL || jobs == NULL) {
+        free(state.samples);
+        free(state.splitters);
+        free(state.segments);
+        free(jobs);
+        return dlist_sort(list, cmp);
+    }
+
+    if(pthread_mutex_init(&state.lock, NULL) != 0) {
+        free(state.samples);
+        free(state.splitters);
+        free(state.segments);
+        free(jobs);
+        return dlist_sort(list, cmp);
+    }
+
+    pthread_cond_init(&state.work, NULL);
+    pthread_cond_init(&state.done, NULL);
+    state.jobs = jobs;
+    state.worker = NULL;
+    state.phase = 0;
+    state.next = chunks;
+    state.finished = chunks;
+    state.quit = false;
+
+    // cut the list into chunks of (almost) equal length
+    dlist_node_t *rest = list->head;
+    for(size_t i = 0; i < chunks; i++) {
+        jobs[i].length = (list->length / chunks) + ((i < (list->length % chunks)) ? 1 : 0);
+        jobs[i].head = rest;
+        jobs[i].tail = NULL;
+        jobs[i].id = i;
+        jobs[i].state = &state;
+        rest = dlist_node_cut(rest, jobs[i].length);
+    }
+
+    assert(rest == NULL);
+
+    // the threads are started once and then do the jobs
+    // of every phase. the calling thread helps out, so
+    // it needs one less. if a thread can't be started,
+    // the others take over its share.
+    pthread_t threads[DLIST_SORT_THREADS_MAX];
+    size_t started = 0;
+
+    while((started + 1) < chunks && pthread_create(&threads[started], NULL, dlist_sort_thread, &state) == 0) {
+        started++;
+    }
+
+    // sort all chunks at the same time. merging them
+    // pairwise would leave the last round to a single
+    // thread, so instead the elements are split into one
+    // bucket per thread, using samples of the sorted
+    // chunks to find values that make the buckets about
+    // equally large
+    dlist_sort_run(&state, dlist_sort_worker);
+    dlist_sort_splitters(&state);
+
+    // every chunk is cut into one segment per bucket,
+    // then the segments of every bucket are merged. the
+    // buckets themselves are in order already.
+    dlist_sort_run(&state, dlist_split_worker);
+    dlist_sort_run(&state, dlist_merge_worker);
+
+    pthread_mutex_lock(&state.lock);
+    state.quit = true;
+    pthread_cond_broadcast(&state.work);
+    pthread_mutex_unlock(&state.lock);
+
+    for(size_t i = 0; i < started; i++) {
+        pthread_join(threads[i], NULL);
+    }
+
+    pthread_cond_destroy(&state.work);
+    pthread_cond_destroy(&state.done);
+    pthread_mutex_destroy(&state.lock);
+
+    // chain the buckets together. the merge workers have
+    // fixed the prev pointers inside of every bucket.
+    dlist_node_t *tail = NULL;
+    list->head = NULL;
+
+    for(size_t k = 0; k < chunks; k++) {
+        if(jobs[k].head == NULL) {
+            continue;
+        }
+
+        if(tail != NULL) {
+            tail->next = jobs[k].head;
+        } else {
+            list->head = jobs[k].head;
+        }
+
+        jobs[k].head->prev = tail;
+        tail = jobs[k].tail;
+    }
+
+    assert(tail != NULL && tail->next == NULL);
+    list->tail = tail;
+
+    // the nodes are in a different order now
+    dlist_index_invalidate(list);
+
+    free(state.samples);
+    free(state.splitters);
+    free(state.segments);
+    free(jobs);
+
+    return 0;
+}
+
+int dlist_radix_sort(dlist_t *list, size_t key_offset, size_t key_width)
+{
+    if(list == NULL) {
+        return -1;
+    }
+
+    // the key has to be an unsigned integer that lies
+    // completely inside of the element
+    if(key_width != 1 && key_width != 2 && key_width != 4 && key_width != 8) {
+        return -1;
+    }
+
+    if((key_offset + key_width) > list->size) {
+        return -1;
+    }
+
+    // lists of zero or one element are always sorted
+    if(list->length < 2) {
+        return 0;
+    }
+
+    dlist_node_t *heads[DLIST_RADIX_BUCKETS];
+    dlist_node_t *tails[DLIST_RADIX_BUCKETS];
+
+    // sort by one digit of the key per pass, starting
+    // with the least significant one. the buckets keep
+    // the order of the previous pass, so every pass is
+    // stable and the result is sorted by the whole key.
+    for(size_t shift = 0; shift < (key_width * 8); shift += DLIST_RADIX_BITS) {
+        memset(heads, 0, sizeof(heads));
+
+        // distribute the nodes into the bucket chains
+        for(dlist_node_t *node = list->head; node != NULL; node = node->next) {
+            size_t digit = (dlist_node_key(node, key_offset, key_width) >> shift) & (DLIST_RADIX_BUCKETS - 1);
+
+            if(heads[digit] == NULL) {
+                heads[digit] = node;
+            } else {
+                tails[digit]->next = node;
+            }
+
+            tails[digit] = node;
+        }
+
+        // and put the chains back together in order
+        dlist_node_t **link = &list->head;
+        for(size_t digit = 0; digit < DLIST_RADIX_BUCKETS; digit++) {
+            if(heads[digit] != NULL) {
+                *link = heads[digit];
+                link = &tails[digit]->next;
+                list->tail = tails[digit];
+            }
+        }
+
+        *link = NULL;
+    }
+
+    // the prev pointers only match the old order
+    dlist_node_relink(list);
+
+    return 0;
+}
+
+dlist_t *dlist_from_array(const void *data, size_t count, size_t size)
+{
+    if(data == NULL && count > 0) {
+        return NULL;
+    }
+
+    dlist_t *list = dlist_new_pooled(size, 0);
+
+    if(list == NULL) {
+        return NULL;
+    }
+
+    // put all nodes into one slab, which hands them
+    // out in address order
+    if(pool_reserve(list->pool, count) < 0) {
+        dlist_free(list);
+        return NULL;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        void *element = dlist_append(list, NULL);
+        assert(element != NULL);
+
+        dlist_data_copy(element, ((const char*) data) + (i * size), size);
+    }
+
+    return list;
+}
+
+void *dlist_to_array(const dlist_t *list, void *out)
+{
+    if(list == NULL) {
+        return NULL;
+    }
+
+    // allocate an array if we didn't get one
+    if(out == NULL) {
+        out = malloc((list->length > 0) ? (list->length * list->size) : 1);
+
+        if(out == NULL) {
+            return NULL;
+        }
+    }
+
+    char *pos = out;
+    for(dlist_node_t *node = list->head; node != NULL; node = node->next) {
+        dlist_data_copy(pos, node->data, list->size);
+        pos += list->size;
+    }
+
+    return out;
+}
+
+/* create a copy of a list */
+dlist_t *dlist_copy(const dlist_t *list)
+{
+    // a list that allocates its nodes one by one gets a
+    // pool for the copy, so that the copy can be laid out
+    // in one block. otherwise the copy allocates nodes the
+    // same way as the original (sharing the pool, if any)
+    dlist_t *copy;
+    if(list->pool == NULL && list->arena == NULL && list->allocator == NULL) {
+        copy = dlist_new_pooled(list->size, 0);
+    } else {
+        copy = dlist_new_like(list);
+    }
+
+    // make sure malloc worked
+    if(copy == NULL) {
+        return NULL;
+    }
+
+    // get all nodes from one slab, so that they lie next
+    // to each other in the same order as in the list
+    if(copy->pool != NULL && pool_reserve(copy->pool, list->length) < 0) {
+        dlist_free(copy);
+        return NULL;
+    }
+
+    /* node is the one from the original list
+     * and new is the one we create as copy */
+    dlist_node_t *prev = NULL;
+    for(dlist_node_t *node = list->head; node != NULL; node = node->next) {
+        dlist_node_t *new = dlist_node_alloc(copy);
+
+        // make sure allocation worked
+        if(new == NULL) {
+            dlist_free(copy);
+            return NULL;
+        }
+
+        dlist_data_copy(new->data, node->data, list->size);
+
+        new->prev = prev;
+        new->next = NULL;
+
+        if(prev != NULL) {
+            prev->next = new;
+        } else {
+            copy->head = new;
+        }
+
+        prev = new;
+        copy->tail = new;
+        copy->length++;
+    }
+
+    return copy;
+}
+
+int dlist_compact(dlist_t *list)
+{
+    if(list == NULL) {
+        return -1;
+    }
+
+    size_t pos = 0;
+    int ret = dlist_compact_step(list, &pos, list->length);
+
+    return (ret < 0) ? ret : 0;
+}
+
+int dlist_compact_step(dlist_t *list, size_t *pos, size_t count)
+{
+    if(list == NULL || pos == NULL) {
+        return -1;
+    }
+
+    // there is no contiguous memory to be had from
+    // arenas or allocators
+    if(list->arena != NULL || list->allocator != NULL) {
+        return -1;
+    }
+
+    // if the list got shorter since the last step, we
+    // are done with this round
+    if(*pos >= list->length) {
+        *pos = 0;
+        return 0;
+    }
+
+    if(count > (list->length - *pos)) {
+        count = list->length - *pos;
+    }
+
+    if(count == 0) {
+        return 1;
+    }
+
+    // the new nodes come from a pool
+    if(list->pool == NULL) {
+        list->pool = pool_new(sizeof(dlist_node_t) + list->size, 0);
+
+        if(list->pool == NULL) {
+            return -1;
+        }
+    }
+
+    // which hands them out from a single slab
+    if(pool_reserve(list->pool, count) < 0) {
+        return -1;
+    }
+
+    // find the nodes to replace
+    dlist_node_t *old = dlist_node_get(list, *pos);
+    dlist_node_t *prev = old->prev;
+
+    // make copies of all of them first. releasing old
+    // nodes could make the pool hand out nodes from
+    // their slab rather than the new one.
+    dlist_node_t *head = NULL;
+    dlist_node_t *last = NULL;
+    dlist_node_t *node = old;
+
+    for(size_t i = 0; i < count; i++, node = node->next) {
+        dlist_node_t *new = dlist_node_alloc(list);
+
+        // on error, release the copies and leave the
+        // list as it was
+        if(new == NULL) {
+            while(head != NULL) {
+                dlist_node_t *next = (head == last) ? NULL : head->next;
+                dlist_node_free(list, head);
+                head = next;
+            }
+
+            return -1;
+        }
+
+        dlist_data_copy(new->data, node->data, list->size);
+
+        new->prev = last;
+        if(last != NULL) {
+            last->next = new;
+        } else {
+            head = new;
+        }
+
+        last = new;
+    }
+
+    // node is the first node after the replaced ones
+    head->prev = prev;
+    last->next = node;
+
+    // the index has to point to the new nodes
+    dlist_index_replace(list, *pos, count, head);
+
+    // release the old nodes
+    for(size_t i = 0; i < count; i++) {
+        dlist_node_t *next = old->next;
+        dlist_node_free(list, old);
+        old = next;
+    }
+
+    // and put the copies in their place
+    if(prev != NULL) {
+        prev->next = head;
+    } else {
+        list->head = head;
+    }
+
+    if(node != NULL) {
+        node->prev = last;
+    } else {
+        list->tail = last;
+    }
+
+    *pos += count;
+
+    if(*pos >= list->length) {
+        *pos = 0;
+        return 0;
+    }
+
+    return 1;
+}
+
+int dlist_locality_stats(const dlist_t *list, locality_stats_t *stats)
+{
+    if(list == NULL) {
+        return -1;
+    }
+
+    return locality_measure(stats, list->head, offsetof(dlist_node_t, next), list->length);
+}
+
+int dlist_verify(const dlist_t *list) {
+    if(list == NULL) {
+        return -1;
+    }
+
+    // head and tail are set exactly if the list is
+    // not empty
+    if((list->length == 0) != (list->head == NULL) || (list->length == 0) != (list->tail == NULL)) {
+        return -3;
+    }
+
+    // nothing comes before the head
+    if(list->head != NULL && list->head->prev != NULL) {
+        return -7;
+    }
+
+    // recognize loops with brent's algorithm, see
+    // slist_verify()
+    const dlist_node_t *tortoise = NULL;
+    size_t power = 1;
+    size_t lambda = 0;
+    size_t cur_index = 0;
+
+    for(dlist_node_t *node = list->head; node != NULL; node = node->next) {
+        if(node == tortoise) {
+            return -2;
+        }
+
+        if(lambda == power) {
+            tortoise = node;
+            power *= 2;
+            lambda = 0;
+        }
+
+        lambda++;
+
+        if((cur_index+1) == list->length) {
+            if(node != list->tail) {
+                return -4;
+            }
+
+            if(node->next != NULL) {
+                return -5;
+            }
+        }
+
+        // the next node must point back to this one. as
+        // the head has no prev, this means that walking
+        // backwards from the tail gives the same nodes.
+        if(node->next != NULL && node->next->prev != node) {
+            return -8;
+        }
+
+        cur_index++;
+    }
+
+    if(cur_index != list->length) {
+        return -6;
+    }
+
+    // check the index, if it is up to date
+    if(list->index != NULL && !list->index->stale) {
+        return dlist_index_verify(list);
+    }
+
+    return 0;
+}
+
+static dlist_node_t *dlist_node_alloc(dlist_t *list)
+{
+    // take node from the pool, if there is one
+    if(list->pool != NULL) {
+        return pool_get(list->pool);
+    }
+
+    // or from the arena
+    if(list->arena != NULL) {
+        return arena_alloc(list->arena, sizeof(dlist_node_t) + list->size);
+    }
+
+    // or with the allocator
+    if(list->allocator != NULL) {
+        return allocator_alloc(list->allocator, sizeof(dlist_node_t) + list->size);
+    }
+
+    // otherwise go through the node cache, which falls
+    // back to malloc() if it is disabled
+    return nodecache_alloc(sizeof(dlist_node_t) + list->size);
+}
+
+static void dlist_node_free(dlist_t *list, dlist_node_t *node)
+{
+    // nodes from an arena are released all at once
+    if(list->arena != NULL) {
+        return;
+    }
+
+    // let the allocator deal with it
+    if(list->allocator != NULL) {
+        allocator_free(list->allocator, node, sizeof(dlist_node_t) + list->size);
+        return;
+    }
+
+    // put node back into the pool, unless it was not
+    // allocated from it (it could have been joined
+    // in from a list without a pool)
+    if(list->pool != NULL && pool_put(list->pool, node) == 0) {
+        return;
+    }
+
+    nodecache_free(node, sizeof(dlist_node_t) + list->size);
+}
+
+static dlist_t *dlist_new_like(const dlist_t *list)
+{
+    // lists using an arena live in it as well
+    if(list->arena != NULL) {
+        return dlist_new_arena(list->size, list->arena);
+    }
+
+    // same for lists using an allocator
+    if(list->allocator != NULL) {
+        return dlist_new_allocator(list->size, list->allocator);
+    }
+
+    dlist_t *new = dlist_new(list->size);
+
+    if(new == NULL) {
+        return NULL;
+    }
+
+    // share the pool
+    new->pool = pool_ref(list->pool);
+
+    return new;
+}
+
+static int dlist_adopt(dlist_t *dest, const dlist_t *src)
+{
+    // nodes from an arena can't be free()d, and nodes
+    // in an arena list would never be released, so
+    // those can only be mixed within the same arena.
+    // the same goes for custom allocators.
+    if(dest->arena != src->arena || dest->allocator != src->allocator) {
+        return -1;
+    }
+
+    // nodes allocated with malloc() can be released
+    // by any list
+    if(src->pool == NULL) {
+        return 0;
+    }
+
+    // dest has no pool, so it can simply start using the
+    // one of src. nodes dest already has are not from the
+    // pool, so they still get free()d.
+    if(dest->pool == NULL) {
+        dest->pool = pool_ref(src->pool);
+        return 0;
+    }
+
+    // both have pools, merge them
+    if(pool_merge(dest->pool, src->pool) == NULL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static uint64_t dlist_node_key(const dlist_node_t *node, size_t offset, size_t width)
+{
+    // the key might not be aligned, so copy it out
+    switch(width) {
+        case 1: {
+            uint8_t key;
+            memcpy(&key, node->data + offset, sizeof(key));
+            return key;
+        }
+        case 2: {
+            uint16_t key;
+            memcpy(&key, node->data + offset, sizeof(key));
+            return key;
+        }
+        case 4: {
+            uint32_t key;
+            memcpy(&key, node->data + offset, sizeof(key));
+            return key;
+        }
+        default: {
+            uint64_t key;
+            memcpy(&key, node->data + offset, sizeof(key));
+            return key;
+        }
+    }
+}
+
+static void dlist_node_link(dlist_t *list, dlist_node_t *node, dlist_node_t *next)
+{
+    dlist_node_t *prev = (next != NULL) ? next->prev : list->tail;
+
+    node->prev = prev;
+    node->next = next;
+
+    if(prev != NULL) {
+        prev->next = node;
+    } else {
+        list->head = node;
+    }
+
+    if(next != NULL) {
+        next->prev = node;
+    } else {
+        list->tail = node;
+    }
+
+    list->length++;
+}
+
+static void dlist_node_splice(dlist_t *dest, size_t dest_pos, dlist_node_t *next, dlist_t *src, size_t from, dlist_node_t *first, dlist_node_t *last, size_t count)
+{
+    dlist_index_remove_range(src, from, count);
+
+    // take the range out of src
+    if(first->prev != NULL) {
+        first->prev->next = last->next;
+    } else {
+        src->head = last->next;
+    }
+
+    if(last->next != NULL) {
+        last->next->prev = first->prev;
+    } else {
+        src->tail = first->prev;
+    }
+
+    src->length -= count;
+
+    // and link it into dest
+    dlist_node_t *prev = (next != NULL) ? next->prev : dest->tail;
+
+    first->prev = prev;
+    last->next = next;
+
+    if(prev != NULL) {
+        prev->next = first;
+    } else {
+        dest->head = first;
+    }
+
+    if(next != NULL) {
+        next->prev = last;
+    } else {
+        dest->tail = last;
+    }
+
+    dest->length += count;
+    dlist_index_insert_range(dest, dest_pos, count, first);
+}
+
+static void dlist_node_unlink(dlist_t *list, dlist_node_t *node)
+{
+    if(node->prev != NULL) {
+        node->prev->next = node->next;
+    } else {
+        list->head = node->next;
+    }
+
+    if(node->next != NULL) {
+        node->next->prev = node->prev;
+    } else {
+        list->tail = node->prev;
+    }
+
+    list->length--;
+}
+
+static dlist_node_t *dlist_node_new_with(dlist_t *list, dlist_init_element *init, void *ctx)
+{
+    if(init == NULL) {
+        return NULL;
+    }
+
+    dlist_node_t *node = dlist_node_alloc(list);
+
+    // make sure allocation worked
+    if(node == NULL) {
+        return NULL;
+    }
+
+    // build the element, giving the node back if that
+    // didn't work out
+    if(init(node->data, ctx) < 0) {
+        dlist_node_free(list, node);
+        return NULL;
+    }
+
+    return node;
+}
+
+static void dlist_node_free_chain(dlist_t *list, dlist_node_t *node)
+{
+    while(node != NULL) {
+        dlist_node_t *next = node->next;
+        dlist_node_free(list, node);
+        node = next;
+    }
+}
+
+static dlist_node_t *dlist_node_chain(dlist_t *list, const void *data, size_t count, dlist_node_t **last)
+{
+    // get all nodes from one slab, so that they lie next
+    // to each other in the same order as in the list
+    if(list->pool != NULL && pool_reserve(list->pool, count) < 0) {
+        return NULL;
+    }
+
+    dlist_node_t *first = NULL;
+    dlist_node_t *prev = NULL;
+    const char *src = data;
+
+    for(size_t i = 0; i < count; i++) {
+        dlist_node_t *node = dlist_node_alloc(list);
+
+        // on failure, give back what we got so far
+        if(node == NULL) {
+            dlist_node_free_chain(list, first);
+            return NULL;
+        }
+
+        if(src != NULL) {
+            dlist_data_copy(node->data, src, list->size);
+            src += list->size;
+        }
+
+        node->prev = prev;
+        node->next = NULL;
+
+        if(prev != NULL) {
+            prev->next = node;
+        } else {
+            first = node;
+        }
+
+        prev = node;
+    }
+
+    *last = prev;
+
+    return first;
+}
+
+static dlist_node_t *dlist_node_cut(dlist_node_t *node, size_t count)
+{
+    // walk to the last node we keep
+    for(size_t i = 1; node != NULL && i < count; i++) {
+        node = node->next;
+    }
+
+    if(node == NULL) {
+        return NULL;
+    }
+
+    dlist_node_t *rest = node->next;
+    node->next = NULL;
+
+    return rest;
+}
+
+static dlist_node_t **dlist_node_merge(dlist_node_t **link, dlist_node_t *a, dlist_node_t *b, dlist_compare_elements *cmp)
+{
+    // take from a when elements are equal to keep the
+    // sort stable
+    while(a != NULL && b != NULL) {
+        if(cmp(a->data, b->data) >= 0) {
+            *link = a;
+            a = a->next;
+        } else {
+            *link = b;
+            b = b->next;
+        }
+
+        link = &(*link)->next;
+    }
+
+    // append whatever is left over, and skip to its end
+    *link = (a != NULL) ? a : b;
+
+    while(*link != NULL) {
+        link = &(*link)->next;
+    }
+
+    return link;
+}
+
+static dlist_node_t *dlist_node_sort(dlist_node_t *head, size_t length, dlist_compare_elements *cmp)
+{
+    // merge runs of width nodes into runs of twice that,
+    // until there is only one run left
+    for(size_t width = 1; width < length; width *= 2) {
+        dlist_node_t *rest = head;
+        dlist_node_t **link = &head;
+
+        while(rest != NULL) {
+            // take the next two runs off the chain
+            dlist_node_t *a = rest;
+            dlist_node_t *b = dlist_node_cut(a, width);
+            rest = dlist_node_cut(b, width);
+
+            link = dlist_node_merge(link, a, b, cmp);
+        }
+    }
+
+    return head;
+}
+
+static void dlist_node_relink(dlist_t *list)
+{
+    dlist_node_t *prev = NULL;
+    for(dlist_node_t *node = list->head; node != NULL; node = node->next) {
+        node->prev = prev;
+        prev = node;
+    }
+
+    list->tail = prev;
+
+    // the nodes are in a different order now
+    dlist_index_invalidate(list);
 }
 
-/* create a copy of a list */
-dlist_t *dlist_copy(const dlist_t *list)
+static void dlist_sort_worker(struct dlist_sort_job *job)
 {
-    // allocate new list
-    dlist_t *copy = dlist_new(list->size);
+    struct dlist_sort_state *state = job->state;
+    job->head = dlist_node_sort(job->head, job->length, state->cmp);
 
-    // make sure malloc worked
-    if(copy == NULL) {
-        return NULL;
-    }
+    // take evenly spaced samples, starting with the
+    // smallest element. chunks are much longer than
+    // the amount of samples.
+    void **samples = &state->samples[job->id * DLIST_SORT_SAMPLES];
+    dlist_node_t *node = job->head;
+    size_t pos = 0;
 
-    /* node is the one from the original list
-     * and copy is the one we create as copy */
-    for(dlist_node_t *node = list->head; node != NULL; node = node->next) {
-        // add data as we go
-        void *result = dlist_append(copy, node->data);
+    for(size_t i = 0; i < DLIST_SORT_SAMPLES; i++) {
+        size_t target = (i * job->length) / DLIST_SORT_SAMPLES;
 
-        // make sure appending worked
-        if(result == NULL) {
-            dlist_free(copy);
-            return NULL;
+        while(pos < target) {
+            node = node->next;
+            pos++;
         }
+
+        samples[i] = node->data;
     }
+}
 
-    return copy;
+static void dlist_split_worker(struct dlist_sort_job *job)
+{
+    struct dlist_sort_state *state = job->state;
+    dlist_node_t **segments = &state->segments[job->id * state->chunks];
+    dlist_node_t *node = job->head;
+
+    for(size_t k = 0; k < state->chunks; k++) {
+        dlist_node_t **link = &segments[k];
+
+        // the last bucket takes everything that is left,
+        // the others everything up to their splitter, so
+        // that equal elements end up in the same bucket
+        while(node != NULL && ((k + 1) == state->chunks || state->cmp(node->data, state->splitters[k]) >= 0)) {
+            *link = node;
+            link = &node->next;
+            node = node->next;
+        }
+
+        *link = NULL;
+    }
 }
 
-int dlist_verify(const dlist_t *list) {
-    if(list == NULL) {
-        return -1;
+static void dlist_merge_worker(struct dlist_sort_job *job)
+{
+    struct dlist_sort_state *state = job->state;
+    size_t chunks = state->chunks;
+
+    // the segments of this bucket are in its column of
+    // the table, in the order of the chunks they come
+    // from. nobody else touches that column, so they are
+    // merged right there.
+    dlist_node_t **chains = &state->segments[job->id];
+
+    // merge neighbouring chains in rounds. equal elements
+    // stay in the order of their chunks, so the sort is
+    // still stable.
+    for(size_t step = 1; step < chunks; step *= 2) {
+        for(size_t j = 0; (j + step) < chunks; j += 2 * step) {
+            dlist_node_t *head;
+            dlist_node_merge(&head, chains[j * chunks], chains[(j + step) * chunks], state->cmp);
+            chains[j * chunks] = head;
+        }
     }
 
-    dlist_node_t **nodes_seen = malloc(sizeof(dlist_node_t*) * list->length);
-    size_t cur_index = 0;
+    // fix up the prev pointers inside of the bucket
+    job->head = chains[0];
+    job->tail = NULL;
+    job->length = 0;
 
-    for(dlist_node_t *node = list->head; node != NULL; node = node->next) {
-        if((cur_index+1) == list->length) {
-            if(node != list->tail) {
-                return -4;
+    for(dlist_node_t *node = job->head; node != NULL; node = node->next) {
+        node->prev = job->tail;
+        job->tail = node;
+        job->length++;
+    }
+}
+
+static void dlist_sort_splitters(struct dlist_sort_state *state)
+{
+    size_t chunks = state->chunks;
+    size_t next[DLIST_SORT_THREADS_MAX];
+
+    for(size_t j = 0; j < chunks; j++) {
+        next[j] = 0;
+    }
+
+    // merge the sorted samples of all chunks and take
+    // every DLIST_SORT_SAMPLES-th one as a splitter.
+    // there are only few samples, so looking for the
+    // smallest one every time is fast enough.
+    for(size_t rank = 1; rank < (chunks * DLIST_SORT_SAMPLES); rank++) {
+        void *smallest = NULL;
+        size_t best = 0;
+
+        for(size_t j = 0; j < chunks; j++) {
+            if(next[j] == DLIST_SORT_SAMPLES) {
+                continue;
             }
 
-            if(node->next != NULL) {
-                return -5;
+            void *sample = state->samples[j * DLIST_SORT_SAMPLES + next[j]];
+
+            if(smallest == NULL || state->cmp(sample, smallest) > 0) {
+                smallest = sample;
+                best = j;
             }
         }
 
-        for(size_t i = 0; i < cur_index; i++) {
-            if(nodes_seen[i] == node) {
-                return -2;
-            }
+        if((rank % DLIST_SORT_SAMPLES) == 0) {
+            state->splitters[(rank / DLIST_SORT_SAMPLES) - 1] = smallest;
         }
 
-        nodes_seen[cur_index] = node;
-        cur_index++;
+        next[best]++;
     }
+}
 
-    if(cur_index != list->length) {
-        return -6;
+static void *dlist_sort_thread(void *data)
+{
+    struct dlist_sort_state *state = data;
+    size_t phase = 0;
+
+    pthread_mutex_lock(&state->lock);
+
+    for(;;) {
+        while(!state->quit && state->phase == phase) {
+            pthread_cond_wait(&state->work, &state->lock);
+        }
+
+        if(state->quit) {
+            break;
+        }
+
+        phase = state->phase;
+        dlist_sort_claim(state);
     }
 
-    for(dlist_node_t *node = list->tail; node != NULL; node = node->next) {
-        if(nodes_seen[cur_index-1] != node) {
-            return -8;
+    pthread_mutex_unlock(&state->lock);
+    return NULL;
+}
+
+static void dlist_sort_claim(struct dlist_sort_state *state)
+{
+    while(state->next < state->chunks) {
+        struct dlist_sort_job *job = &state->jobs[state->next++];
+        void (*worker)(struct dlist_sort_job *job) = state->worker;
+
+        pthread_mutex_unlock(&state->lock);
+        worker(job);
+        pthread_mutex_lock(&state->lock);
+
+        if(++state->finished == state->chunks) {
+            pthread_cond_signal(&state->done);
         }
+    }
+}
+
+static void dlist_sort_run(struct dlist_sort_state *state, void (*worker)(struct dlist_sort_job *job))
+{
+    pthread_mutex_lock(&state->lock);
+
+    state->worker = worker;
+    state->next = 0;
+    state->finished = 0;
+    state->phase++;
+    pthread_cond_broadcast(&state->work);
 
-        cur_index--;
+    // the calling thread does jobs too, and then waits
+    // for the ones that others are still working on
+    dlist_sort_claim(state);
+
+    while(state->finished < state->chunks) {
+        pthread_cond_wait(&state->done, &state->lock);
     }
 
-    free(nodes_seen);
-    
-    // FIXME: check backwards!
+    pthread_mutex_unlock(&state->lock);
+}
 
-    return 0;
+static inline void dlist_data_copy(void *dest, const void *src, size_t size)
+{
+    // with a constant size, the compiler can turn memcpy()
+    // into a few moves, so handle the common element sizes
+    // separately
+    switch(size) {
+        case 4:
+            memcpy(dest, src, 4);
+            break;
+        case 8:
+            memcpy(dest, src, 8);
+            break;
+        case 16:
+            memcpy(dest, src, 16);
+            break;
+        case 32:
+            memcpy(dest, src, 32);
+            break;
+        default:
+            memcpy(dest, src, size);
+            break;
+    }
 }
 
 // internal function used to extract a node at a
@@ -728,7 +2812,7 @@ static dlist_node_t *dlist_node_get(dlist_t *list, size_t pos)
     }
 
     // easy access nodes
-    if((pos-1) == list->length) {
+    if(pos == (list->length-1)) {
         return list->tail;
     }
 
@@ -740,7 +2824,23 @@ static dlist_node_t *dlist_node_get(dlist_t *list, size_t pos)
     // is within the list and neither the head nor the
     // tail of the list
     dlist_node_t *node;
-    if(pos < (list->length/2)) {
+    if(list->index != NULL && dlist_index_build(list) == 0) {
+        // go down the lanes of the index to the closest
+        // tower, and walk the rest of the way
+        size_t found;
+        dlist_index_tower_t *tower = dlist_index_find(list->index, pos + 1, &found, NULL, NULL);
+
+        node = list->head;
+        if(tower != list->index->head) {
+            node = tower->node;
+            pos = (pos + 1) - found;
+        }
+
+        while (node && pos) {
+            node = node->next;
+            pos--;
+        }
+    } else if(pos < (list->length/2)) {
         // pos is located closer to the head than the
         // tail, so work from there
         node = list->head;
@@ -778,3 +2878,497 @@ static dlist_node_t *dlist_node_get(dlist_t *list, size_t pos)
         return node;
     }
 }
+
+static dlist_index_tower_t *dlist_index_tower_new(dlist_node_t *node, size_t height)
+{
+    dlist_index_tower_t *tower = malloc(sizeof(dlist_index_tower_t) + height * sizeof(struct dlist_index_lane));
+
+    if(tower == NULL) {
+        return NULL;
+    }
+
+    tower->node = node;
+    tower->height = height;
+
+    for(size_t l = 0; l < height; l++) {
+        tower->lanes[l].next = NULL;
+        tower->lanes[l].width = 0;
+    }
+
+    return tower;
+}
+
+static void dlist_index_clear(struct dlist_index *index)
+{
+    // every tower is on the lowest lane
+    dlist_index_tower_t *tower = index->head->lanes[0].next;
+
+    while(tower != NULL) {
+        dlist_index_tower_t *next = tower->lanes[0].next;
+        free(tower);
+        tower = next;
+    }
+
+    for(size_t l = 0; l < DLIST_INDEX_MAX_HEIGHT; l++) {
+        index->head->lanes[l].next = NULL;
+        index->head->lanes[l].width = 0;
+    }
+
+    index->height = 0;
+}
+
+static int dlist_index_build(dlist_t *list)
+{
+    struct dlist_index *index = list->index;
+
+    // nothing to do if the index is up to date
+    if(!index->stale) {
+        return 0;
+    }
+
+    dlist_index_clear(index);
+
+    // last tower on every lane, and its position
+    dlist_index_tower_t *last[DLIST_INDEX_MAX_HEIGHT];
+    size_t last_pos[DLIST_INDEX_MAX_HEIGHT];
+
+    for(size_t l = 0; l < DLIST_INDEX_MAX_HEIGHT; l++) {
+        last[l] = index->head;
+        last_pos[l] = 0;
+    }
+
+    index->height = 1;
+
+    // every fourth node gets a tower, every sixteenth
+    // node a tower with two lanes, and so on
+    size_t pos = 1;
+    for(dlist_node_t *node = list->head; node != NULL; node = node->next, pos++) {
+        size_t height = 0;
+        for(size_t p = pos; (p % 4) == 0 && height < DLIST_INDEX_MAX_HEIGHT; p /= 4) {
+            height++;
+        }
+
+        if(height == 0) {
+            continue;
+        }
+
+        dlist_index_tower_t *tower = dlist_index_tower_new(node, height);
+
+        if(tower == NULL) {
+            // terminate the lanes so the towers we have
+            // so far can be released
+            last[0]->lanes[0].next = NULL;
+            dlist_index_clear(index);
+            return -1;
+        }
+
+        for(size_t l = 0; l < height; l++) {
+            last[l]->lanes[l].next = tower;
+            last[l]->lanes[l].width = pos - last_pos[l];
+            last[l] = tower;
+            last_pos[l] = pos;
+        }
+
+        if(height > index->height) {
+            index->height = height;
+        }
+    }
+
+    // the last tower of each lane points to the end
+    for(size_t l = 0; l < index->height; l++) {
+        last[l]->lanes[l].next = NULL;
+        last[l]->lanes[l].width = (list->length + 1) - last_pos[l];
+    }
+
+    index->stale = false;
+
+    return 0;
+}
+
+static dlist_index_tower_t *dlist_index_find(const struct dlist_index *index, size_t target, size_t *found_pos, dlist_index_tower_t **update, size_t *update_pos)
+{
+    dlist_index_tower_t *tower = index->head;
+    size_t pos = 0;
+
+    // start at the highest lane and go as far as
+    // possible without passing target, then go
+    // down one lane
+    for(size_t l = index->height; l > 0; l--) {
+        struct dlist_index_lane *lane = &tower->lanes[l-1];
+
+        while(lane->next != NULL && (pos + lane->width) <= target) {
+            pos += lane->width;
+            tower = lane->next;
+            lane = &tower->lanes[l-1];
+        }
+
+        if(update != NULL) {
+            update[l-1] = tower;
+            update_pos[l-1] = pos;
+        }
+    }
+
+    *found_pos = pos;
+    return tower;
+}
+
+static void dlist_index_insert(dlist_t *list, size_t pos, dlist_node_t *node)
+{
+    struct dlist_index *index = list->index;
+
+    // stale indices get rebuilt anyways
+    if(index == NULL || index->stale) {
+        return;
+    }
+
+    // the new node is at this position in the index
+    size_t target = pos + 1;
+
+    // find the towers before the new node
+    dlist_index_tower_t *update[DLIST_INDEX_MAX_HEIGHT];
+    size_t update_pos[DLIST_INDEX_MAX_HEIGHT];
+    size_t found;
+    dlist_index_find(index, pos, &found, update, update_pos);
+
+    size_t height = dlist_index_height(index);
+    dlist_index_tower_t *tower = NULL;
+    if(height > 0) {
+        tower = dlist_index_tower_new(node, height);
+
+        if(tower == NULL) {
+            index->stale = true;
+            return;
+        }
+    }
+
+    // start using new lanes if the tower is higher than
+    // all others. before the insertion, they span the
+    // whole list.
+    for(size_t l = index->height; l < height; l++) {
+        index->head->lanes[l].next = NULL;
+        index->head->lanes[l].width = list->length;
+        update[l] = index->head;
+        update_pos[l] = 0;
+    }
+
+    if(height > index->height) {
+        index->height = height;
+    }
+
+    for(size_t l = 0; l < index->height; l++) {
+        struct dlist_index_lane *lane = &update[l]->lanes[l];
+
+        // the lane now spans one more element
+        lane->width++;
+
+        // link the new tower into the lane
+        if(l < height) {
+            tower->lanes[l].next = lane->next;
+            tower->lanes[l].width = (update_pos[l] + lane->width) - target;
+            lane->next = tower;
+            lane->width = target - update_pos[l];
+        }
+    }
+}
+
+static void dlist_index_insert_range(dlist_t *list, size_t pos, size_t count, dlist_node_t *node)
+{
+    struct dlist_index *index = list->index;
+
+    // stale indices get rebuilt anyways
+    if(index == NULL || index->stale) {
+        return;
+    }
+
+    // find the towers before the first new node
+    dlist_index_tower_t *update[DLIST_INDEX_MAX_HEIGHT];
+    size_t update_pos[DLIST_INDEX_MAX_HEIGHT];
+    size_t found;
+    dlist_index_find(index, pos, &found, update, update_pos);
+
+    // the lanes don't know about the new nodes yet
+    size_t length = list->length - count;
+
+    // insert the nodes one after the other, like
+    // dlist_index_insert() does. the towers before the
+    // next node are the ones before the last node, or
+    // its own tower, so they don't have to be searched.
+    for(size_t i = 0; i < count; i++, node = node->next) {
+        size_t target = pos + i + 1;
+        length++;
+
+        size_t height = dlist_index_height(index);
+        dlist_index_tower_t *tower = NULL;
+        if(height > 0) {
+            tower = dlist_index_tower_new(node, height);
+
+            if(tower == NULL) {
+                index->stale = true;
+                return;
+            }
+        }
+
+        // start using new lanes if the tower is higher
+        // than all others
+        for(size_t l = index->height; l < height; l++) {
+            index->head->lanes[l].next = NULL;
+            index->head->lanes[l].width = length;
+            update[l] = index->head;
+            update_pos[l] = 0;
+        }
+
+        if(height > index->height) {
+            index->height = height;
+        }
+
+        for(size_t l = 0; l < index->height; l++) {
+            struct dlist_index_lane *lane = &update[l]->lanes[l];
+
+            // the lane now spans one more element
+            lane->width++;
+
+            // link the new tower into the lane, the next
+            // node comes after it
+            if(l < height) {
+                tower->lanes[l].next = lane->next;
+                tower->lanes[l].width = (update_pos[l] + lane->width) - target;
+                lane->next = tower;
+                lane->width = target - update_pos[l];
+                update[l] = tower;
+                update_pos[l] = target;
+            }
+        }
+    }
+}
+
+static size_t dlist_index_height(struct dlist_index *index)
+{
+    // about every fourth node gets a tower, about every
+    // fourth tower gets a second lane and so on
+    uint32_t random = index->seed;
+    random ^= random << 13;
+    random ^= random >> 17;
+    random ^= random << 5;
+    index->seed = random;
+
+    size_t height = 0;
+    while((random & 3) == 0 && height < DLIST_INDEX_MAX_HEIGHT) {
+        height++;
+        random >>= 2;
+    }
+
+    return height;
+}
+
+static void dlist_index_remove(dlist_t *list, size_t pos, dlist_node_t *node)
+{
+    struct dlist_index *index = list->index;
+
+    // stale indices get rebuilt anyways
+    if(index == NULL || index->stale) {
+        return;
+    }
+
+    // find the towers before the node
+    dlist_index_tower_t *update[DLIST_INDEX_MAX_HEIGHT];
+    size_t update_pos[DLIST_INDEX_MAX_HEIGHT];
+    size_t found;
+    dlist_index_find(index, pos, &found, update, update_pos);
+
+    dlist_index_tower_t *tower = NULL;
+
+    for(size_t l = 0; l < index->height; l++) {
+        struct dlist_index_lane *lane = &update[l]->lanes[l];
+
+        if(lane->next != NULL && lane->next->node == node) {
+            // the node has a tower, unlink it
+            tower = lane->next;
+            lane->width += tower->lanes[l].width - 1;
+            lane->next = tower->lanes[l].next;
+        } else {
+            // the lane spans one less element
+            lane->width--;
+        }
+    }
+
+    free(tower);
+
+    // stop using lanes that became empty
+    while(index->height > 1 && index->head->lanes[index->height-1].next == NULL) {
+        index->height--;
+    }
+}
+
+static void dlist_index_remove_range(dlist_t *list, size_t pos, size_t count)
+{
+    struct dlist_index *index = list->index;
+
+    // stale indices get rebuilt anyways
+    if(index == NULL || index->stale) {
+        return;
+    }
+
+    // find the towers before the range
+    dlist_index_tower_t *update[DLIST_INDEX_MAX_HEIGHT];
+    size_t update_pos[DLIST_INDEX_MAX_HEIGHT];
+    size_t found;
+    dlist_index_find(index, pos, &found, update, update_pos);
+
+    // the range covers these positions in the index
+    size_t last = pos + count;
+
+    // unlink the towers in the range from every lane,
+    // from the top down, so that they are only freed
+    // once the bottom lane (which all of them have) is
+    // done with them
+    for(size_t l = index->height; l > 0; l--) {
+        struct dlist_index_lane *lane = &update[l-1]->lanes[l-1];
+        size_t next_pos = update_pos[l-1] + lane->width;
+
+        while(lane->next != NULL && next_pos <= last) {
+            dlist_index_tower_t *tower = lane->next;
+            next_pos += tower->lanes[l-1].width;
+            lane->width += tower->lanes[l-1].width;
+            lane->next = tower->lanes[l-1].next;
+
+            if(l == 1) {
+                free(tower);
+            }
+        }
+
+        // the lane spans count less elements
+        lane->width -= count;
+    }
+
+    // stop using lanes that became empty
+    while(index->height > 1 && index->head->lanes[index->height-1].next == NULL) {
+        index->height--;
+    }
+}
+
+static void dlist_index_swap(dlist_t *list, size_t a, size_t b, dlist_node_t *node_a, dlist_node_t *node_b)
+{
+    struct dlist_index *index = list->index;
+
+    // stale indices get rebuilt anyways
+    if(index == NULL || index->stale) {
+        return;
+    }
+
+    // the towers stay where they are, but the nodes
+    // they belong to have changed places
+    size_t found;
+    dlist_index_tower_t *tower = dlist_index_find(index, a + 1, &found, NULL, NULL);
+    if(tower != index->head && found == (a + 1)) {
+        assert(tower->node == node_a);
+        tower->node = node_b;
+    }
+
+    tower = dlist_index_find(index, b + 1, &found, NULL, NULL);
+    if(tower != index->head && found == (b + 1)) {
+        assert(tower->node == node_b);
+        tower->node = node_a;
+    }
+}
+
+static void dlist_index_replace(dlist_t *list, size_t pos, size_t count, dlist_node_t *node)
+{
+    struct dlist_index *index = list->index;
+
+    // stale indices get rebuilt anyways
+    if(index == NULL || index->stale) {
+        return;
+    }
+
+    // find the first tower in the range, positions in
+    // the index start at 1
+    size_t found;
+    dlist_index_tower_t *tower = dlist_index_find(index, pos + 1, &found, NULL, NULL);
+    if(found < (pos + 1)) {
+        found += tower->lanes[0].width;
+        tower = tower->lanes[0].next;
+    }
+
+    // walk the towers and the nodes side by side
+    size_t at = pos + 1;
+    while(tower != NULL && found < (pos + 1 + count)) {
+        while(at < found) {
+            node = node->next;
+            at++;
+        }
+
+        tower->node = node;
+        found += tower->lanes[0].width;
+        tower = tower->lanes[0].next;
+    }
+}
+
+static int dlist_index_verify(const dlist_t *list)
+{
+    struct dlist_index *index = list->index;
+
+    if(index->height == 0 || index->height > DLIST_INDEX_MAX_HEIGHT) {
+        return -20;
+    }
+
+    // every tower on the lowest lane must be at the
+    // position its width says it is
+    dlist_node_t *node = list->head;
+    size_t pos = 1;
+    size_t tower_pos = 0;
+    for(dlist_index_tower_t *tower = index->head; tower != NULL; tower = tower->lanes[0].next) {
+        tower_pos += tower->lanes[0].width;
+
+        if(tower->lanes[0].next == NULL) {
+            break;
+        }
+
+        while(node != NULL && pos < tower_pos) {
+            node = node->next;
+            pos++;
+        }
+
+        if(node == NULL || node != tower->lanes[0].next->node) {
+            return -21;
+        }
+    }
+
+    if(tower_pos != (list->length + 1)) {
+        return -22;
+    }
+
+    // every tower on a higher lane must be on the lane
+    // below it at the same position
+    for(size_t l = 1; l < index->height; l++) {
+        dlist_index_tower_t *below = index->head;
+        size_t below_pos = 0;
+        pos = 0;
+
+        for(dlist_index_tower_t *tower = index->head; tower != NULL; tower = tower->lanes[l].next) {
+            if(tower->height <= l) {
+                return -23;
+            }
+
+            pos += tower->lanes[l].width;
+
+            if(tower->lanes[l].next == NULL) {
+                break;
+            }
+
+            while(below != NULL && below_pos < pos) {
+                below_pos += below->lanes[l-1].width;
+                below = below->lanes[l-1].next;
+            }
+
+            if(below != tower->lanes[l].next || below_pos != pos) {
+                return -24;
+            }
+        }
+
+        if(pos != (list->length + 1)) {
+            return -25;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,141 @@
+/*  File: locality.c
+ *
+ *  Copyright (C) 2011, Patrick M. Elsen
+ *
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *  Author: Patrick M. Elsen <pelsen.vn (a) gmail.com>
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "clists/locality.h"
+#include <stdint.h>
+#include <string.h>
+#include <unistd.h>
+
+// page size to use if the system doesn't tell us
+#define locality_default_page_size 4096
+
+// get the node after node
+#define locality_next(node, offset) \
+    (*((const void *const *) (((const char *) (node)) + (offset))))
+
+// compare two size_t values, for qsort()
+static int locality_compare(const void *a, const void *b);
+
+// get the value at the given percentile of a sorted array
+static size_t locality_percentile(const size_t *sorted, size_t count, size_t percent);
+
+int locality_measure(locality_stats_t *stats, const void *first, size_t next_offset, size_t count)
+{
+    if(stats == NULL) {
+        return -1;
+    }
+
+    memset(stats, 0, sizeof(locality_stats_t));
+
+    long page_size = sysconf(_SC_PAGESIZE);
+    stats->page_size = (page_size > 0) ? (size_t) page_size : locality_default_page_size;
+
+    if(first == NULL) {
+        return 0;
+    }
+
+    // one entry per node, used for the distances first
+    // and for the pages after that
+    size_t *values = malloc(count * sizeof(size_t));
+
+    if(values == NULL) {
+        return -1;
+    }
+
+    double total = 0;
+    size_t crossings = 0;
+    const void *node = first;
+
+    for(const void *next = locality_next(node, next_offset); next != NULL; node = next, next = locality_next(node, next_offset)) {
+        // the chain can't be longer than promised
+        if((stats->steps + 1) >= count) {
+            free(values);
+            return -1;
+        }
+
+        uintptr_t a = (uintptr_t) node;
+        uintptr_t b = (uintptr_t) next;
+        size_t distance = (a > b) ? (a - b) : (b - a);
+
+        values[stats->steps] = distance;
+        total += distance;
+
+        if((a / stats->page_size) != (b / stats->page_size)) {
+            crossings++;
+        }
+
+        stats->steps++;
+    }
+
+    stats->nodes = stats->steps + 1;
+
+    if(stats->steps > 0) {
+        qsort(values, stats->steps, sizeof(size_t), locality_compare);
+
+        stats->mean_distance = total / stats->steps;
+        stats->p50_distance = locality_percentile(values, stats->steps, 50);
+        stats->p90_distance = locality_percentile(values, stats->steps, 90);
+        stats->p99_distance = locality_percentile(values, stats->steps, 99);
+        stats->max_distance = values[stats->steps - 1];
+        stats->page_cross_fraction = (double) crossings / stats->steps;
+    }
+
+    // count distinct pages by sorting them
+    size_t i = 0;
+    for(node = first; node != NULL; node = locality_next(node, next_offset), i++) {
+        values[i] = ((uintptr_t) node) / stats->page_size;
+    }
+
+    qsort(values, stats->nodes, sizeof(size_t), locality_compare);
+
+    for(i = 0; i < stats->nodes; i++) {
+        if(i == 0 || values[i] != values[i - 1]) {
+            stats->pages++;
+        }
+    }
+
+    free(values);
+
+    return 0;
+}
+
+static int locality_compare(const void *a, const void *b)
+{
+    size_t x = *((const size_t *) a);
+    size_t y = *((const size_t *) b);
+
+    return (x > y) - (x < y);
+}
+
+static size_t locality_percentile(const size_t *sorted, size_t count, size_t percent)
+{
+    // nearest rank method
+    size_t rank = ((count * percent) + 99) / 100;
+
+    if(rank == 0) {
+        rank = 1;
+    }
+
+    return sorted[rank - 1];
+}
@@ -0,0 +1,336 @@
+/*  File: nodecache.c
+ *
+ *  Copyright (C) 2011, Patrick M. Elsen
+ *
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *  Author: Patrick M. Elsen <pelsen.vn (a) gmail.com>
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "clists/nodecache.h"
+#include <assert.h>
+#include <pthread.h>
+
+// how many size classes there are
+#define nodecache_classes (NODECACHE_MAX_SIZE / NODECACHE_GRANULARITY)
+
+// size class (index into the per-class arrays) of an object
+#define nodecache_class(size) \
+    ((((size) + NODECACHE_GRANULARITY - 1) / NODECACHE_GRANULARITY) - 1)
+
+// how many bytes objects of a size class have
+#define nodecache_class_size(class) \
+    (((class) + 1) * NODECACHE_GRANULARITY)
+
+/* A magazine is a stack of free objects of the same
+ * size class. Magazines in the depot are kept in
+ * linked lists. */
+struct nodecache_magazine {
+    struct nodecache_magazine *next;
+    size_t count;
+    void *objects[NODECACHE_MAGAZINE_SIZE];
+};
+
+typedef struct nodecache_magazine nodecache_magazine_t;
+
+/* The depot holds magazines that are not currently
+ * used by any thread. Only the depot needs a lock. */
+struct nodecache_depot {
+    pthread_mutex_t lock;
+    nodecache_magazine_t *full;
+    nodecache_magazine_t *empty;
+};
+
+/* Every thread has two magazines per size class: it
+ * allocates from and frees to the loaded one, and only
+ * goes to the depot if both are empty (or full). */
+struct nodecache_local {
+    nodecache_magazine_t *loaded[nodecache_classes];
+    nodecache_magazine_t *previous[nodecache_classes];
+    int registered;
+};
+
+// whether the cache is enabled
+static int nodecache_on = 0;
+
+// shared depots, one per size class
+static struct nodecache_depot nodecache_depots[nodecache_classes];
+
+// magazines of the current thread
+static __thread struct nodecache_local nodecache_local;
+
+// used to flush magazines when a thread exits
+static pthread_key_t nodecache_key;
+static pthread_once_t nodecache_once = PTHREAD_ONCE_INIT;
+
+// initialize depots and thread exit handler
+static void nodecache_setup(void);
+
+// called when a thread that used the cache exits
+static void nodecache_thread_exit(void *unused);
+
+// make sure the current thread flushes its magazines
+// when it exits
+static void nodecache_register(void);
+
+// exchange magazines with the depot
+static nodecache_magazine_t *nodecache_depot_get(size_t class, int full);
+static void nodecache_depot_put(size_t class, nodecache_magazine_t *magazine);
+
+void nodecache_enable(void)
+{
+    pthread_once(&nodecache_once, nodecache_setup);
+    __atomic_store_n(&nodecache_on, 1, __ATOMIC_RELEASE);
+}
+
+void nodecache_disable(void)
+{
+    __atomic_store_n(&nodecache_on, 0, __ATOMIC_RELEASE);
+}
+
+bool nodecache_enabled(void)
+{
+    return __atomic_load_n(&nodecache_on, __ATOMIC_ACQUIRE) != 0;
+}
+
+void *nodecache_alloc(size_t size)
+{
+    // large objects are not cached
+    if(size > NODECACHE_MAX_SIZE) {
+        return malloc(size);
+    }
+
+    if(size == 0) {
+        size = 1;
+    }
+
+    size_t class = nodecache_class(size);
+
+    // objects are always allocated with the size of their
+    // class, so they can be cached later on even if the
+    // cache is disabled right now
+    if(!nodecache_enabled()) {
+        return malloc(nodecache_class_size(class));
+    }
+
+    struct nodecache_local *local = &nodecache_local;
+    nodecache_magazine_t *loaded = local->loaded[class];
+
+    // fast path: take an object from the loaded magazine
+    if(loaded != NULL && loaded->count > 0) {
+        return loaded->objects[--loaded->count];
+    }
+
+    // if the previous magazine has objects, swap them
+    nodecache_magazine_t *previous = local->previous[class];
+    if(previous != NULL && previous->count > 0) {
+        local->previous[class] = loaded;
+        local->loaded[class] = previous;
+        return previous->objects[--previous->count];
+    }
+
+    // both are empty, get a full one from the depot
+    nodecache_magazine_t *full = nodecache_depot_get(class, 1);
+    if(full == NULL) {
+        return malloc(nodecache_class_size(class));
+    }
+
+    if(previous != NULL) {
+        nodecache_depot_put(class, previous);
+    }
+
+    nodecache_register();
+    local->previous[class] = loaded;
+    local->loaded[class] = full;
+
+    assert(full->count > 0);
+    return full->objects[--full->count];
+}
+
+void nodecache_free(void *ptr, size_t size)
+{
+    // large objects are not cached
+    if(size > NODECACHE_MAX_SIZE || !nodecache_enabled()) {
+        free(ptr);
+        return;
+    }
+
+    if(size == 0) {
+        size = 1;
+    }
+
+    size_t class = nodecache_class(size);
+    struct nodecache_local *local = &nodecache_local;
+    nodecache_magazine_t *loaded = local->loaded[class];
+
+    // fast path: put the object into the loaded magazine
+    if(loaded != NULL && loaded->count < NODECACHE_MAGAZINE_SIZE) {
+        loaded->objects[loaded->count++] = ptr;
+        return;
+    }
+
+    // if the previous magazine has space, swap them
+    nodecache_magazine_t *previous = local->previous[class];
+    if(previous != NULL && previous->count < NODECACHE_MAGAZINE_SIZE) {
+        local->previous[class] = loaded;
+        local->loaded[class] = previous;
+        previous->objects[previous->count++] = ptr;
+        return;
+    }
+
+    // both are full, get an empty one from the depot
+    // or make a new one
+    nodecache_magazine_t *empty = nodecache_depot_get(class, 0);
+    if(empty == NULL) {
+        empty = malloc(sizeof(nodecache_magazine_t));
+
+        if(empty == NULL) {
+            free(ptr);
+            return;
+        }
+
+        empty->next = NULL;
+        empty->count = 0;
+    }
+
+    if(previous != NULL) {
+        nodecache_depot_put(class, previous);
+    }
+
+    nodecache_register();
+    local->previous[class] = loaded;
+    local->loaded[class] = empty;
+
+    empty->objects[empty->count++] = ptr;
+}
+
+void nodecache_flush(void)
+{
+    struct nodecache_local *local = &nodecache_local;
+
+    for(size_t class = 0; class < nodecache_classes; class++) {
+        if(local->loaded[class] != NULL) {
+            nodecache_depot_put(class, local->loaded[class]);
+            local->loaded[class] = NULL;
+        }
+
+        if(local->previous[class] != NULL) {
+            nodecache_depot_put(class, local->previous[class]);
+            local->previous[class] = NULL;
+        }
+    }
+}
+
+void nodecache_trim(void)
+{
+    pthread_once(&nodecache_once, nodecache_setup);
+
+    for(size_t class = 0; class < nodecache_classes; class++) {
+        struct nodecache_depot *depot = &nodecache_depots[class];
+
+        // take all magazines out of the depot
+        pthread_mutex_lock(&depot->lock);
+        nodecache_magazine_t *full = depot->full;
+        nodecache_magazine_t *empty = depot->empty;
+        depot->full = NULL;
+        depot->empty = NULL;
+        pthread_mutex_unlock(&depot->lock);
+
+        // and free them along with all objects
+        while(full != NULL) {
+            nodecache_magazine_t *next = full->next;
+
+            for(size_t i = 0; i < full->count; i++) {
+                free(full->objects[i]);
+            }
+
+            free(full);
+            full = next;
+        }
+
+        while(empty != NULL) {
+            nodecache_magazine_t *next = empty->next;
+            free(empty);
+            empty = next;
+        }
+    }
+}
+
+static void nodecache_setup(void)
+{
+    for(size_t class = 0; class < nodecache_classes; class++) {
+        pthread_mutex_init(&nodecache_depots[class].lock, NULL);
+        nodecache_depots[class].full = NULL;
+        nodecache_depots[class].empty = NULL;
+    }
+
+    pthread_key_create(&nodecache_key, nodecache_thread_exit);
+}
+
+static void nodecache_thread_exit(void *unused)
+{
+    (void) unused;
+    nodecache_flush();
+}
+
+static void nodecache_register(void)
+{
+    if(!nodecache_local.registered) {
+        pthread_once(&nodecache_once, nodecache_setup);
+        pthread_setspecific(nodecache_key, &nodecache_local);
+        nodecache_local.registered = 1;
+    }
+}
+
+static nodecache_magazine_t *nodecache_depot_get(size_t class, int full)
+{
+    struct nodecache_depot *depot = &nodecache_depots[class];
+
+    pthread_mutex_lock(&depot->lock);
+
+    nodecache_magazine_t **stack = full ? &depot->full : &depot->empty;
+    nodecache_magazine_t *magazine = *stack;
+
+    if(magazine != NULL) {
+        *stack = magazine->next;
+        magazine->next = NULL;
+    }
+
+    pthread_mutex_unlock(&depot->lock);
+
+    return magazine;
+}
+
+static void nodecache_depot_put(size_t class, nodecache_magazine_t *magazine)
+{
+    struct nodecache_depot *depot = &nodecache_depots[class];
+
+    pthread_mutex_lock(&depot->lock);
+
+    // magazines with objects in them go to the full
+    // stack, even if they are only partially full
+    if(magazine->count > 0) {
+        magazine->next = depot->full;
+        depot->full = magazine;
+    } else {
+        magazine->next = depot->empty;
+        depot->empty = magazine;
+    }
+
+    pthread_mutex_unlock(&depot->lock);
+}
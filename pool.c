@@ -0,0 +1,489 @@
+/*  File: pool.c
+ *
+ *  Copyright (C) 2011, Patrick M. Elsen
+ *
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *  Author: Patrick M. Elsen <pelsen.vn (a) gmail.com>
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "clists/pool.h"
+#include <assert.h>
+
+// strictest alignment any object could need, same as
+// what malloc() guarantees
+union pool_max_align {
+    long double ld;
+    long long ll;
+    void *ptr;
+    void (*fn)(void);
+};
+
+#define pool_align sizeof(union pool_max_align)
+
+// round size up to a multiple of pool_align
+#define pool_round(size) \
+    ((((size) + pool_align - 1) / pool_align) * pool_align)
+
+// how many bytes a slab should have if the user
+// does not specify how many objects it should hold
+#define pool_default_slab_bytes 16384
+
+// offset of the object storage in a slab allocation
+#define pool_slab_header pool_round(sizeof(pool_slab_t))
+
+// get the root pool (the one that owns the slabs)
+static pool_t *pool_root(const pool_t *pool);
+
+// find the slab ptr belongs to, and its index in
+// pool->slabs, or NULL
+static pool_slab_t *pool_slab_find(const pool_t *pool, const void *ptr, size_t *index);
+
+// allocate a new slab and add it to the pool
+static pool_slab_t *pool_slab_add(pool_t *pool, size_t count);
+
+// remove a slab from the pool and free it
+static void pool_slab_remove(pool_t *pool, pool_slab_t *slab);
+
+// link/unlink slabs from the list of partial slabs
+static void pool_partial_push(pool_t *pool, pool_slab_t *slab);
+static void pool_partial_unlink(pool_t *pool, pool_slab_t *slab);
+
+pool_t *pool_new(size_t size, size_t per_slab)
+{
+    // allocate memory for new pool
+    pool_t *pool = malloc(sizeof(pool_t));
+
+    // check if memory allocation worked
+    if(pool == NULL) {
+        return NULL;
+    }
+
+    // initialize memory
+    memset(pool, 0, sizeof(pool_t));
+
+    // objects need to be able to hold the free
+    // list pointer, and need to be aligned
+    if(size < sizeof(void*)) {
+        size = sizeof(void*);
+    }
+
+    pool->size = pool_round(size);
+
+    // pick a sensible default slab size
+    if(per_slab == 0) {
+        per_slab = pool_default_slab_bytes / pool->size;
+
+        if(per_slab < 8) {
+            per_slab = 8;
+        }
+    }
+
+    pool->per_slab = per_slab;
+    pool->refs = 1;
+
+    return pool;
+}
+
+pool_t *pool_ref(pool_t *pool)
+{
+    if(pool != NULL) {
+        pool->refs++;
+    }
+
+    return pool;
+}
+
+int pool_free(pool_t *pool)
+{
+    // can't free a NULL pointer
+    if(pool == NULL) {
+        return -1;
+    }
+
+    assert(pool->refs > 0);
+    pool->refs--;
+
+    // someone is still using this pool
+    if(pool->refs > 0) {
+        return 0;
+    }
+
+    // merged pools don't own anything, but they
+    // hold a reference to the pool they were
+    // merged into
+    if(pool->parent != NULL) {
+        pool_t *parent = pool->parent;
+        free(pool);
+        return pool_free(parent);
+    }
+
+    // free all slabs
+    for(size_t i = 0; i < pool->slabs_count; i++) {
+        free(pool->slabs[i]);
+    }
+
+    free(pool->slabs);
+    free(pool);
+
+    return 0;
+}
+
+void *pool_get(pool_t *pool)
+{
+    pool = pool_root(pool);
+
+    // take the first slab that has space, or make
+    // a new one if there is none
+    pool_slab_t *slab = pool->partial;
+
+    if(slab == NULL) {
+        slab = pool_slab_add(pool, pool->per_slab);
+
+        // make sure allocation worked
+        if(slab == NULL) {
+            return NULL;
+        }
+    }
+
+    assert(slab->used < slab->count);
+
+    // prefer recycled objects, otherwise carve out
+    // a fresh one
+    void *ptr;
+    if(slab->free != NULL) {
+        ptr = slab->free;
+        slab->free = *((void**)ptr);
+    } else {
+        assert(slab->fresh < slab->count);
+        ptr = slab->base + (slab->fresh * pool->size);
+        slab->fresh++;
+    }
+
+    slab->used++;
+
+    // the spare slab is not empty anymore
+    if(slab == pool->spare) {
+        pool->spare = NULL;
+    }
+
+    // a full slab can't hand out objects anymore
+    if(slab->used == slab->count) {
+        pool_partial_unlink(pool, slab);
+    }
+
+    return ptr;
+}
+
+int pool_reserve(pool_t *pool, size_t count)
+{
+    pool = pool_root(pool);
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    // pool_get() takes objects from the front of the
+    // partial list first. if that slab has never handed
+    // out the rest of its objects, they are next to each
+    // other already
+    pool_slab_t *slab = pool->partial;
+    if(slab != NULL && slab->free == NULL && (slab->count - slab->fresh) >= count) {
+        return 0;
+    }
+
+    // an unused spare slab that is large enough just
+    // needs to be moved to the front
+    slab = pool->spare;
+    if(slab != NULL && slab->count >= count) {
+        pool_partial_unlink(pool, slab);
+        pool_partial_push(pool, slab);
+        return 0;
+    }
+
+    // otherwise, add a new slab (which goes to the front
+    // of the partial list). round it up to a multiple of
+    // the slab size, so that lots of small reservations
+    // don't leave lots of tiny slabs behind, which would
+    // make looking up slabs slower
+    size_t slabs = (count + pool->per_slab - 1) / pool->per_slab;
+    if(pool_slab_add(pool, slabs * pool->per_slab) == NULL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+int pool_put(pool_t *pool, void *ptr)
+{
+    pool = pool_root(pool);
+
+    // find out which slab this object belongs to
+    pool_slab_t *slab = pool_slab_find(pool, ptr, NULL);
+
+    // not one of ours
+    if(slab == NULL) {
+        return -1;
+    }
+
+    assert(slab->used > 0);
+
+    // a full slab has space again
+    if(slab->used == slab->count) {
+        pool_partial_push(pool, slab);
+    }
+
+    // add object to the free list of the slab
+    *((void**)ptr) = slab->free;
+    slab->free = ptr;
+    slab->used--;
+
+    // if the slab is now unused, reset it so that
+    // future objects are handed out in address order.
+    // keep one empty slab around so that push/pop
+    // cycles don't allocate, and free any others.
+    if(slab->used == 0) {
+        slab->free = NULL;
+        slab->fresh = 0;
+
+        if(pool->spare == NULL) {
+            pool->spare = slab;
+        } else if(pool->spare != slab) {
+            pool_slab_remove(pool, slab);
+        }
+    }
+
+    return 0;
+}
+
+bool pool_owns(const pool_t *pool, const void *ptr)
+{
+    return pool_slab_find(pool_root(pool), ptr, NULL) != NULL;
+}
+
+pool_t *pool_merge(pool_t *dest, pool_t *src)
+{
+    pool_t *root_dest = pool_root(dest);
+    pool_t *root_src = pool_root(src);
+
+    // already merged
+    if(root_dest == root_src) {
+        return dest;
+    }
+
+    // objects must be interchangeable
+    if(root_dest->size != root_src->size) {
+        return NULL;
+    }
+
+    // make sure there is enough space for all slab
+    // pointers in dest
+    size_t count = root_dest->slabs_count + root_src->slabs_count;
+    if(count > root_dest->slabs_alloc) {
+        pool_slab_t **slabs = realloc(root_dest->slabs, count * sizeof(pool_slab_t*));
+
+        if(slabs == NULL) {
+            return NULL;
+        }
+
+        root_dest->slabs = slabs;
+        root_dest->slabs_alloc = count;
+    }
+
+    // merge both sorted arrays of slabs, starting
+    // from the back so we can do it in place
+    size_t i = root_dest->slabs_count;
+    size_t j = root_src->slabs_count;
+    size_t k = count;
+    while(j > 0) {
+        if(i > 0 && root_dest->slabs[i-1]->base > root_src->slabs[j-1]->base) {
+            root_dest->slabs[--k] = root_dest->slabs[--i];
+        } else {
+            root_dest->slabs[--k] = root_src->slabs[--j];
+        }
+    }
+
+    root_dest->slabs_count = count;
+
+    // move partial slabs over
+    while(root_src->partial != NULL) {
+        pool_slab_t *slab = root_src->partial;
+        pool_partial_unlink(root_src, slab);
+        pool_partial_push(root_dest, slab);
+    }
+
+    if(root_dest->spare == NULL) {
+        root_dest->spare = root_src->spare;
+    }
+
+    // src doesn't own anything anymore, it just
+    // forwards to dest now
+    free(root_src->slabs);
+    root_src->slabs = NULL;
+    root_src->slabs_count = 0;
+    root_src->slabs_alloc = 0;
+    root_src->spare = NULL;
+    root_src->parent = pool_ref(root_dest);
+
+    return dest;
+}
+
+static pool_t *pool_root(const pool_t *pool)
+{
+    while(pool->parent != NULL) {
+        pool = pool->parent;
+    }
+
+    return (pool_t*) pool;
+}
+
+static pool_slab_t *pool_slab_find(const pool_t *pool, const void *ptr, size_t *index)
+{
+    const char *p = ptr;
+
+    // binary search for the last slab that starts
+    // at or before ptr
+    size_t lo = 0;
+    size_t hi = pool->slabs_count;
+    while(lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+
+        if(pool->slabs[mid]->base <= p) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+
+    // every slab starts after ptr
+    if(lo == 0) {
+        return NULL;
+    }
+
+    pool_slab_t *slab = pool->slabs[lo-1];
+
+    // ptr must be within the slab
+    if(p >= (slab->base + slab->count * pool->size)) {
+        return NULL;
+    }
+
+    assert(((size_t)(p - slab->base) % pool->size) == 0);
+
+    if(index != NULL) {
+        *index = lo - 1;
+    }
+
+    return slab;
+}
+
+static pool_slab_t *pool_slab_add(pool_t *pool, size_t count)
+{
+    // make sure there is space for another slab
+    // pointer
+    if(pool->slabs_count == pool->slabs_alloc) {
+        size_t alloc = (pool->slabs_alloc == 0) ? 4 : (pool->slabs_alloc * 2);
+        pool_slab_t **slabs = realloc(pool->slabs, alloc * sizeof(pool_slab_t*));
+
+        if(slabs == NULL) {
+            return NULL;
+        }
+
+        pool->slabs = slabs;
+        pool->slabs_alloc = alloc;
+    }
+
+    // slab header and storage are one allocation
+    pool_slab_t *slab = malloc(pool_slab_header + (count * pool->size));
+
+    if(slab == NULL) {
+        return NULL;
+    }
+
+    memset(slab, 0, sizeof(pool_slab_t));
+    slab->base = ((char*) slab) + pool_slab_header;
+    slab->count = count;
+
+    // insert into sorted slab array
+    size_t pos = pool->slabs_count;
+    while(pos > 0 && pool->slabs[pos-1]->base > slab->base) {
+        pool->slabs[pos] = pool->slabs[pos-1];
+        pos--;
+    }
+
+    pool->slabs[pos] = slab;
+    pool->slabs_count++;
+
+    pool_partial_push(pool, slab);
+
+    return slab;
+}
+
+static void pool_slab_remove(pool_t *pool, pool_slab_t *slab)
+{
+    size_t index;
+    pool_slab_t *found = pool_slab_find(pool, slab->base, &index);
+    assert(found == slab);
+    (void) found;
+
+    // only slabs with available objects are in
+    // the partial list
+    if(slab->used < slab->count) {
+        pool_partial_unlink(pool, slab);
+    }
+
+    // remove from slab array
+    memmove(&pool->slabs[index], &pool->slabs[index+1],
+            (pool->slabs_count - index - 1) * sizeof(pool_slab_t*));
+    pool->slabs_count--;
+
+    if(pool->spare == slab) {
+        pool->spare = NULL;
+    }
+
+    free(slab);
+}
+
+static void pool_partial_push(pool_t *pool, pool_slab_t *slab)
+{
+    slab->prev = NULL;
+    slab->next = pool->partial;
+
+    if(pool->partial != NULL) {
+        pool->partial->prev = slab;
+    }
+
+    pool->partial = slab;
+}
+
+static void pool_partial_unlink(pool_t *pool, pool_slab_t *slab)
+{
+    if(slab->prev != NULL) {
+        slab->prev->next = slab->next;
+    } else {
+        assert(pool->partial == slab);
+        pool->partial = slab->next;
+    }
+
+    if(slab->next != NULL) {
+        slab->next->prev = slab->prev;
+    }
+
+    slab->next = NULL;
+    slab->prev = NULL;
+}
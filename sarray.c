@@ -48,6 +48,11 @@
 #define sarray_bitfield_offset(index, size) \
     (index * sarray_cluster_size(size))
 
+#define sarray_data_size(size, capacity) \
+    ((sarray_bitfield_count(capacity) + \
+      (capacity * sarray_element_size(size))) * \
+     sarray_word_size)
+
 inline size_t sarray_popcount(sarray_word w) {
     size_t result = 0;
     while(w > 0) {
@@ -85,16 +90,30 @@ void *sarray_last(const sarray_t *array);
 /* CREATION/DESTRUCTION FUNCTIONS */
 
 sarray_t *sarray_new(size_t size, size_t capacity) {
-    sarray_t *array = malloc(sizeof(sarray_t));
+    return sarray_new_allocator(size, capacity, NULL);
+}
+
+sarray_t *sarray_init(sarray_t *array, size_t size, size_t capacity) {
+    return sarray_init_allocator(array, size, capacity, NULL);
+}
+
+sarray_t *sarray_new_allocator(size_t size, size_t capacity, const allocator_t *allocator) {
+    sarray_t *array = allocator_alloc(allocator, sizeof(sarray_t));
 
     if(array == NULL) {
         return NULL;
     }
 
-    return sarray_init(array, size, capacity);
+    if(sarray_init_allocator(array, size, capacity, allocator) == NULL) {
+        allocator_free(allocator, array, sizeof(sarray_t));
+        return NULL;
+    }
+
+    return array;
 }
 
-sarray_t *sarray_init(sarray_t *array, size_t size, size_t capacity) {
+sarray_t *sarray_init_allocator(sarray_t *array, size_t size, size_t capacity, const allocator_t *allocator) {
+    array->allocator = allocator;
     array->size = size;
     array->capacity = capacity;
 
@@ -103,13 +122,7 @@ sarray_t *sarray_init(sarray_t *array, size_t size, size_t capacity) {
         return array;
     }
 
-    size_t bitfields = (capacity + (sarray_word_size * CHAR_BIT) - 1) /
-                       (sarray_word_size * CHAR_BIT);
-    size_t element_size = (size + sarray_word_size - 1) /
-                          sarray_word_size;
-    size_t total_size = bitfields + (capacity * element_size);
-
-    array->data = malloc(total_size * sarray_word_size);
+    array->data = allocator_alloc(allocator, sarray_data_size(size, capacity));
 
     if(array->data == NULL) {
         array->size = 0;
@@ -124,10 +137,10 @@ sarray_t *sarray_purge(sarray_t *array);
 
 int sarray_free (sarray_t *array) {
     if(array->data != NULL) {
-        free(array->data);
+        allocator_free(array->allocator, array->data, sarray_data_size(array->size, array->capacity));
     }
 
-    free(array);
+    allocator_free(array->allocator, array, sizeof(sarray_t));
 
     return 0;
 }
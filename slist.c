@@ -23,10 +23,23 @@
  */
 
 #include "clists/slist.h"
+#include "clists/nodecache.h"
 #include <assert.h>
+#include <stddef.h>
+#include <stdint.h>
 
-// allocate new node with given size
-#define malloc_node(size) malloc(sizeof(slist_node_t) + (size))
+// allocate a new node for the list
+static slist_node_t *slist_node_alloc(slist_t *list);
+
+// release a node that belonged to the list
+static void slist_node_free(slist_t *list, slist_node_t *node);
+
+// create a new list that allocates nodes the same
+// way as the given list
+static slist_t *slist_new_like(const slist_t *list);
+
+// make sure nodes of src can be released by dest
+static int slist_adopt(slist_t *dest, const slist_t *src);
 
 // swap two variables
 #define swap(x,y) do {   \
@@ -42,8 +55,48 @@
     __typeof__ (b) _b = (b); \
     _a > _b ? _a : _b; })
 
+// copy an element of size bytes from src to dest
+static inline void slist_data_copy(void *dest, const void *src, size_t size);
+
 // get the node at pos, or NULL
-static slist_node_t *slist_node_get(const slist_t *list, size_t pos);
+static slist_node_t *slist_node_get(slist_t *list, size_t pos);
+
+// allocate a node and build its element with init,
+// returning NULL if either fails
+static slist_node_t *slist_node_new_with(slist_t *list, slist_init_element *init, void *ctx);
+
+// link node into list after prev (or at the front if
+// prev is NULL). the finger is not touched.
+static void slist_node_link(slist_t *list, slist_node_t *prev, slist_node_t *node);
+
+// release a chain of nodes that belonged to the list
+static void slist_node_free_chain(slist_t *list, slist_node_t *node);
+
+// allocate a chain of count nodes holding the elements
+// of data, storing the last one in last. returns the
+// first node, or NULL if allocation failed
+static slist_node_t *slist_node_chain(slist_t *list, const void *data, size_t count, slist_node_t **last);
+
+// cut the chain starting at node after count nodes,
+// returning the rest of the chain (or NULL)
+static slist_node_t *slist_node_cut(slist_node_t *node, size_t count);
+
+// read the unsigned integer key of width bytes at
+// offset in the element of node
+static uint64_t slist_node_key(const slist_node_t *node, size_t offset, size_t width);
+
+// radix sort takes this many bits of the key per
+// pass, and needs a bucket for every value of them
+#define SLIST_RADIX_BITS 8
+#define SLIST_RADIX_BUCKETS (1 << SLIST_RADIX_BITS)
+
+// forget the node remembered by slist_node_get()
+#define slist_finger_reset(list) ((list)->finger = NULL)
+
+// the finger is a cache that lookups update, even on
+// lists that are const to the caller. this gives them
+// a list they can update it through.
+#define slist_finger_owner(list) ((slist_t*) (list))
 
 size_t slist_size(const slist_t *list) {
     if(list != NULL) {
@@ -112,6 +165,103 @@ slist_t *slist_init(slist_t *list, size_t size)
     return list;
 }
 
+slist_t *slist_new_pooled(size_t size, size_t nodes_per_slab)
+{
+    // allocate memory for new list
+    slist_t *list = malloc(sizeof(slist_t));
+
+    // check if memory allocation worked
+    if(list == NULL) {
+        return NULL;
+    }
+
+    // initialize list
+    if(slist_init_pooled(list, size, nodes_per_slab) == NULL) {
+        free(list);
+        return NULL;
+    }
+
+    return list;
+}
+
+slist_t *slist_init_pooled(slist_t *list, size_t size, size_t nodes_per_slab)
+{
+    // initialize as usual
+    if(slist_init(list, size) == NULL) {
+        return NULL;
+    }
+
+    // create the pool the nodes are taken from
+    list->pool = pool_new(sizeof(slist_node_t) + size, nodes_per_slab);
+
+    // make sure that worked
+    if(list->pool == NULL) {
+        return NULL;
+    }
+
+    return list;
+}
+
+slist_t *slist_new_arena(size_t size, arena_t *arena)
+{
+    // make sure we have an arena
+    if(arena == NULL) {
+        return NULL;
+    }
+
+    // allocate memory for new list from the arena
+    slist_t *list = arena_alloc(arena, sizeof(slist_t));
+
+    // check if memory allocation worked
+    if(list == NULL) {
+        return NULL;
+    }
+
+    return slist_init_arena(list, size, arena);
+}
+
+slist_t *slist_init_arena(slist_t *list, size_t size, arena_t *arena)
+{
+    // make sure we have an arena
+    if(arena == NULL) {
+        return NULL;
+    }
+
+    // initialize as usual
+    if(slist_init(list, size) == NULL) {
+        return NULL;
+    }
+
+    list->arena = arena;
+
+    return list;
+}
+
+slist_t *slist_new_allocator(size_t size, const allocator_t *allocator)
+{
+    // allocate memory for new list with the allocator
+    slist_t *list = allocator_alloc(allocator, sizeof(slist_t));
+
+    // check if memory allocation worked
+    if(list == NULL) {
+        return NULL;
+    }
+
+    return slist_init_allocator(list, size, allocator);
+}
+
+slist_t *slist_init_allocator(slist_t *list, size_t size, const allocator_t *allocator)
+{
+    // initialize as usual
+    if(slist_init(list, size) == NULL) {
+        return NULL;
+    }
+
+    list->allocator = allocator;
+
+    return list;
+}
+
 slist_t *slist_purge(slist_t *list)
 {
     // start with the first node, pointed to
@@ -119,13 +269,20 @@ slist_t *slist_purge(slist_t *list)
     slist_node_t *cur = list->head;
     slist_node_t *next;
 
+    // nodes from an arena (or an allocator that can't
+    // free) don't need to be released, but pooled nodes
+    // go back to the pool so it can hand them out again
+    if(list->pool == NULL && (list->arena != NULL || (list->allocator != NULL && list->allocator->free == NULL))) {
+        cur = NULL;
+    }
+
     while (cur != NULL) {
         // remember which node was supposed to
         // come next so we can safely free cur
         next = cur->next;
 
         // free current node
-        free(cur);
+        slist_node_free(list, cur);
 
         // advance to next node
         cur = next;
@@ -135,6 +292,21 @@ slist_t *slist_purge(slist_t *list)
     list->head = NULL;
     list->tail = NULL;
     list->length = 0;
+    slist_finger_reset(list);
+
+    return list;
+}
+
+slist_t *slist_release(slist_t *list)
+{
+    // free nodes, putting pooled ones back
+    slist_purge(list);
+
+    // drop the reference to the pool, if any
+    if(list->pool != NULL) {
+        pool_free(list->pool);
+        list->pool = NULL;
+    }
 
     return list;
 }
@@ -145,11 +317,14 @@ int slist_free(slist_t *list)
     if(list == NULL)
         return -1;
 
-    // free nodes
-    slist_purge(list);
+    // free nodes and drop the pool
+    slist_release(list);
 
-    // free list itself
-    free(list);
+    // free list itself, unless it lives in an arena
+    // (or in memory owned by the user)
+    if(list->arena == NULL) {
+        allocator_free(list->allocator, list, sizeof(slist_t));
+    }
 
     return 0;
 }
@@ -163,12 +338,12 @@ void *slist_append(slist_t *list, const void *data)
     // check for that
     if (node != NULL) {
         // append to existing node
-        node->next = malloc_node(list->size);
+        node->next = slist_node_alloc(list);
         node = node->next;
     } else {
         // list is empty, so this is both the
         // first and the last node.
-        node = malloc_node(list->size);
+        node = slist_node_alloc(list);
         list->head = node;
     }
 
@@ -186,7 +361,7 @@ void *slist_append(slist_t *list, const void *data)
 
     // set the node's data
     if(data != NULL) {
-        memcpy(node->data, data, list->size);
+        slist_data_copy(node->data, data, list->size);
     }
 
     return node->data;
@@ -195,7 +370,7 @@ void *slist_append(slist_t *list, const void *data)
 void *slist_prepend(slist_t *list, const void *data)
 {
     // allocate memory for new node
-    slist_node_t *node = malloc_node(list->size);
+    slist_node_t *node = slist_node_alloc(list);
 
     // make sure malloc worked
     if(node == NULL) {
@@ -204,7 +379,7 @@ void *slist_prepend(slist_t *list, const void *data)
 
     // set node data (if some data was supplied)
     if(data != NULL) {
-        memcpy(node->data, data, list->size);
+        slist_data_copy(node->data, data, list->size);
     }
 
     // initialize node: set next to
@@ -224,6 +399,9 @@ void *slist_prepend(slist_t *list, const void *data)
     // update list size
     list->length++;
 
+    // everything moved back by one
+    list->finger_pos++;
+
     return node->data;
 }
 
@@ -252,7 +430,7 @@ void *slist_insert(slist_t *list, size_t pos, const void *data)
         assert(next != NULL);
         
         // allocate memeory for new node
-        slist_node_t *node = malloc_node(list->size);
+        slist_node_t *node = slist_node_alloc(list);
 
         // make sure allocation worked
         if(node == NULL) {
@@ -265,16 +443,117 @@ void *slist_insert(slist_t *list, size_t pos, const void *data)
 
         // set data and update list
         if(data != NULL) {
-            memcpy(node->data, data, list->size);
+            slist_data_copy(node->data, data, list->size);
         }
 
         // update list
         list->length++;
 
+        // the finger moved back by one if it was at
+        // or after pos
+        if(list->finger != NULL && list->finger_pos >= pos) {
+            list->finger_pos++;
+        }
+
         return node->data;
     }
 }
 
+void *slist_append_with(slist_t *list, slist_init_element *init, void *ctx)
+{
+    slist_node_t *node = slist_node_new_with(list, init, ctx);
+
+    if(node == NULL) {
+        return NULL;
+    }
+
+    slist_node_link(list, list->tail, node);
+
+    return node->data;
+}
+
+void *slist_prepend_with(slist_t *list, slist_init_element *init, void *ctx)
+{
+    slist_node_t *node = slist_node_new_with(list, init, ctx);
+
+    if(node == NULL) {
+        return NULL;
+    }
+
+    slist_node_link(list, NULL, node);
+
+    // everything moved back by one
+    list->finger_pos++;
+
+    return node->data;
+}
+
+void *slist_insert_with(slist_t *list, size_t pos, slist_init_element *init, void *ctx)
+{
+    // inserting at a non-valid position is not possible
+    if(pos > list->length) {
+        return NULL;
+    }
+
+    // find the node to insert after
+    slist_node_t *prev = (pos > 0) ? slist_node_get(list, pos - 1) : NULL;
+    slist_node_t *node = slist_node_new_with(list, init, ctx);
+
+    if(node == NULL) {
+        return NULL;
+    }
+
+    slist_node_link(list, prev, node);
+
+    // the finger moved back by one if it was at
+    // or after pos
+    if(list->finger != NULL && list->finger_pos >= pos) {
+        list->finger_pos++;
+    }
+
+    return node->data;
+}
+
+int slist_generate(slist_t *list, size_t count, slist_init_element *init, void *ctx)
+{
+    if(init == NULL) {
+        return -1;
+    }
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    // allocate all nodes before touching the list
+    slist_node_t *last;
+    slist_node_t *first = slist_node_chain(list, NULL, count, &last);
+
+    if(first == NULL) {
+        return -2;
+    }
+
+    // build the elements
+    for(slist_node_t *node = first; node != NULL; node = node->next) {
+        if(init(node->data, ctx) < 0) {
+            slist_node_free_chain(list, first);
+            return -3;
+        }
+    }
+
+    // append the chain
+    if(list->tail != NULL) {
+        list->tail->next = first;
+    } else {
+        list->head = first;
+    }
+
+    list->tail = last;
+    list->length += count;
+
+    return 0;
+}
+
 int slist_remove(slist_t *list, size_t pos)
 {
     if(list->length == 0) {
@@ -317,10 +596,18 @@ int slist_remove(slist_t *list, size_t pos)
         prev->next = node->next;
         
         // get rid of the node
-        free(node);
+        slist_node_free(list, node);
 
         // update the list
         list->length--;
+
+        // the finger is gone if it was the removed node,
+        // and moved forward by one if it was after it
+        if(list->finger == node) {
+            slist_finger_reset(list);
+        } else if(list->finger != NULL && list->finger_pos > pos) {
+            list->finger_pos--;
+        }
     }
 
     return 0;
@@ -337,7 +624,7 @@ void *slist_set(slist_t *list, size_t pos, const void *data)
     }
 
     // copy data over
-    memcpy(node->data, data, list->size);
+    slist_data_copy(node->data, data, list->size);
 
     return node->data;
 }
@@ -345,7 +632,7 @@ void *slist_set(slist_t *list, size_t pos, const void *data)
 void *slist_get(const slist_t *list, size_t pos, void *data)
 {
     // get node
-    slist_node_t *node = slist_node_get(list, pos);
+    slist_node_t *node = slist_node_get(slist_finger_owner(list), pos);
 
     // make sure node exists
     if(node == NULL) {
@@ -354,12 +641,168 @@ void *slist_get(const slist_t *list, size_t pos, void *data)
 
     // copy data over if pointer is non-NULL
     if(data != NULL) {
-        memcpy(data, node->data, list->size);
+        slist_data_copy(data, node->data, list->size);
     }
 
     return node->data;
 }
 
+void *slist_get_range(const slist_t *list, size_t pos, size_t count, void *out)
+{
+    // make sure the range exists
+    if(out == NULL || pos > list->length || count > (list->length - pos)) {
+        return NULL;
+    }
+
+    // nothing to do
+    if(count == 0) {
+        return out;
+    }
+
+    slist_t *owner = slist_finger_owner(list);
+    slist_node_t *node = slist_node_get(owner, pos);
+    slist_node_t *last = node;
+    char *dest = out;
+
+    for(size_t i = 0; i < count; i++, node = node->next) {
+        slist_data_copy(dest, node->data, list->size);
+        dest += list->size;
+        last = node;
+    }
+
+    // remember the last node, so reading the next
+    // range starts from there
+    owner->finger = last;
+    owner->finger_pos = pos + count - 1;
+
+    return out;
+}
+
+int slist_set_range(slist_t *list, size_t pos, size_t count, const void *data)
+{
+    // make sure the range exists
+    if(data == NULL || pos > list->length || count > (list->length - pos)) {
+        return -1;
+    }
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    slist_node_t *node = slist_node_get(list, pos);
+    slist_node_t *last = node;
+    const char *src = data;
+
+    for(size_t i = 0; i < count; i++, node = node->next) {
+        slist_data_copy(node->data, src, list->size);
+        src += list->size;
+        last = node;
+    }
+
+    // remember the last node, so writing the next
+    // range starts from there
+    list->finger = last;
+    list->finger_pos = pos + count - 1;
+
+    return 0;
+}
+
+int slist_insert_range(slist_t *list, size_t pos, const void *data, size_t count)
+{
+    // make sure the position exists
+    if(pos > list->length) {
+        return -1;
+    }
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    // allocate all nodes before touching the list
+    slist_node_t *last;
+    slist_node_t *first = slist_node_chain(list, data, count, &last);
+
+    if(first == NULL) {
+        return -2;
+    }
+
+    // find the node to insert after
+    slist_node_t *prev = (pos > 0) ? slist_node_get(list, pos - 1) : NULL;
+
+    // link the chain into the list
+    if(prev != NULL) {
+        last->next = prev->next;
+        prev->next = first;
+    } else {
+        last->next = list->head;
+        list->head = first;
+    }
+
+    if(last->next == NULL) {
+        list->tail = last;
+    }
+
+    list->length += count;
+
+    // the finger moved back if it was at or after pos
+    if(list->finger != NULL && list->finger_pos >= pos) {
+        list->finger_pos += count;
+    }
+
+    return 0;
+}
+
+int slist_remove_range(slist_t *list, size_t pos, size_t count)
+{
+    // make sure the range exists
+    if(pos > list->length || count > (list->length - pos)) {
+        return -1;
+    }
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    // find the node before the range
+    slist_node_t *prev = (pos > 0) ? slist_node_get(list, pos - 1) : NULL;
+    slist_node_t *node = (prev != NULL) ? prev->next : list->head;
+
+    // free the nodes of the range
+    for(size_t i = 0; i < count; i++) {
+        slist_node_t *next = node->next;
+        slist_node_free(list, node);
+        node = next;
+    }
+
+    // connect the rest of the list
+    if(prev != NULL) {
+        prev->next = node;
+    } else {
+        list->head = node;
+    }
+
+    if(node == NULL) {
+        list->tail = prev;
+    }
+
+    list->length -= count;
+
+    // the finger is gone if it was in the range, and
+    // moved forward if it was after it
+    if(list->finger != NULL && list->finger_pos >= pos) {
+        if(list->finger_pos < (pos + count)) {
+            slist_finger_reset(list);
+        } else {
+            list->finger_pos -= count;
+        }
+    }
+
+    return 0;
+}
+
 void *slist_pop(slist_t *list, void *data)
 {
     // this is the node to be popped
@@ -390,16 +833,69 @@ void *slist_pop(slist_t *list, void *data)
     // update list info
     list->length--;
 
+    // everything moved forward by one, unless the finger
+    // is the node we are popping
+    if(list->finger == node) {
+        slist_finger_reset(list);
+    } else {
+        list->finger_pos--;
+    }
+
     // copy data if requested
     if(data != NULL) {
-        memcpy(data, node->data, list->size);
+        slist_data_copy(data, node->data, list->size);
     }
 
-    free(node);
+    slist_node_free(list, node);
 
     return data;
 }
 
+size_t slist_pop_many(slist_t *list, void *out, size_t max)
+{
+    size_t count = (max < list->length) ? max : list->length;
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    // detach the first count nodes from the list
+    slist_node_t *node = list->head;
+    list->head = slist_node_cut(node, count);
+
+    if(list->head == NULL) {
+        list->tail = NULL;
+    }
+
+    list->length -= count;
+
+    // everything moved forward by count, unless the
+    // finger was popped
+    if(list->finger != NULL && list->finger_pos < count) {
+        slist_finger_reset(list);
+    } else {
+        list->finger_pos -= count;
+    }
+
+    // copy out the data and release the nodes
+    char *dest = out;
+
+    while(node != NULL) {
+        slist_node_t *next = node->next;
+
+        if(dest != NULL) {
+            slist_data_copy(dest, node->data, list->size);
+            dest += list->size;
+        }
+
+        slist_node_free(list, node);
+        node = next;
+    }
+
+    return count;
+}
+
 int slist_swap(slist_t *list, size_t pos_a, size_t pos_b) {
     // if elements don't exist, we can't swap 'em
     if(max(pos_a, pos_b) >= list->length) {
@@ -417,6 +913,10 @@ int slist_swap(slist_t *list, size_t pos_a, size_t pos_b) {
         swap(pos_a, pos_b);
     }
 
+    // nodes are moved around, so the finger might not
+    // be at finger_pos anymore
+    slist_finger_reset(list);
+
     // if pos_a is list->head, then we have to do things a
     // little differently, so we check for that here
     if(pos_a == 0) {
@@ -507,6 +1007,139 @@ int slist_swap(slist_t *list, size_t pos_a, size_t pos_b) {
     return 0;
 }
 
+void *slist_insert_after(slist_t *list, slist_node_t *node, const void *data)
+{
+    // inserting after nothing is prepending
+    if(node == NULL) {
+        return slist_prepend(list, data);
+    }
+
+    // allocate memory for new node
+    slist_node_t *new = slist_node_alloc(list);
+
+    // make sure allocation worked
+    if(new == NULL) {
+        return NULL;
+    }
+
+    // set data, if neccessary
+    if(data != NULL) {
+        slist_data_copy(new->data, data, list->size);
+    }
+
+    // connect nodes
+    new->next = node->next;
+    node->next = new;
+
+    // update list
+    if(list->tail == node) {
+        list->tail = new;
+    }
+
+    list->length++;
+
+    // we don't know where node is, so the position
+    // of the finger may have changed
+    slist_finger_reset(list);
+
+    return new->data;
+}
+
+int slist_remove_after(slist_t *list, slist_node_t *node)
+{
+    // removing after nothing is popping
+    if(node == NULL) {
+        return (list->head != NULL) ? slist_remove(list, 0) : -1;
+    }
+
+    slist_node_t *next = node->next;
+
+    // can't remove past the end
+    if(next == NULL) {
+        return -1;
+    }
+
+    // disconnect the node
+    node->next = next->next;
+
+    // update list
+    if(list->tail == next) {
+        list->tail = node;
+    }
+
+    list->length--;
+
+    // we don't know where node is, so the position
+    // of the finger may have changed
+    slist_finger_reset(list);
+
+    slist_node_free(list, next);
+
+    return 0;
+}
+
+slist_node_t *slist_node_of(void *data)
+{
+    if(data == NULL) {
+        return NULL;
+    }
+
+    return (slist_node_t*) ((char*) data - offsetof(slist_node_t, data));
+}
+
+int slist_iter_init(slist_iter_t *iter, slist_t *list)
+{
+    if(iter == NULL || list == NULL) {
+        return -1;
+    }
+
+    iter->list = list;
+    iter->prev = NULL;
+    iter->node = list->head;
+
+    return 0;
+}
+
+int slist_iter_next(slist_iter_t *iter)
+{
+    // can't go past the end
+    if(iter->node == NULL) {
+        return -1;
+    }
+
+    iter->prev = iter->node;
+    iter->node = iter->node->next;
+
+    return 0;
+}
+
+slist_node_t *slist_iter_node(const slist_iter_t *iter)
+{
+    return iter->node;
+}
+
+void *slist_iter_get(const slist_iter_t *iter)
+{
+    if(iter->node == NULL) {
+        return NULL;
+    }
+
+    return iter->node->data;
+}
+
+int slist_iter_remove(slist_iter_t *iter)
+{
+    // can't remove past the end
+    if(iter->node == NULL) {
+        return -1;
+    }
+
+    // the next node takes the place of this one
+    iter->node = iter->node->next;
+
+    return slist_remove_after(iter->list, iter->prev);
+}
+
 slist_t *slist_split(slist_t *list, size_t pos)
 {
     // check if pos actually points to anything useful
@@ -514,17 +1147,24 @@ slist_t *slist_split(slist_t *list, size_t pos)
         return NULL;
     }
 
-    // allocate new slist
-    slist_t *new = slist_new(list->size);
-    assert(new != NULL);
+    // allocate new slist, sharing the pool (if any)
+    slist_t *new = slist_new_like(list);
+
+    // make sure that worked
+    if(new == NULL) {
+        return NULL;
+    }
 
     // check if we should transfer the whole list
     if(pos == 0) {
-        memcpy(new, list, sizeof(slist_t));
-        memset(list,   0, sizeof(slist_t));
+        new->head = list->head;
+        new->tail = list->tail;
+        new->length = list->length;
 
-        // data size stays the same
-        list->size = new->size;
+        list->head = NULL;
+        list->tail = NULL;
+        list->length = 0;
+        slist_finger_reset(list);
     } else {
         // get the node just before pos
         slist_node_t *node = slist_node_get(list, pos-1);
@@ -544,6 +1184,11 @@ slist_t *slist_split(slist_t *list, size_t pos)
         // the lengths of both lists
         new->length = list->length - pos;
         list->length = pos;
+
+        // the finger might be in the part that was split off
+        if(list->finger_pos >= pos) {
+            slist_finger_reset(list);
+        }
     }
 
     return new;
@@ -562,10 +1207,18 @@ slist_t *slist_join(slist_t *dest, slist_t *src)
         return dest;
     }
 
+    // dest needs to be able to get rid of the nodes
+    // of src later on
+    if(slist_adopt(dest, src) < 0) {
+        return NULL;
+    }
+
     // if dest is an empty list, we can get away by simply
-    // memcpy-ing src to dest and then clearing src out
+    // taking over the nodes of src
     if(dest->length == 0) {
-        memcpy(dest, src, sizeof(slist_t));
+        dest->head   = src->head;
+        dest->tail   = src->tail;
+        dest->length = src->length;
     } else {
         // otherwise, do it the hard way
         dest->tail->next = src->head;
@@ -573,39 +1226,446 @@ slist_t *slist_join(slist_t *dest, slist_t *src)
         dest->length    += src->length;
     }
 
-    // reset src, but keep data size
-    memset(src, 0, sizeof(slist_t));
-    src->size = dest->size;
+    // reset src, but keep data size and pool
+    src->head = NULL;
+    src->tail = NULL;
+    src->length = 0;
+    slist_finger_reset(src);
 
     return dest;
 }
 
+int slist_splice(slist_t *dest, size_t dest_pos, slist_t *src, size_t from, size_t count)
+{
+    // moving within one list or between lists of
+    // different sizes is not supported
+    if(dest == src || dest->size != src->size) {
+        return -1;
+    }
+
+    // make sure all positions exist
+    if(dest_pos > dest->length || from > src->length || count > (src->length - from)) {
+        return -2;
+    }
+
+    // nothing to do
+    if(count == 0) {
+        return 0;
+    }
+
+    // dest needs to be able to get rid of the nodes
+    // of src later on
+    if(slist_adopt(dest, src) < 0) {
+        return -3;
+    }
+
+    // find the node before the range, and the range itself
+    slist_node_t *before = (from > 0) ? slist_node_get(src, from - 1) : NULL;
+    slist_node_t *first = (before != NULL) ? before->next : src->head;
+    slist_node_t *last = slist_node_get(src, from + count - 1);
+    assert(first != NULL);
+    assert(last != NULL);
+
+    // take the range out of src
+    if(before != NULL) {
+        before->next = last->next;
+    } else {
+        src->head = last->next;
+    }
+
+    if(src->tail == last) {
+        src->tail = before;
+    }
+
+    src->length -= count;
+    slist_finger_reset(src);
+
+    // find the node in dest to insert after
+    slist_node_t *prev = (dest_pos > 0) ? slist_node_get(dest, dest_pos - 1) : NULL;
+
+    // link the range into dest
+    if(prev != NULL) {
+        last->next = prev->next;
+        prev->next = first;
+    } else {
+        last->next = dest->head;
+        dest->head = first;
+    }
+
+    if(last->next == NULL) {
+        dest->tail = last;
+    }
+
+    dest->length += count;
+
+    // the finger moved back if it was after the range
+    if(dest->finger != NULL && dest->finger_pos >= dest_pos) {
+        dest->finger_pos += count;
+    }
+
+    return 0;
+}
+
+int slist_partition(slist_t *list, slist_classify_element *classify, void *ctx, slist_t **outs, size_t n)
+{
+    if(classify == NULL || outs == NULL || n == 0) {
+        return -1;
+    }
+
+    // check all lists before moving anything
+    for(size_t i = 0; i < n; i++) {
+        if(outs[i] == NULL || outs[i] == list || outs[i]->size != list->size) {
+            return -1;
+        }
+    }
+
+    // the lists need to be able to get rid of the
+    // nodes of list later on
+    for(size_t i = 0; i < n; i++) {
+        if(slist_adopt(outs[i], list) < 0) {
+            return -2;
+        }
+    }
+
+    // take all nodes out of list, the ones that stay
+    // are appended to it again
+    slist_node_t *node = list->head;
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+    slist_finger_reset(list);
+
+    while(node != NULL) {
+        slist_node_t *next = node->next;
+        size_t i = classify(node->data, ctx);
+        slist_t *out = (i < n) ? outs[i] : list;
+
+        // append node to out
+        node->next = NULL;
+
+        if(out->tail != NULL) {
+            out->tail->next = node;
+        } else {
+            out->head = node;
+        }
+
+        out->tail = node;
+        out->length++;
+
+        node = next;
+    }
+
+    return 0;
+}
+
 slist_t *slist_copy(const slist_t *list)
 {
-    // allocate a new slist
-    slist_t *copy = slist_new(list->size);
+    // a list that allocates its nodes one by one gets a
+    // pool for the copy, so that the copy can be laid out
+    // in one block. otherwise the copy allocates nodes the
+    // same way as the original (sharing the pool, if any)
+    slist_t *copy;
+    if(list->pool == NULL && list->arena == NULL && list->allocator == NULL) {
+        copy = slist_new_pooled(list->size, 0);
+    } else {
+        copy = slist_new_like(list);
+    }
 
     // memory error checking
     if(copy == NULL) {
         return NULL;
     }
 
-    // loop thought the original slist
-    slist_node_t *node;
-    for(node = list->head; node != NULL; node=node->next) {
-        // add data as we go
-        void *result = slist_append(copy, node->data);
+    // get all nodes from one slab, so that they lie next
+    // to each other in the same order as in the list
+    if(copy->pool != NULL && pool_reserve(copy->pool, list->length) < 0) {
+        slist_free(copy);
+        return NULL;
+    }
+
+    // loop thought the original slist, linking
+    // copies of the nodes as we go
+    slist_node_t **link = &copy->head;
+    for(slist_node_t *node = list->head; node != NULL; node = node->next) {
+        slist_node_t *new = slist_node_alloc(copy);
 
-        // make sure appending worked
-        if(result == NULL) {
+        // make sure allocation worked
+        if(new == NULL) {
+            *link = NULL;
             slist_free(copy);
             return NULL;
         }
+
+        slist_data_copy(new->data, node->data, list->size);
+
+        *link = new;
+        link = &new->next;
+        copy->tail = new;
+        copy->length++;
     }
 
+    *link = NULL;
+
     return copy;
 }
 
+int slist_sort(slist_t *list, slist_compare_elements *cmp)
+{
+    if(list == NULL || cmp == NULL) {
+        return -1;
+    }
+
+    // lists of zero or one element are always sorted
+    if(list->length < 2) {
+        return 0;
+    }
+
+    slist_node_t *head = list->head;
+    slist_node_t *tail = NULL;
+
+    // merge runs of width nodes into runs of twice that,
+    // until there is only one run left
+    for(size_t width = 1; width < list->length; width *= 2) {
+        slist_node_t *rest = head;
+        slist_node_t **link = &head;
+
+        while(rest != NULL) {
+            // take the next two runs off the chain
+            slist_node_t *a = rest;
+            slist_node_t *b = slist_node_cut(a, width);
+            rest = slist_node_cut(b, width);
+
+            // merge them, taking from a when elements are
+            // equal to keep the sort stable
+            while(a != NULL && b != NULL) {
+                if(cmp(a->data, b->data) >= 0) {
+                    *link = a;
+                    a = a->next;
+                } else {
+                    *link = b;
+                    b = b->next;
+                }
+
+                link = &(*link)->next;
+            }
+
+            // append whatever is left over, and find the end
+            *link = (a != NULL) ? a : b;
+
+            while(*link != NULL) {
+                tail = *link;
+                link = &(*link)->next;
+            }
+        }
+    }
+
+    list->head = head;
+    list->tail = tail;
+
+    // the nodes are in a different order now
+    slist_finger_reset(list);
+
+    return 0;
+}
+
+int slist_radix_sort(slist_t *list, size_t key_offset, size_t key_width)
+{
+    if(list == NULL) {
+        return -1;
+    }
+
+    // the key has to be an unsigned integer that lies
+    // completely inside of the element
+    if(key_width != 1 && key_width != 2 && key_width != 4 && key_width != 8) {
+        return -1;
+    }
+
+    if((key_offset + key_width) > list->size) {
+        return -1;
+    }
+
+    // lists of zero or one element are always sorted
+    if(list->length < 2) {
+        return 0;
+    }
+
+    slist_node_t *heads[SLIST_RADIX_BUCKETS];
+    slist_node_t *tails[SLIST_RADIX_BUCKETS];
+
+    // sort by one digit of the key per pass, starting
+    // with the least significant one. the buckets keep
+    // the order of the previous pass, so every pass is
+    // stable and the result is sorted by the whole key.
+    for(size_t shift = 0; shift < (key_width * 8); shift += SLIST_RADIX_BITS) {
+        memset(heads, 0, sizeof(heads));
+
+        // distribute the nodes into the bucket chains
+        for(slist_node_t *node = list->head; node != NULL; node = node->next) {
+            size_t digit = (slist_node_key(node, key_offset, key_width) >> shift) & (SLIST_RADIX_BUCKETS - 1);
+
+            if(heads[digit] == NULL) {
+                heads[digit] = node;
+            } else {
+                tails[digit]->next = node;
+            }
+
+            tails[digit] = node;
+        }
+
+        // and put the chains back together in order
+        slist_node_t **link = &list->head;
+        for(size_t digit = 0; digit < SLIST_RADIX_BUCKETS; digit++) {
+            if(heads[digit] != NULL) {
+                *link = heads[digit];
+                link = &tails[digit]->next;
+                list->tail = tails[digit];
+            }
+        }
+
+        *link = NULL;
+    }
+
+    // the nodes are in a different order now
+    slist_finger_reset(list);
+
+    return 0;
+}
+
+int slist_compact(slist_t *list)
+{
+    if(list == NULL) {
+        return -1;
+    }
+
+    size_t pos = 0;
+    int ret = slist_compact_step(list, &pos, list->length);
+
+    return (ret < 0) ? ret : 0;
+}
+
+int slist_compact_step(slist_t *list, size_t *pos, size_t count)
+{
+    if(list == NULL || pos == NULL) {
+        return -1;
+    }
+
+    // there is no contiguous memory to be had from
+    // arenas or allocators
+    if(list->arena != NULL || list->allocator != NULL) {
+        return -1;
+    }
+
+    // if the list got shorter since the last step, we
+    // are done with this round
+    if(*pos >= list->length) {
+        *pos = 0;
+        return 0;
+    }
+
+    if(count > (list->length - *pos)) {
+        count = list->length - *pos;
+    }
+
+    if(count == 0) {
+        return 1;
+    }
+
+    // the new nodes come from a pool
+    if(list->pool == NULL) {
+        list->pool = pool_new(sizeof(slist_node_t) + list->size, 0);
+
+        if(list->pool == NULL) {
+            return -1;
+        }
+    }
+
+    // which hands them out from a single slab
+    if(pool_reserve(list->pool, count) < 0) {
+        return -1;
+    }
+
+    // find the nodes to replace
+    slist_node_t *prev = (*pos > 0) ? slist_node_get(list, *pos - 1) : NULL;
+    slist_node_t *old = (prev != NULL) ? prev->next : list->head;
+
+    // make copies of all of them first. releasing old
+    // nodes could make the pool hand out nodes from
+    // their slab rather than the new one.
+    slist_node_t *head = NULL;
+    slist_node_t *last = NULL;
+    slist_node_t **link = &head;
+    slist_node_t *node = old;
+
+    for(size_t i = 0; i < count; i++, node = node->next) {
+        slist_node_t *new = slist_node_alloc(list);
+
+        // on error, release the copies and leave the
+        // list as it was
+        if(new == NULL) {
+            *link = NULL;
+
+            while(head != NULL) {
+                slist_node_t *next = head->next;
+                slist_node_free(list, head);
+                head = next;
+            }
+
+            return -1;
+        }
+
+        slist_data_copy(new->data, node->data, list->size);
+
+        *link = new;
+        link = &new->next;
+        last = new;
+    }
+
+    // node is the first node after the replaced ones
+    *link = node;
+
+    // release the old nodes
+    for(size_t i = 0; i < count; i++) {
+        slist_node_t *next = old->next;
+        slist_node_free(list, old);
+        old = next;
+    }
+
+    // and put the copies in their place
+    if(prev != NULL) {
+        prev->next = head;
+    } else {
+        list->head = head;
+    }
+
+    if(node == NULL) {
+        list->tail = last;
+    }
+
+    *pos += count;
+
+    // the finger might have been one of the old nodes.
+    // point it at the last new one instead, which is
+    // where the next step continues.
+    list->finger = last;
+    list->finger_pos = *pos - 1;
+
+    if(*pos >= list->length) {
+        *pos = 0;
+        return 0;
+    }
+
+    return 1;
+}
+
+int slist_locality_stats(const slist_t *list, locality_stats_t *stats)
+{
+    if(list == NULL) {
+        return -1;
+    }
+
+    return locality_measure(stats, list->head, offsetof(slist_node_t, next), list->length);
+}
+
 int slist_verify(const slist_t *list) {
     if(list == NULL) {
         return -1;
@@ -619,13 +1679,31 @@ int slist_verify(const slist_t *list) {
         }
     }
 
-    // this is an array of slist_node_t pointers
-    // which we will use to keep track of nodes we have
-    // already seen to recognize loops.
-    slist_node_t **nodes_seen = malloc(sizeof(slist_node_t*) * list->length);
+    // to recognize loops without having to remember
+    // every node, we use brent's algorithm: a second
+    // pointer stays at one node, and jumps to the
+    // current one every time we walked twice as far as
+    // the last time. if there is a loop, we run into
+    // that pointer after at most one more lap.
+    const slist_node_t *tortoise = NULL;
+    size_t power = 1;
+    size_t lambda = 0;
     size_t cur_index = 0;
 
     for(slist_node_t *node = list->head; node != NULL; node = node->next, cur_index++) {
+        // we must not have seen this node yet
+        if(node == tortoise) {
+            return -2;
+        }
+
+        if(lambda == power) {
+            tortoise = node;
+            power *= 2;
+            lambda = 0;
+        }
+
+        lambda++;
+
         // if we reached the last node...
         if((cur_index+1) == list->length) {
             // it must be the tail of the list
@@ -639,19 +1717,12 @@ int slist_verify(const slist_t *list) {
             }
         }
 
-        // we must not have seen this node yet
-        for(size_t i = 0; i < cur_index; i++) {
-            if(nodes_seen[i] == node) {
-                return -2;
-            }
+        // the finger must be where it says it is
+        if(list->finger == node && list->finger_pos != cur_index) {
+            return -8;
         }
-
-        // save it in seen nodes array
-        nodes_seen[cur_index] = node;
     }
 
-    free(nodes_seen);
-
     // at this point, we must have travelled
     // all nodes, otherwise list->length is
     // wrong
@@ -662,25 +1733,58 @@ int slist_verify(const slist_t *list) {
     return 0;
 }
 
-/*
-slist_t *slist_from_array(void **array, size_t len, size_t size)
+slist_t *slist_from_array(const void *data, size_t count, size_t size)
 {
-    slist_t *list = slist_new(size);
+    if(data == NULL && count > 0) {
+        return NULL;
+    }
 
-    if(list == NULL)
+    slist_t *list = slist_new_pooled(size, 0);
+
+    if(list == NULL) {
         return NULL;
-    
-    size_t i;
-    for(i = 0; i < len; ++i) {
-        slist_t *ret = slist_append(list, array[i]);
+    }
 
-        if(ret == NULL)
-            return NULL;
+    // put all nodes into one slab, which hands them
+    // out in address order
+    if(pool_reserve(list->pool, count) < 0) {
+        slist_free(list);
+        return NULL;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        void *element = slist_append(list, NULL);
+        assert(element != NULL);
+
+        slist_data_copy(element, ((const char*) data) + (i * size), size);
     }
 
     return list;
 }
-*/
+
+void *slist_to_array(const slist_t *list, void *out)
+{
+    if(list == NULL) {
+        return NULL;
+    }
+
+    // allocate an array if we didn't get one
+    if(out == NULL) {
+        out = malloc((list->length > 0) ? (list->length * list->size) : 1);
+
+        if(out == NULL) {
+            return NULL;
+        }
+    }
+
+    char *pos = out;
+    for(slist_node_t *node = list->head; node != NULL; node = node->next) {
+        slist_data_copy(pos, node->data, list->size);
+        pos += list->size;
+    }
+
+    return out;
+}
 
 /*
 slist_t *slist_from_dlist(dlist_t *dlist)
@@ -702,38 +1806,264 @@ slist_t *slist_from_dlist(dlist_t *dlist)
 }
 */
 
-/*
-void **slist_to_array(slist_t *list)
+static slist_node_t *slist_node_alloc(slist_t *list)
 {
-    if(list->size == 0)
+    // take node from the pool, if there is one
+    if(list->pool != NULL) {
+        return pool_get(list->pool);
+    }
+
+    // or from the arena
+    if(list->arena != NULL) {
+        return arena_alloc(list->arena, sizeof(slist_node_t) + list->size);
+    }
+
+    // or with the allocator
+    if(list->allocator != NULL) {
+        return allocator_alloc(list->allocator, sizeof(slist_node_t) + list->size);
+    }
+
+    // otherwise go through the node cache, which falls
+    // back to malloc() if it is disabled
+    return nodecache_alloc(sizeof(slist_node_t) + list->size);
+}
+
+static void slist_node_free(slist_t *list, slist_node_t *node)
+{
+    // nodes from an arena are released all at once
+    if(list->arena != NULL) {
+        return;
+    }
+
+    // let the allocator deal with it
+    if(list->allocator != NULL) {
+        allocator_free(list->allocator, node, sizeof(slist_node_t) + list->size);
+        return;
+    }
+
+    // put node back into the pool, unless it was not
+    // allocated from it (it could have been joined
+    // in from a list without a pool)
+    if(list->pool != NULL && pool_put(list->pool, node) == 0) {
+        return;
+    }
+
+    nodecache_free(node, sizeof(slist_node_t) + list->size);
+}
+
+static slist_t *slist_new_like(const slist_t *list)
+{
+    // lists using an arena live in it as well
+    if(list->arena != NULL) {
+        return slist_new_arena(list->size, list->arena);
+    }
+
+    // same for lists using an allocator
+    if(list->allocator != NULL) {
+        return slist_new_allocator(list->size, list->allocator);
+    }
+
+    slist_t *new = slist_new(list->size);
+
+    if(new == NULL) {
+        return NULL;
+    }
+
+    // share the pool
+    new->pool = pool_ref(list->pool);
+
+    return new;
+}
+
+static int slist_adopt(slist_t *dest, const slist_t *src)
+{
+    // nodes from an arena can't be free()d, and nodes
+    // in an arena list would never be released, so
+    // those can only be mixed within the same arena.
+    // the same goes for custom allocators.
+    if(dest->arena != src->arena || dest->allocator != src->allocator) {
+        return -1;
+    }
+
+    // nodes allocated with malloc() can be released
+    // by any list
+    if(src->pool == NULL) {
+        return 0;
+    }
+
+    // dest has no pool, so it can simply start using the
+    // one of src. nodes dest already has are not from the
+    // pool, so they still get free()d.
+    if(dest->pool == NULL) {
+        dest->pool = pool_ref(src->pool);
+        return 0;
+    }
+
+    // both have pools, merge them
+    if(pool_merge(dest->pool, src->pool) == NULL) {
+        return -1;
+    }
+
+    return 0;
+}
+
+static uint64_t slist_node_key(const slist_node_t *node, size_t offset, size_t width)
+{
+    // the key might not be aligned, so copy it out
+    switch(width) {
+        case 1: {
+            uint8_t key;
+            memcpy(&key, node->data + offset, sizeof(key));
+            return key;
+        }
+        case 2: {
+            uint16_t key;
+            memcpy(&key, node->data + offset, sizeof(key));
+            return key;
+        }
+        case 4: {
+            uint32_t key;
+            memcpy(&key, node->data + offset, sizeof(key));
+            return key;
+        }
+        default: {
+            uint64_t key;
+            memcpy(&key, node->data + offset, sizeof(key));
+            return key;
+        }
+    }
+}
+
+static slist_node_t *slist_node_new_with(slist_t *list, slist_init_element *init, void *ctx)
+{
+    if(init == NULL) {
         return NULL;
+    }
+
+    slist_node_t *node = slist_node_alloc(list);
 
-    void **array = malloc(list->size * sizeof(void*));
-    
-    if(array == NULL)
+    // make sure allocation worked
+    if(node == NULL) {
         return NULL;
+    }
 
-    slist_node_t *node = list->head;
-    size_t i = 0;
-    while((node != NULL) && (i < list->size)) {
-        array[i] = node->data;
+    // build the element, giving the node back if that
+    // didn't work out
+    if(init(node->data, ctx) < 0) {
+        slist_node_free(list, node);
+        return NULL;
+    }
+
+    return node;
+}
+
+static void slist_node_link(slist_t *list, slist_node_t *prev, slist_node_t *node)
+{
+    if(prev != NULL) {
+        node->next = prev->next;
+        prev->next = node;
+    } else {
+        node->next = list->head;
+        list->head = node;
+    }
+
+    if(node->next == NULL) {
+        list->tail = node;
+    }
+
+    list->length++;
+}
+
+static void slist_node_free_chain(slist_t *list, slist_node_t *node)
+{
+    while(node != NULL) {
+        slist_node_t *next = node->next;
+        slist_node_free(list, node);
+        node = next;
+    }
+}
+
+static slist_node_t *slist_node_chain(slist_t *list, const void *data, size_t count, slist_node_t **last)
+{
+    // get all nodes from one slab, so that they lie next
+    // to each other in the same order as in the list
+    if(list->pool != NULL && pool_reserve(list->pool, count) < 0) {
+        return NULL;
+    }
+
+    slist_node_t *first = NULL;
+    slist_node_t **link = &first;
+    const char *src = data;
+
+    for(size_t i = 0; i < count; i++) {
+        slist_node_t *node = slist_node_alloc(list);
 
+        // on failure, give back what we got so far
+        if(node == NULL) {
+            *link = NULL;
+            slist_node_free_chain(list, first);
+            return NULL;
+        }
+
+        if(src != NULL) {
+            slist_data_copy(node->data, src, list->size);
+            src += list->size;
+        }
+
+        *link = node;
+        link = &node->next;
+        *last = node;
+    }
+
+    *link = NULL;
+
+    return first;
+}
+
+static slist_node_t *slist_node_cut(slist_node_t *node, size_t count)
+{
+    // walk to the last node we keep
+    for(size_t i = 1; node != NULL && i < count; i++) {
         node = node->next;
-        ++i;
     }
 
-    if(i != (list->size-1)) {
-        free(array);
-        array = NULL;
+    if(node == NULL) {
+        return NULL;
     }
 
-    return array;
+    slist_node_t *rest = node->next;
+    node->next = NULL;
+
+    return rest;
+}
+
+static inline void slist_data_copy(void *dest, const void *src, size_t size)
+{
+    // with a constant size, the compiler can turn memcpy()
+    // into a few moves, so handle the common element sizes
+    // separately
+    switch(size) {
+        case 4:
+            memcpy(dest, src, 4);
+            break;
+        case 8:
+            memcpy(dest, src, 8);
+            break;
+        case 16:
+            memcpy(dest, src, 16);
+            break;
+        case 32:
+            memcpy(dest, src, 32);
+            break;
+        default:
+            memcpy(dest, src, size);
+            break;
+    }
 }
-*/
 
 /* this is an internal function used to extract the node at
  * pos of a given list, or NULL if it doesn't exist */
-static slist_node_t *slist_node_get(const slist_t *list, size_t pos)
+static slist_node_t *slist_node_get(slist_t *list, size_t pos)
 {
     /* obviously, an empty list does not have any nodes
      * that could be extracted, so return NULL
@@ -755,8 +2085,19 @@ static slist_node_t *slist_node_get(const slist_t *list, size_t pos)
         return NULL;
 
     /* if none of the shortcuts worked, extract the node
-     * by traversing the list */
+     * by traversing the list, starting at the finger if
+     * it is not past pos */
     slist_node_t *node = list->head;
+    size_t start = 0;
+    if (list->finger != NULL && list->finger_pos <= pos) {
+        node = list->finger;
+        start = list->finger_pos;
+    }
+
+    /* remember where we are going to end up */
+    list->finger_pos = pos;
+    pos -= start;
+
     while ((node != NULL) && (pos != 0)) {
         /* pos is now the 'distance' between the current
          * node and the one we want. decrease pos as we
@@ -768,8 +2109,12 @@ static slist_node_t *slist_node_get(const slist_t *list, size_t pos)
     }
 
     /* error in the list! bad! */
-    if(pos != 0)
+    if(pos != 0) {
+        list->finger = NULL;
         return NULL;
+    }
+
+    list->finger = node;
 
     return node;
 }
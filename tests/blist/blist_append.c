@@ -0,0 +1,32 @@
+#include "helpers.h"
+
+TEST(append_sets_first_and_last) {
+    int one = 1;
+
+    USING(blist_new(sizeof(int))) {
+        assertNotEquals(blist_append(list, &one), NULL);
+        assertEquals(blist_length(list), 1);
+        assertEquals(list->first, list->last);
+        assertEquals(*((int*)blist_first(list)), 1);
+        assertEquals(*((int*)blist_last(list)), 1);
+    }
+}
+
+TEST(append_grows_tree) {
+    USING(blist_new(64)) {
+        char data[64];
+
+        for(int i = 0; i < 10000; i++) {
+            memset(data, i, sizeof(data));
+            assertNotEquals(blist_append(list, data), NULL);
+        }
+
+        assertEquals(blist_length(list), 10000);
+        assertTrue(list->height > 2);
+        assertEquals(blist_verify(list), 0);
+
+        for(int i = 0; i < 10000; i++) {
+            assertEquals(((char*)blist_get(list, i, NULL))[63], (char) i);
+        }
+    }
+}
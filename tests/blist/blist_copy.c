@@ -0,0 +1,33 @@
+#include "helpers.h"
+
+TEST(copy_works_on_empty_list) {
+    USING(blist_new(sizeof(int))) {
+        blist_t *copy = blist_copy(list);
+        assertNotEquals(copy, NULL);
+        assertEquals(blist_length(copy), 0);
+        assertEquals(blist_verify(copy), 0);
+        blist_free(copy);
+    }
+}
+
+TEST(copy_works_on_full_list) {
+    USING(blist_new(sizeof(int))) {
+        for(int i = 0; i < 5000; i++) {
+            blist_append(list, &i);
+        }
+
+        blist_t *copy = blist_copy(list);
+        assertNotEquals(copy, NULL);
+        assertEquals(blist_length(copy), 5000);
+        assertEquals(copy->height, list->height);
+        assertEquals(blist_verify(copy), 0);
+
+        for(int i = 0; i < 5000; i++) {
+            assertNotEquals(blist_get(copy, i, &ret), NULL);
+            assertEquals(ret, i);
+            assertNotEquals(blist_get(copy, i, NULL), blist_get(list, i, NULL));
+        }
+
+        blist_free(copy);
+    }
+}
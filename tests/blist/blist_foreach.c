@@ -0,0 +1,24 @@
+#include "helpers.h"
+
+TEST(foreach_visits_all_elements_in_order) {
+    USING(blist_new(sizeof(int))) {
+        int count = 0;
+
+        blist_foreach(list, element) {
+            count++;
+        }
+
+        assertEquals(count, 0);
+
+        for(int i = 0; i < 1000; i++) {
+            blist_append(list, &i);
+        }
+
+        blist_foreach(list, element) {
+            assertEquals(*((int*)element), count);
+            count++;
+        }
+
+        assertEquals(count, 1000);
+    }
+}
@@ -0,0 +1,23 @@
+#include "helpers.h"
+
+TEST(get_does_not_work_for_illegal_index) {
+    USING(blist_new(sizeof(int))) {
+        assertEquals(blist_get(list, 0, NULL), NULL);
+        blist_append(list, NULL);
+        assertNotEquals(blist_get(list, 0, NULL), NULL);
+        assertEquals(blist_get(list, 1, NULL), NULL);
+    }
+}
+
+TEST(get_works_with_data) {
+    USING(blist_new(sizeof(int))) {
+        for(int i = 0; i < 5000; i++) {
+            blist_append(list, &i);
+        }
+
+        for(int i = 4999; i >= 0; i--) {
+            assertNotEquals(blist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#include "helpers.h"
+
+TEST(insert_returns_null_on_illegal) {
+    USING(blist_new(sizeof(int))) {
+        assertEquals(blist_insert(list, 1, NULL), NULL);
+        assertNotEquals(blist_insert(list, 0, NULL), NULL);
+        assertEquals(blist_insert(list, 2, NULL), NULL);
+    }
+}
+
+TEST(insert_works_in_middle) {
+    USING(blist_new(sizeof(int))) {
+        // insert even numbers, then the odd ones in between
+        for(int i = 0; i < 2000; i += 2) {
+            blist_append(list, &i);
+        }
+
+        for(int i = 1; i < 2000; i += 2) {
+            assertNotEquals(blist_insert(list, i, &i), NULL);
+        }
+
+        assertEquals(blist_verify(list), 0);
+
+        for(int i = 0; i < 2000; i++) {
+            assertNotEquals(blist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+        }
+    }
+}
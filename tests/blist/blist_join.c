@@ -0,0 +1,82 @@
+#include "helpers.h"
+
+TEST(join_does_not_work_on_different_element_sizes) {
+    USING(blist_new(sizeof(int))) {
+        blist_t *other = blist_new(sizeof(char));
+        assertEquals(blist_join(list, other), NULL);
+        blist_free(other);
+    }
+}
+
+TEST(join_works_on_empty_lists) {
+    int one = 1;
+
+    USING(blist_new(sizeof(int))) {
+        blist_t *other = blist_new(sizeof(int));
+        assertEquals(blist_join(list, other), list);
+        assertEquals(blist_length(list), 0);
+
+        blist_append(other, &one);
+        assertEquals(blist_join(list, other), list);
+        assertEquals(blist_length(list), 1);
+        assertEquals(blist_length(other), 0);
+        assertEquals(blist_verify(other), 0);
+
+        blist_free(other);
+    }
+}
+
+TEST(join_works_on_full_lists) {
+    USING(blist_new(sizeof(int))) {
+        blist_t *other = blist_new(sizeof(int));
+
+        for(int i = 0; i < 50; i++) {
+            blist_append(list, &i);
+        }
+
+        for(int i = 50; i < 100; i++) {
+            blist_append(other, &i);
+        }
+
+        assertEquals(blist_join(list, other), list);
+        assertEquals(blist_length(list), 100);
+        assertEquals(blist_length(other), 0);
+
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(blist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+        }
+
+        blist_free(other);
+    }
+}
+
+TEST(join_works_on_lists_of_different_height) {
+    for(int left = 1; left < 5000; left = left * 3 + 1) {
+        for(int right = 1; right < 5000; right = right * 3 + 1) {
+            USING(blist_new(sizeof(int))) {
+                blist_t *other = blist_new(sizeof(int));
+
+                for(int i = 0; i < left; i++) {
+                    blist_append(list, &i);
+                }
+
+                for(int i = left; i < (left + right); i++) {
+                    blist_append(other, &i);
+                }
+
+                assertEquals(blist_join(list, other), list);
+                assertEquals(blist_length(list), left + right);
+                assertEquals(blist_verify(list), 0);
+                assertEquals(blist_verify(other), 0);
+
+                for(int i = 0; i < (left + right); i++) {
+                    assertNotEquals(blist_get(list, i, &ret), NULL);
+                    assertEquals(ret, i);
+                }
+
+                blist_free(other);
+            }
+        }
+    }
+}
@@ -0,0 +1,31 @@
+#include "helpers.h"
+
+TEST(new_works_with_all_sizes) {
+    for(size_t size = 1; size < 256; size++) {
+        USING(blist_new(size)) {
+            assertNotEquals(list, NULL);
+            assertEquals(blist_size(list), size);
+            assertEquals(blist_length(list), 0);
+        }
+    }
+}
+
+TEST(new_sets_all_pointers_to_null) {
+    USING(blist_new(sizeof(int))) {
+        assertEquals(list->root, NULL);
+        assertEquals(list->first, NULL);
+        assertEquals(list->last, NULL);
+        assertEquals(blist_first(list), NULL);
+        assertEquals(blist_last(list), NULL);
+    }
+}
+
+TEST(new_fits_small_elements_into_leaves) {
+    USING(blist_new(sizeof(char))) {
+        assertEquals(list->per_leaf, BLIST_LEAF_BYTES);
+    }
+
+    USING(blist_new(1024)) {
+        assertEquals(list->per_leaf, BLIST_MIN_PER_LEAF);
+    }
+}
@@ -0,0 +1,22 @@
+#include "helpers.h"
+
+TEST(pop_works_on_empty_list) {
+    USING(blist_new(sizeof(int))) {
+        assertEquals(blist_pop(list, &ret), NULL);
+    }
+}
+
+TEST(pop_works_on_full_list) {
+    USING(blist_new(sizeof(int))) {
+        for(int i = 0; i < 1000; i++) {
+            blist_append(list, &i);
+        }
+
+        for(int i = 0; i < 1000; i++) {
+            assertEquals(blist_pop(list, &ret), &ret);
+            assertEquals(ret, i);
+        }
+
+        assertEquals(blist_length(list), 0);
+    }
+}
@@ -0,0 +1,27 @@
+#include "helpers.h"
+
+TEST(prepend_sets_first_and_last) {
+    int one = 1;
+
+    USING(blist_new(sizeof(int))) {
+        assertNotEquals(blist_prepend(list, &one), NULL);
+        assertEquals(blist_length(list), 1);
+        assertEquals(list->first, list->last);
+    }
+}
+
+TEST(prepend_grows_tree) {
+    USING(blist_new(sizeof(int))) {
+        for(int i = 0; i < 10000; i++) {
+            assertNotEquals(blist_prepend(list, &i), NULL);
+        }
+
+        assertTrue(list->height > 0);
+        assertEquals(blist_verify(list), 0);
+
+        for(int i = 0; i < 10000; i++) {
+            assertNotEquals(blist_get(list, i, &ret), NULL);
+            assertEquals(ret, 9999 - i);
+        }
+    }
+}
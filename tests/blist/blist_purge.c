@@ -0,0 +1,15 @@
+#include "helpers.h"
+
+TEST(purge_removes_all_elements_of_list) {
+    USING(blist_new(sizeof(int))) {
+        for(int i = 0; i < 5000; i++) {
+            blist_append(list, &i);
+        }
+
+        assertEquals(blist_purge(list), list);
+        assertEquals(blist_length(list), 0);
+        assertEquals(list->root, NULL);
+        assertEquals(list->height, 0);
+        assertEquals(blist_size(list), sizeof(int));
+    }
+}
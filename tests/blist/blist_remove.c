@@ -0,0 +1,47 @@
+#include "helpers.h"
+
+TEST(remove_on_empty_list_does_not_work) {
+    USING(blist_new(sizeof(int))) {
+        assertTrue(blist_remove(list, 0) < 0);
+    }
+}
+
+TEST(remove_shrinks_tree) {
+    USING(blist_new(64)) {
+        for(int i = 0; i < 5000; i++) {
+            blist_append(list, NULL);
+        }
+
+        // remove from the middle until the list is empty
+        while(blist_length(list) > 0) {
+            assertEquals(blist_remove(list, blist_length(list) / 2), 0);
+
+            if((blist_length(list) % 97) == 0) {
+                assertEquals(blist_verify(list), 0);
+            }
+        }
+
+        assertEquals(list->root, NULL);
+        assertEquals(list->height, 0);
+    }
+}
+
+TEST(remove_keeps_order) {
+    USING(blist_new(sizeof(int))) {
+        for(int i = 0; i < 3000; i++) {
+            blist_append(list, &i);
+        }
+
+        // remove every odd number
+        for(int i = 1; i <= 1500; i++) {
+            assertEquals(blist_remove(list, i), 0);
+        }
+
+        assertEquals(blist_verify(list), 0);
+
+        for(int i = 0; i < 1500; i++) {
+            assertNotEquals(blist_get(list, i, &ret), NULL);
+            assertEquals(ret, 2 * i);
+        }
+    }
+}
@@ -0,0 +1,29 @@
+#include "helpers.h"
+
+TEST(set_does_not_work_for_illegal_index) {
+    int one = 1;
+
+    USING(blist_new(sizeof(int))) {
+        assertEquals(blist_set(list, 0, &one), NULL);
+        blist_append(list, NULL);
+        assertEquals(blist_set(list, 0, NULL), NULL);
+        assertEquals(blist_set(list, 1, &one), NULL);
+    }
+}
+
+TEST(set_works_with_data) {
+    USING(blist_new(sizeof(int))) {
+        for(int i = 0; i < 1000; i++) {
+            blist_append(list, NULL);
+        }
+
+        for(int i = 0; i < 1000; i++) {
+            assertNotEquals(blist_set(list, i, &i), NULL);
+        }
+
+        for(int i = 0; i < 1000; i++) {
+            assertNotEquals(blist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+#include "helpers.h"
+
+// elements big enough that only BLIST_MIN_PER_LEAF fit
+// into a leaf, which makes for deep trees
+typedef struct {
+    int value;
+    char padding[60];
+} big_t;
+
+TEST(split_does_not_work_on_illegal_pos) {
+    USING(blist_new(sizeof(int))) {
+        assertEquals(blist_split(list, 0), NULL);
+        blist_append(list, NULL);
+        assertEquals(blist_split(list, 1), NULL);
+    }
+}
+
+TEST(split_works_at_every_position) {
+    for(int pos = 0; pos < 3000; pos += 7) {
+        USING(blist_new(sizeof(big_t))) {
+            big_t big = {0};
+
+            for(big.value = 0; big.value < 3000; big.value++) {
+                blist_append(list, &big);
+            }
+
+            blist_t *splt = blist_split(list, pos);
+            assertNotEquals(splt, NULL);
+            assertEquals(blist_verify(splt), 0);
+            assertEquals(blist_length(list), pos);
+            assertEquals(blist_length(splt), 3000 - pos);
+
+            for(int i = 0; i < pos; i++) {
+                assertNotEquals(blist_get(list, i, &big), NULL);
+                assertEquals(big.value, i);
+            }
+
+            for(int i = pos; i < 3000; i++) {
+                assertNotEquals(blist_get(splt, i - pos, &big), NULL);
+                assertEquals(big.value, i);
+            }
+
+            blist_free(splt);
+        }
+    }
+}
+
+TEST(split_and_join_keep_list_intact) {
+    USING(blist_new(sizeof(big_t))) {
+        big_t big = {0};
+        srand(4);
+
+        for(big.value = 0; big.value < 5000; big.value++) {
+            blist_append(list, &big);
+        }
+
+        // cut the list into two pieces at random positions and
+        // put them back together in the same order, checking
+        // the tree every time
+        for(int i = 0; i < 200; i++) {
+            blist_t *splt = blist_split(list, rand() % 5000);
+            assertNotEquals(splt, NULL);
+            assertEquals(blist_verify(list), 0);
+            assertEquals(blist_verify(splt), 0);
+
+            // make the pieces differ in height sometimes
+            blist_t *rest = blist_split(splt, (rand() % blist_length(splt)));
+
+            if(rest != NULL) {
+                assertEquals(blist_join(list, splt), list);
+                assertEquals(blist_verify(list), 0);
+                blist_free(splt);
+                splt = rest;
+            }
+
+            assertEquals(blist_join(list, splt), list);
+            assertEquals(blist_verify(list), 0);
+            blist_free(splt);
+        }
+
+        assertEquals(blist_length(list), 5000);
+
+        for(int i = 0; i < 5000; i++) {
+            assertNotEquals(blist_get(list, i, &big), NULL);
+            assertEquals(big.value, i);
+        }
+    }
+}
@@ -0,0 +1,24 @@
+#include "helpers.h"
+
+TEST(swap_does_not_work_on_nonexisting_indices) {
+    USING(blist_new(sizeof(int))) {
+        assertTrue(blist_swap(list, 0, 1) < 0);
+        blist_append(list, NULL);
+        assertTrue(blist_swap(list, 0, 1) < 0);
+        assertEquals(blist_swap(list, 0, 0), 0);
+    }
+}
+
+TEST(swap_works_correctly_with_different_indices) {
+    USING(blist_new(sizeof(int))) {
+        for(int i = 0; i < 1000; i++) {
+            blist_append(list, &i);
+        }
+
+        assertEquals(blist_swap(list, 3, 997), 0);
+        assertNotEquals(blist_get(list, 3, &ret), NULL);
+        assertEquals(ret, 997);
+        assertNotEquals(blist_get(list, 997, &ret), NULL);
+        assertEquals(ret, 3);
+    }
+}
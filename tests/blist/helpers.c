@@ -0,0 +1,8 @@
+#include "../cu/cu.h"
+#include "../../clists/blist.h"
+#include "helpers.h"
+
+void check_and_free(blist_t *list) {
+    assertEquals(blist_verify(list), 0);
+    blist_free(list);
+}
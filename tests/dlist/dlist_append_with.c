@@ -0,0 +1,61 @@
+#include "helpers.h"
+
+// writes the next number into the element
+static int count_up(void *data, void *ctx) {
+    *((int*) data) = (*((int*) ctx))++;
+    return 0;
+}
+
+// like count_up, but fails once the number reaches 5
+static int count_up_to_five(void *data, void *ctx) {
+    if(*((int*) ctx) >= 5) {
+        return -1;
+    }
+
+    return count_up(data, ctx);
+}
+
+TEST(append_with_builds_elements_in_place) {
+    int next = 0;
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_append_with(list, NULL, &next), NULL);
+
+        for(int i = 0; i < 3; i++) {
+            void *data = dlist_append_with(list, count_up, &next);
+            assertNotEquals(data, NULL);
+            assertEquals(data, dlist_last(list));
+        }
+
+        void *data = dlist_prepend_with(list, count_up, &next);
+        assertNotEquals(data, NULL);
+        assertEquals(data, dlist_first(list));
+
+        assertNotEquals(dlist_insert_with(list, 2, count_up, &next), NULL);
+        assertNotEquals(dlist_insert_with(list, 5, count_up, &next), NULL);
+        assertEquals(dlist_insert_with(list, 7, count_up, &next), NULL);
+
+        int expected[] = { 3, 0, 4, 1, 2, 5 };
+        assertEquals(dlist_length(list), 6);
+        assertEquals(*((int*) dlist_last(list)), 5);
+
+        for(int i = 0; i < 6; i++) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, expected[i]);
+        }
+    }
+}
+
+TEST(append_with_does_not_add_failed_elements) {
+    int next = 4;
+
+    USING(dlist_new_pooled(sizeof(int), 4)) {
+        assertNotEquals(dlist_append_with(list, count_up_to_five, &next), NULL);
+        assertEquals(dlist_append_with(list, count_up_to_five, &next), NULL);
+        assertEquals(dlist_prepend_with(list, count_up_to_five, &next), NULL);
+        assertEquals(dlist_insert_with(list, 1, count_up_to_five, &next), NULL);
+
+        assertEquals(dlist_length(list), 1);
+        assertEquals(*((int*) dlist_first(list)), 4);
+    }
+}
@@ -0,0 +1,116 @@
+#include "helpers.h"
+
+// checks that the nodes of list lie next to each other
+// in memory, in list order
+static int dlist_is_contiguous(dlist_t *list) {
+    if(list->head == NULL || list->head->next == NULL) {
+        return 1;
+    }
+
+    char *head = (char*) list->head;
+    size_t stride = (char*) list->head->next - head;
+    size_t i = 0;
+
+    for(dlist_node_t *node = list->head; node != NULL; node = node->next, i++) {
+        if((char*) node != (head + (i * stride))) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// fills list with 0..count-1, in a scattered way
+static void dlist_fill_scattered(dlist_t *list, int count) {
+    for(int i = count - 1; i >= 0; i--) {
+        dlist_append(list, &i);
+        dlist_prepend(list, &i);
+    }
+
+    // leaves count-1..0, every other node of the heap
+    for(int i = 0; i < count; i++) {
+        dlist_remove(list, 0);
+    }
+}
+
+TEST(compact_does_not_work_on_arena_lists) {
+    arena_t *arena = arena_new(0);
+
+    USING(dlist_new_arena(sizeof(int), arena)) {
+        assertTrue(dlist_compact(list) < 0);
+    }
+
+    arena_free(arena);
+
+    assertTrue(dlist_compact(NULL) < 0);
+}
+
+TEST(compact_moves_nodes_into_one_block) {
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_compact(list), 0);
+
+        dlist_fill_scattered(list, 1000);
+        assertEquals(dlist_compact(list), 0);
+        assertEquals(dlist_verify(list), 0);
+        assertEquals(dlist_length(list), 1000);
+        assertTrue(dlist_is_contiguous(list));
+
+        // the list keeps the pool it got
+        assertNotEquals(list->pool, NULL);
+
+        for(int i = 0; i < 1000; i++) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, 999 - i);
+        }
+    }
+}
+
+TEST(compact_step_works_in_rounds) {
+    USING(dlist_new_pooled(sizeof(int), 8)) {
+        dlist_fill_scattered(list, 1000);
+
+        size_t pos = 0;
+        int steps = 0;
+
+        while((ret = dlist_compact_step(list, &pos, 64)) > 0) {
+            steps++;
+
+            // modifying the list in between steps is fine
+            dlist_insert(list, pos, &steps);
+            dlist_remove(list, pos);
+            assertEquals(dlist_verify(list), 0);
+        }
+
+        assertEquals(ret, 0);
+        assertEquals(pos, 0);
+        assertEquals(steps, 15);
+
+        for(int i = 0; i < 1000; i++) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, 999 - i);
+        }
+    }
+}
+
+TEST(compact_keeps_index_usable) {
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_index_enable(list), 0);
+        dlist_fill_scattered(list, 5000);
+
+        // make sure the index is up to date
+        assertNotEquals(dlist_get(list, 2500, NULL), NULL);
+
+        size_t pos = 100;
+        assertEquals(dlist_compact_step(list, &pos, 777), 1);
+        assertEquals(pos, 877);
+        assertEquals(dlist_verify(list), 0);
+
+        assertEquals(dlist_compact(list), 0);
+        assertEquals(dlist_verify(list), 0);
+
+        for(int i = 0; i < 5000; i++) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, 4999 - i);
+        }
+    }
+}
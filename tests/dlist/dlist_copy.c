@@ -72,3 +72,66 @@ TEST(copy_works_on_full_list) {
         dlist_free(copy);
     }
 }
+
+TEST(copy_lays_out_nodes_in_order) {
+    USING(dlist_new_pooled(sizeof(int), 16)) {
+        // scatter the nodes of the original
+        for(int i = 0; i < 1000; i++) {
+            dlist_prepend(list, &i);
+            dlist_insert(list, dlist_length(list) / 2, &i);
+        }
+
+        for(int i = 0; i < 500; i++) {
+            dlist_remove(list, (i * 7) % dlist_length(list));
+        }
+
+        dlist_t *copy = dlist_copy(list);
+        assertNotEquals(copy, NULL);
+        assertEquals(copy->pool, list->pool);
+        assertEquals(dlist_length(copy), 1500);
+
+        char *head = (char*) copy->head;
+        size_t stride = (char*) copy->head->next - head;
+        size_t i = 0;
+
+        for(dlist_node_t *node = copy->head; node != NULL; node = node->next, i++) {
+            assertEquals((char*) node, head + (i * stride));
+        }
+
+        assertEquals(dlist_free(copy), 0);
+    }
+}
+
+TEST(copy_can_be_modified_and_joined) {
+    USING(dlist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            dlist_append(list, &i);
+        }
+
+        // a plain list gets a pooled copy, laid out in order
+        dlist_t *copy = dlist_copy(list);
+        assertNotEquals(copy, NULL);
+        assertNotEquals(copy->pool, NULL);
+
+        char *head = (char*) copy->head;
+        size_t stride = (char*) copy->head->next - head;
+        size_t i = 0;
+
+        for(dlist_node_t *node = copy->head; node != NULL; node = node->next, i++) {
+            assertEquals((char*) node, head + (i * stride));
+        }
+
+        // remove some nodes, and add others
+        for(int i = 0; i < 50; i++) {
+            assertEquals(dlist_remove(copy, i), 0);
+            assertNotEquals(dlist_append(copy, &i), NULL);
+        }
+
+        assertEquals(dlist_verify(copy), 0);
+
+        // nodes of the copy are released by the original
+        assertEquals(dlist_join(list, copy), list);
+        assertEquals(dlist_length(list), 200);
+        assertEquals(dlist_free(copy), 0);
+    }
+}
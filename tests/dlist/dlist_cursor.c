@@ -0,0 +1,212 @@
+#include "helpers.h"
+
+// checks that list holds exactly the given elements
+static int dlist_holds(dlist_t *list, const int *expected, size_t count) {
+    if(dlist_length(list) != count) {
+        return 0;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        if(dlist_get(list, i, &ret) == NULL || ret != expected[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+TEST(cursor_init_does_not_work_on_illegal_positions) {
+    dlist_cursor_t cursor;
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_cursor_init(&cursor, list, 0), 0);
+        assertEquals(dlist_cursor_get(&cursor), NULL);
+        assertNotEquals(dlist_cursor_init(&cursor, list, 1), 0);
+        assertNotEquals(dlist_cursor_init(NULL, list, 0), 0);
+        assertNotEquals(dlist_cursor_init(&cursor, NULL, 0), 0);
+    }
+
+    USING(dlist_new(sizeof(int))) {
+        assertNotEquals(dlist_append(list, NULL), NULL);
+        assertEquals(dlist_cursor_init(&cursor, list, 1), 0);
+        assertNotEquals(dlist_cursor_init(&cursor, list, 2), 0);
+    }
+}
+
+TEST(cursor_moves_in_both_directions) {
+    dlist_cursor_t cursor;
+
+    USING(dlist_new(sizeof(int))) {
+        for(int i = 0; i < 5; i++) {
+            assertNotEquals(dlist_append(list, &i), NULL);
+        }
+
+        assertEquals(dlist_cursor_init(&cursor, list, 2), 0);
+        assertEquals(*((int*) dlist_cursor_get(&cursor)), 2);
+        assertEquals(dlist_cursor_pos(&cursor), 2);
+
+        // walk to the end and past it
+        for(int i = 3; i < 5; i++) {
+            assertEquals(dlist_cursor_next(&cursor), 0);
+            assertEquals(*((int*) dlist_cursor_get(&cursor)), i);
+        }
+
+        assertEquals(dlist_cursor_next(&cursor), 0);
+        assertEquals(dlist_cursor_get(&cursor), NULL);
+        assertEquals(dlist_cursor_pos(&cursor), 5);
+        assertNotEquals(dlist_cursor_next(&cursor), 0);
+
+        // walk back to the start
+        for(int i = 4; i >= 0; i--) {
+            assertEquals(dlist_cursor_prev(&cursor), 0);
+            assertEquals(*((int*) dlist_cursor_get(&cursor)), i);
+            assertEquals(dlist_cursor_pos(&cursor), i);
+        }
+
+        assertNotEquals(dlist_cursor_prev(&cursor), 0);
+        assertEquals(dlist_cursor_pos(&cursor), 0);
+    }
+}
+
+TEST(cursor_insert_works_correctly) {
+    dlist_cursor_t cursor;
+    int one = 1, two = 2, three = 3, four = 4;
+
+    USING(dlist_new(sizeof(int))) {
+        // inserting past the end of an empty list appends
+        assertEquals(dlist_cursor_init(&cursor, list, 0), 0);
+        assertNotEquals(dlist_insert_before(&cursor, &three), NULL);
+        assertEquals(dlist_cursor_pos(&cursor), 1);
+        assertEquals(dlist_insert_after(&cursor, &four), NULL);
+
+        assertEquals(dlist_cursor_prev(&cursor), 0);
+        assertNotEquals(dlist_insert_before(&cursor, &one), NULL);
+        assertEquals(dlist_cursor_pos(&cursor), 1);
+        assertEquals(*((int*) dlist_cursor_get(&cursor)), 3);
+
+        assertNotEquals(dlist_insert_after(&cursor, &four), NULL);
+        assertEquals(*((int*) dlist_cursor_get(&cursor)), 3);
+
+        assertEquals(dlist_cursor_prev(&cursor), 0);
+        assertNotEquals(dlist_insert_after(&cursor, &two), NULL);
+
+        int expected[] = { 1, 2, 3, 4 };
+        assertTrue(dlist_holds(list, expected, 4));
+        assertEquals(*((int*) dlist_first(list)), 1);
+        assertEquals(*((int*) dlist_last(list)), 4);
+    }
+}
+
+TEST(cursor_remove_works_correctly) {
+    dlist_cursor_t cursor;
+
+    USING(dlist_new(sizeof(int))) {
+        for(int i = -5; i < 5; i++) {
+            assertNotEquals(dlist_append(list, &i), NULL);
+        }
+
+        // remove every odd number
+        assertEquals(dlist_cursor_init(&cursor, list, 0), 0);
+
+        while(dlist_cursor_get(&cursor) != NULL) {
+            if(*((int*) dlist_cursor_get(&cursor)) % 2 != 0) {
+                assertEquals(dlist_remove_at(&cursor), 0);
+            } else {
+                assertEquals(dlist_cursor_next(&cursor), 0);
+            }
+        }
+
+        assertNotEquals(dlist_remove_at(&cursor), 0);
+        assertEquals(dlist_cursor_pos(&cursor), 5);
+
+        int expected[] = { -4, -2, 0, 2, 4 };
+        assertTrue(dlist_holds(list, expected, 5));
+    }
+
+    USING(dlist_new(sizeof(int))) {
+        assertNotEquals(dlist_append(list, NULL), NULL);
+        assertEquals(dlist_cursor_init(&cursor, list, 0), 0);
+        assertEquals(dlist_remove_at(&cursor), 0);
+        assertEquals(dlist_length(list), 0);
+        assertEquals(dlist_first(list), NULL);
+        assertEquals(dlist_last(list), NULL);
+    }
+}
+
+TEST(cursor_move_to_front_works_correctly) {
+    dlist_cursor_t cursor;
+
+    USING(dlist_new(sizeof(int))) {
+        for(int i = 0; i < 5; i++) {
+            assertNotEquals(dlist_append(list, &i), NULL);
+        }
+
+        assertEquals(dlist_cursor_init(&cursor, list, 5), 0);
+        assertNotEquals(dlist_move_to_front(&cursor), 0);
+
+        assertEquals(dlist_cursor_init(&cursor, list, 4), 0);
+        void *data = dlist_cursor_get(&cursor);
+        assertEquals(dlist_move_to_front(&cursor), 0);
+        assertEquals(dlist_cursor_pos(&cursor), 0);
+        assertEquals(dlist_cursor_get(&cursor), data);
+
+        assertEquals(dlist_cursor_init(&cursor, list, 2), 0);
+        assertEquals(dlist_move_to_front(&cursor), 0);
+        assertEquals(dlist_move_to_front(&cursor), 0);
+
+        int expected[] = { 1, 4, 0, 2, 3 };
+        assertTrue(dlist_holds(list, expected, 5));
+    }
+}
+
+TEST(cursor_keeps_index_usable) {
+    dlist_cursor_t cursor;
+    int value = 1500;
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_index_enable(list), 0);
+
+        for(int i = 0; i < 2000; i++) {
+            assertNotEquals(dlist_append(list, &i), NULL);
+        }
+
+        // make sure the index is up to date
+        assertNotEquals(dlist_get(list, 1000, NULL), NULL);
+
+        // drop every other element and double the rest
+        assertEquals(dlist_cursor_init(&cursor, list, 0), 0);
+
+        for(int i = 0; i < 2000; i++) {
+            if(i % 2 != 0) {
+                assertEquals(dlist_remove_at(&cursor), 0);
+            } else {
+                assertNotEquals(dlist_insert_after(&cursor, &i), NULL);
+                assertEquals(dlist_cursor_next(&cursor), 0);
+                assertEquals(dlist_cursor_next(&cursor), 0);
+            }
+        }
+
+        assertEquals(dlist_verify(list), 0);
+
+        for(int i = 0; i < 2000; i++) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, i - (i % 2));
+        }
+
+        assertEquals(dlist_cursor_init(&cursor, list, 1500), 0);
+        assertEquals(dlist_move_to_front(&cursor), 0);
+        assertNotEquals(dlist_insert_before(&cursor, &value), NULL);
+        assertEquals(dlist_verify(list), 0);
+
+        assertNotEquals(dlist_get(list, 0, &ret), NULL);
+        assertEquals(ret, 1500);
+        assertNotEquals(dlist_get(list, 1, &ret), NULL);
+        assertEquals(ret, 1500);
+        assertNotEquals(dlist_get(list, 2, &ret), NULL);
+        assertEquals(ret, 0);
+        assertNotEquals(dlist_get(list, 1501, &ret), NULL);
+        assertEquals(ret, 1498);
+        assertNotEquals(dlist_get(list, 1502, &ret), NULL);
+        assertEquals(ret, 1500);
+    }
+}
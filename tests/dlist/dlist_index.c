@@ -0,0 +1,251 @@
+#include "helpers.h"
+
+TEST(index_enable_and_disable_work) {
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_index_disable(list), -1);
+        assertEquals(dlist_index_enable(list), 0);
+        assertNotEquals(list->index, NULL);
+
+        // enabling twice does nothing
+        assertEquals(dlist_index_enable(list), 0);
+
+        assertEquals(dlist_index_disable(list), 0);
+        assertEquals(list->index, NULL);
+
+        // purging releases the index
+        assertEquals(dlist_index_enable(list), 0);
+        dlist_purge(list);
+        assertEquals(list->index, NULL);
+    }
+}
+
+TEST(index_get_works_on_large_list) {
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_index_enable(list), 0);
+
+        for(int i = 0; i < 10000; i++) {
+            assertNotEquals(dlist_append(list, &i), NULL);
+        }
+
+        for(int i = 0; i < 10000; i += 7) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+        }
+
+        assertEquals(dlist_verify(list), 0);
+
+        for(int i = 0; i < 10000; i += 13) {
+            int value = -i;
+            assertNotEquals(dlist_set(list, i, &value), NULL);
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, -i);
+        }
+    }
+}
+
+TEST(index_survives_mutations) {
+    // mirror of the list contents
+    int array[2000];
+    size_t length = 0;
+    unsigned int seed = 42;
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_index_enable(list), 0);
+
+        for(int i = 0; i < 5000; i++) {
+            seed = seed * 1103515245 + 12345;
+            size_t pos = (length > 0) ? (seed >> 8) % length : 0;
+            int op = (seed >> 4) % 8;
+
+            if(op < 4 && length < 2000) {
+                // insert somewhere
+                assertNotEquals(dlist_insert(list, pos, &i), NULL);
+                memmove(&array[pos + 1], &array[pos], (length - pos) * sizeof(int));
+                array[pos] = i;
+                length++;
+            } else if(op == 4 && length < 2000) {
+                assertNotEquals(dlist_prepend(list, &i), NULL);
+                memmove(&array[1], &array[0], length * sizeof(int));
+                array[0] = i;
+                length++;
+            } else if(op == 5 && length > 0) {
+                assertEquals(dlist_pop(list, &ret), &ret);
+                assertEquals(ret, array[0]);
+                memmove(&array[0], &array[1], (length - 1) * sizeof(int));
+                length--;
+            } else if(op == 6 && length > 0) {
+                size_t other = (seed >> 16) % length;
+                assertEquals(dlist_swap(list, pos, other), 0);
+                int tmp = array[pos];
+                array[pos] = array[other];
+                array[other] = tmp;
+            } else if(length > 0) {
+                assertEquals(dlist_remove(list, pos), 0);
+                memmove(&array[pos], &array[pos + 1], (length - pos - 1) * sizeof(int));
+                length--;
+            }
+
+            if((i % 250) == 0) {
+                assertEquals(dlist_verify(list), 0);
+            }
+        }
+
+        assertEquals(dlist_length(list), length);
+        for(size_t i = 0; i < length; i++) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, array[i]);
+        }
+    }
+}
+
+TEST(index_survives_bulk_removal) {
+    // mirror of the list contents
+    int array[3000];
+    size_t length = 3000;
+    int out[64];
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_index_enable(list), 0);
+
+        for(int i = 0; i < 3000; i++) {
+            dlist_append(list, &i);
+            array[i] = i;
+        }
+
+        // the index is updated in place, so verifying the
+        // list right away checks it
+        while(length > 200) {
+            assertEquals(dlist_pop_many(list, out, 37), 37);
+            assertEquals(out[36], array[36]);
+            memmove(&array[0], &array[37], (length - 37) * sizeof(int));
+            length -= 37;
+            assertEquals(dlist_verify(list), 0);
+
+            assertEquals(dlist_pop_back_many(list, out, 41), 41);
+            assertEquals(out[0], array[length - 1]);
+            length -= 41;
+            assertEquals(dlist_verify(list), 0);
+
+            // cut out a piece of the middle
+            assertEquals(dlist_remove_range(list, 50, 30), 0);
+            memmove(&array[50], &array[80], (length - 80) * sizeof(int));
+            length -= 30;
+            assertEquals(dlist_verify(list), 0);
+        }
+
+        assertEquals(dlist_length(list), length);
+        for(size_t i = 0; i < length; i++) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, array[i]);
+        }
+
+        assertEquals(dlist_remove_range(list, 0, length), 0);
+        assertEquals(dlist_verify(list), 0);
+        assertEquals(dlist_length(list), 0);
+    }
+}
+
+// builds elements counting up from *ctx
+static int index_count_up(void *data, void *ctx) {
+    *((int*) data) = (*((int*) ctx))++;
+    return 0;
+}
+
+TEST(index_survives_bulk_insertion) {
+    // mirror of the list contents
+    int array[4000];
+    int batch[40];
+    size_t length = 0;
+    unsigned int seed = 7;
+
+    USING(dlist_new(sizeof(int))) {
+        dlist_t *other = dlist_new(sizeof(int));
+        assertEquals(dlist_index_enable(list), 0);
+        assertEquals(dlist_index_enable(other), 0);
+
+        // the index is updated in place, so verifying the
+        // list right away checks it
+        for(int round = 0; round < 60; round++) {
+            seed = seed * 1103515245 + 12345;
+            size_t pos = (seed >> 8) % (length + 1);
+            size_t count = 1 + ((seed >> 16) % 40);
+
+            for(size_t i = 0; i < count; i++) {
+                batch[i] = round * 100 + i;
+            }
+
+            assertEquals(dlist_insert_range(list, pos, batch, count), 0);
+            memmove(&array[pos + count], &array[pos], (length - pos) * sizeof(int));
+            memcpy(&array[pos], batch, count * sizeof(int));
+            length += count;
+            assertEquals(dlist_verify(list), 0);
+
+            int next = -round;
+            assertEquals(dlist_generate(list, 3, index_count_up, &next), 0);
+            for(int i = 0; i < 3; i++) {
+                array[length++] = -round + i;
+            }
+            assertEquals(dlist_verify(list), 0);
+        }
+
+        // move a range into another indexed list and back
+        assertEquals(dlist_insert_range(other, 0, batch, 10), 0);
+        assertEquals(dlist_splice(other, 5, list, 100, 50), 0);
+        assertEquals(dlist_verify(list), 0);
+        assertEquals(dlist_verify(other), 0);
+        assertEquals(dlist_length(other), 60);
+
+        assertEquals(dlist_splice(list, 100, other, 5, 50), 0);
+        assertEquals(dlist_verify(list), 0);
+        assertEquals(dlist_verify(other), 0);
+
+        // split off the end and join it again
+        dlist_t *half = dlist_split(list, length / 2);
+        assertNotEquals(half, NULL);
+        assertEquals(dlist_verify(list), 0);
+        assertEquals(dlist_join(list, half), list);
+        assertEquals(dlist_verify(list), 0);
+        dlist_free(half);
+
+        assertEquals(dlist_join(list, other), list);
+        assertEquals(dlist_verify(list), 0);
+        memcpy(&array[length], batch, 10 * sizeof(int));
+        length += 10;
+        dlist_free(other);
+
+        assertEquals(dlist_length(list), length);
+        for(size_t i = 0; i < length; i++) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, array[i]);
+        }
+    }
+}
+
+TEST(index_is_rebuilt_after_bulk_operations) {
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_index_enable(list), 0);
+
+        for(int i = 0; i < 1000; i++) {
+            dlist_append(list, &i);
+        }
+
+        dlist_t *half = dlist_split(list, 500);
+        assertNotEquals(half, NULL);
+        assertNotEquals(dlist_get(list, 499, &ret), NULL);
+        assertEquals(ret, 499);
+        assertEquals(dlist_verify(list), 0);
+
+        assertEquals(dlist_join(list, half), list);
+        assertNotEquals(dlist_get(list, 750, &ret), NULL);
+        assertEquals(ret, 750);
+        assertEquals(dlist_verify(list), 0);
+        dlist_free(half);
+
+        assertEquals(dlist_reverse(list), 0);
+        for(int i = 0; i < 1000; i += 11) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, 999 - i);
+        }
+        assertEquals(dlist_verify(list), 0);
+    }
+}
@@ -0,0 +1,113 @@
+#include "helpers.h"
+
+struct counting {
+    size_t allocs;
+    size_t frees;
+    size_t bytes;
+};
+
+static void *counting_alloc(void *ctx, size_t size) {
+    struct counting *counting = ctx;
+    counting->allocs++;
+    counting->bytes += size;
+    return malloc(size);
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+    struct counting *counting = ctx;
+    counting->frees++;
+    counting->bytes -= size;
+    free(ptr);
+}
+
+TEST(init_allocator_works_with_all_sizes)
+{
+    struct counting counting = {0, 0, 0};
+    allocator_t allocator = {counting_alloc, counting_free, &counting};
+
+    dlist_t *list = dlist_new_allocator(sizeof(int), &allocator);
+    assertNotEquals(list, NULL);
+    assertEquals(list->allocator, &allocator);
+    assertEquals(dlist_size(list), sizeof(int));
+    assertEquals(counting.allocs, 1);
+    assertEquals(dlist_free(list), 0);
+    assertEquals(counting.frees, 1);
+    assertEquals(counting.bytes, 0);
+
+    // NULL means malloc()
+    USING(dlist_new_allocator(56, NULL)) {
+        assertEquals(list->allocator, NULL);
+        assertEquals(dlist_size(list), 56);
+        assertNotEquals(dlist_append(list, NULL), NULL);
+    }
+}
+
+TEST(init_allocator_is_used_for_all_nodes)
+{
+    struct counting counting = {0, 0, 0};
+    allocator_t allocator = {counting_alloc, counting_free, &counting};
+
+    dlist_t local;
+    assertEquals(dlist_init_allocator(&local, sizeof(int), &allocator), &local);
+
+    for(int i = 0; i < 10; i++) {
+        assertNotEquals(dlist_append(&local, &i), NULL);
+    }
+
+    assertEquals(counting.allocs, 10);
+    assertEquals(dlist_remove(&local, 3), 0);
+    assertEquals(dlist_pop(&local, NULL), NULL);
+    assertEquals(counting.frees, 2);
+
+    // split off and copied lists use the allocator too
+    dlist_t *half = dlist_split(&local, 4);
+    assertNotEquals(half, NULL);
+    assertEquals(half->allocator, &allocator);
+    dlist_t *copy = dlist_copy(half);
+    assertNotEquals(copy, NULL);
+    assertEquals(copy->allocator, &allocator);
+    assertEquals(dlist_join(&local, copy), &local);
+    assertEquals(dlist_verify(&local), 0);
+    assertEquals(dlist_length(&local), 8);
+
+    // can't join lists with different allocators
+    dlist_t *plain = dlist_new(sizeof(int));
+    assertNotEquals(dlist_append(plain, &ret), NULL);
+    assertEquals(dlist_join(&local, plain), NULL);
+    assertEquals(dlist_join(plain, half), NULL);
+    dlist_free(plain);
+
+    assertEquals(dlist_free(half), 0);
+    assertEquals(dlist_free(copy), 0);
+    dlist_purge(&local);
+
+    assertEquals(counting.allocs, counting.frees);
+    assertEquals(counting.bytes, 0);
+}
+
+TEST(init_allocator_without_free_skips_purge)
+{
+    struct counting counting = {0, 0, 0};
+    allocator_t allocator = {counting_alloc, NULL, &counting};
+
+    // nodes are kept in an array so the test can
+    // release them itself
+    void *nodes[10];
+
+    dlist_t local;
+    assertEquals(dlist_init_allocator(&local, sizeof(int), &allocator), &local);
+
+    for(int i = 0; i < 10; i++) {
+        assertNotEquals(dlist_append(&local, &i), NULL);
+        nodes[i] = local.tail;
+    }
+
+    assertEquals(dlist_purge(&local), &local);
+    assertEquals(dlist_length(&local), 0);
+    assertEquals(counting.allocs, 10);
+    assertEquals(counting.frees, 0);
+
+    for(int i = 0; i < 10; i++) {
+        free(nodes[i]);
+    }
+}
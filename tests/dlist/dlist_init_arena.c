@@ -0,0 +1,77 @@
+#include "helpers.h"
+
+TEST(init_arena_does_not_work_without_arena)
+{
+    dlist_t local;
+    assertEquals(dlist_init_arena(&local, sizeof(int), NULL), NULL);
+    assertEquals(dlist_new_arena(sizeof(int), NULL), NULL);
+}
+
+TEST(init_arena_works_with_all_sizes)
+{
+    arena_t *arena = arena_new(0);
+    assertNotEquals(arena, NULL);
+
+    dlist_t local;
+    assertEquals(dlist_init_arena(&local, sizeof(int), arena), &local);
+    assertEquals(local.arena, arena);
+    assertEquals(dlist_size(&local), sizeof(int));
+    assertEquals(dlist_length(&local), 0);
+
+    dlist_t *list = dlist_new_arena(56, arena);
+    assertNotEquals(list, NULL);
+    assertEquals(list->arena, arena);
+    assertEquals(dlist_size(list), 56);
+    assertEquals(dlist_length(list), 0);
+    assertEquals(dlist_free(list), 0);
+
+    arena_free(arena);
+}
+
+TEST(init_arena_lists_are_released_by_reset)
+{
+    arena_t *arena = arena_new(128);
+    assertNotEquals(arena, NULL);
+
+    for(int round = 0; round < 3; round++) {
+        dlist_t *list = dlist_new_arena(sizeof(int), arena);
+        assertNotEquals(list, NULL);
+
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(dlist_append(list, &i), NULL);
+        }
+
+        assertEquals(dlist_verify(list), 0);
+        assertEquals(dlist_remove(list, 50), 0);
+        assertEquals(dlist_pop(list, &ret), &ret);
+        assertEquals(ret, 0);
+        assertEquals(*((int*)dlist_get(list, 50, NULL)), 52);
+
+        // split and copy stay in the arena
+        dlist_t *half = dlist_split(list, 49);
+        assertNotEquals(half, NULL);
+        assertEquals(half->arena, arena);
+        dlist_t *copy = dlist_copy(half);
+        assertNotEquals(copy, NULL);
+        assertEquals(copy->arena, arena);
+        assertEquals(dlist_join(list, copy), list);
+        assertEquals(dlist_length(list), 98);
+        assertEquals(dlist_verify(list), 0);
+
+        // can't mix arena and heap nodes
+        dlist_t *heap = dlist_new(sizeof(int));
+        assertNotEquals(dlist_append(heap, &ret), NULL);
+        assertEquals(dlist_join(list, heap), NULL);
+        assertEquals(dlist_join(heap, half), NULL);
+        dlist_free(heap);
+
+        // purging doesn't free anything
+        assertEquals(dlist_purge(list), list);
+        assertEquals(dlist_length(list), 0);
+        assertEquals(dlist_free(half), 0);
+
+        arena_reset(arena);
+    }
+
+    arena_free(arena);
+}
@@ -0,0 +1,102 @@
+#include "helpers.h"
+
+TEST(init_pooled_works_with_all_sizes)
+{
+    USING(dlist_new_pooled(sizeof(int), 0)) {
+        assertNotEquals(list, NULL);
+        assertNotEquals(list->pool, NULL);
+        assertEquals(dlist_size(list), sizeof(int));
+        assertEquals(dlist_length(list), 0);
+    }
+
+    USING(malloc(sizeof(dlist_t))) {
+        assertEquals(dlist_init_pooled(list, 56, 4), list);
+        assertNotEquals(list->pool, NULL);
+        assertEquals(dlist_size(list), 56);
+        assertEquals(dlist_length(list), 0);
+    }
+}
+
+TEST(init_pooled_recycles_nodes)
+{
+    USING(dlist_new_pooled(sizeof(int), 4)) {
+        int one = 1, two = 2;
+
+        // popped nodes get reused
+        void *first = dlist_append(list, &one);
+        assertNotEquals(first, NULL);
+        assertEquals(dlist_pop(list, &ret), &ret);
+        assertEquals(ret, one);
+        assertEquals(dlist_append(list, &two), first);
+        assertEquals(dlist_pop(list, NULL), NULL);
+
+        // more nodes than fit into a slab
+        for(int i = 0; i < 10; i++) {
+            assertNotEquals(dlist_append(list, &i), NULL);
+        }
+
+        assertEquals(dlist_verify(list), 0);
+        assertEquals(dlist_length(list), 10);
+
+        for(int i = 0; i < 10; i++) {
+            assertEquals(*((int*)dlist_get(list, i, NULL)), i);
+        }
+
+        assertEquals(dlist_remove(list, 5), 0);
+        assertEquals(dlist_remove(list, 0), 0);
+        assertEquals(dlist_length(list), 8);
+        assertEquals(dlist_verify(list), 0);
+
+        dlist_purge(list);
+        assertNotEquals(list->pool, NULL);
+        assertEquals(dlist_length(list), 0);
+    }
+}
+
+TEST(init_pooled_split_and_join_share_nodes)
+{
+    USING(dlist_new_pooled(sizeof(int), 4)) {
+        for(int i = 0; i < 6; i++) {
+            assertNotEquals(dlist_append(list, &i), NULL);
+        }
+
+        // split off list shares the pool
+        dlist_t *half = dlist_split(list, 3);
+        assertNotEquals(half, NULL);
+        assertEquals(half->pool, list->pool);
+        assertEquals(dlist_length(half), 3);
+
+        // join with a list without a pool
+        dlist_t *plain = dlist_new(sizeof(int));
+        assertNotEquals(dlist_append(plain, &ret), NULL);
+        assertEquals(dlist_join(plain, half), plain);
+        assertEquals(plain->pool, list->pool);
+        assertEquals(dlist_length(plain), 4);
+        assertEquals(dlist_verify(plain), 0);
+        dlist_free(half);
+
+        // join with a list from another pool
+        dlist_t *other = dlist_new_pooled(sizeof(int), 2);
+        assertNotEquals(dlist_append(other, &ret), NULL);
+        assertEquals(dlist_join(list, other), list);
+        assertEquals(dlist_length(list), 4);
+        assertEquals(dlist_verify(list), 0);
+        dlist_free(other);
+
+        assertEquals(dlist_join(list, plain), list);
+        assertEquals(dlist_length(list), 8);
+        assertEquals(*((int*)dlist_get(list, 5, NULL)), 3);
+        dlist_free(plain);
+
+        // copies share the pool as well
+        dlist_t *copy = dlist_copy(list);
+        assertNotEquals(copy, NULL);
+        assertEquals(dlist_length(copy), 8);
+        assertEquals(dlist_verify(copy), 0);
+        dlist_free(copy);
+
+        while(dlist_length(list) > 0) {
+            assertEquals(dlist_remove(list, dlist_length(list) - 1), 0);
+        }
+    }
+}
@@ -0,0 +1,95 @@
+#include "helpers.h"
+
+TEST(pop_many_works_on_empty_list) {
+    int out[4];
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_pop_many(list, out, 4), 0);
+        assertEquals(dlist_pop_many(list, NULL, 4), 0);
+    }
+}
+
+TEST(pop_many_pops_in_batches) {
+    int out[8];
+
+    USING(dlist_new(sizeof(int))) {
+        for(int i = 0; i < 20; i++) {
+            dlist_append(list, &i);
+        }
+
+        assertNotEquals(dlist_get(list, 10, NULL), NULL);
+
+        // full batches
+        for(int batch = 0; batch < 2; batch++) {
+            assertEquals(dlist_pop_many(list, out, 8), 8);
+
+            for(int i = 0; i < 8; i++) {
+                assertEquals(out[i], batch * 8 + i);
+            }
+
+            assertEquals(dlist_verify(list), 0);
+        }
+
+        assertEquals(dlist_length(list), 4);
+        assertEquals(*((int*) dlist_first(list)), 16);
+        assertNotEquals(dlist_get(list, 1, &ret), NULL);
+        assertEquals(ret, 17);
+
+        // the last batch is short
+        assertEquals(dlist_pop_many(list, out, 8), 4);
+        for(int i = 0; i < 4; i++) {
+            assertEquals(out[i], 16 + i);
+        }
+
+        assertEquals(dlist_length(list), 0);
+        assertEquals(dlist_first(list), NULL);
+        assertEquals(dlist_last(list), NULL);
+    }
+
+    USING(dlist_new_pooled(sizeof(int), 4)) {
+        for(int i = 0; i < 10; i++) {
+            dlist_append(list, &i);
+        }
+
+        // elements can be discarded
+        assertEquals(dlist_pop_many(list, NULL, 3), 3);
+        assertEquals(dlist_pop_many(list, out, 1), 1);
+        assertEquals(out[0], 3);
+        assertEquals(dlist_length(list), 6);
+    }
+}
+
+TEST(pop_back_many_pops_in_batches) {
+    int out[8];
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_pop_back_many(list, out, 8), 0);
+
+        for(int i = 0; i < 12; i++) {
+            dlist_append(list, &i);
+        }
+
+        assertEquals(dlist_index_enable(list), 0);
+        assertNotEquals(dlist_get(list, 6, NULL), NULL);
+
+        // the last element comes first
+        assertEquals(dlist_pop_back_many(list, out, 8), 8);
+        for(int i = 0; i < 8; i++) {
+            assertEquals(out[i], 11 - i);
+        }
+
+        assertEquals(dlist_verify(list), 0);
+        assertEquals(*((int*) dlist_last(list)), 3);
+        assertNotEquals(dlist_get(list, 2, &ret), NULL);
+        assertEquals(ret, 2);
+
+        assertEquals(dlist_pop_back_many(list, out, 8), 4);
+        for(int i = 0; i < 4; i++) {
+            assertEquals(out[i], 3 - i);
+        }
+
+        assertEquals(dlist_length(list), 0);
+        assertEquals(dlist_first(list), NULL);
+        assertEquals(dlist_last(list), NULL);
+    }
+}
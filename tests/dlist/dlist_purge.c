@@ -37,3 +37,31 @@ TEST(purge_removes_all_elements_of_list) {
         assertEquals(dlist_size(list), sizeof(int));
     }
 }
+
+TEST(purge_keeps_pool_of_pooled_list)
+{
+    USING(dlist_new_pooled(sizeof(int), 4)) {
+        pool_t *pool = list->pool;
+
+        for(int i = 0; i < 6; i++) {
+            assertNotEquals(dlist_append(list, &i), NULL);
+        }
+
+        void *first = dlist_get(list, 0, NULL);
+        assertEquals(dlist_purge(list), list);
+        assertEquals(dlist_length(list), 0);
+        assertEquals(list->pool, pool);
+
+        // the nodes are reused instead of allocated again
+        int value = 7;
+        assertEquals(dlist_append(list, &value), first);
+        assertEquals(dlist_length(list), 1);
+        assertEquals(*((int*)dlist_get(list, 0, NULL)), value);
+
+        // releasing drops the pool
+        assertEquals(dlist_release(list), list);
+        assertEquals(list->pool, NULL);
+        assertEquals(dlist_length(list), 0);
+        assertNotEquals(dlist_append(list, &value), NULL);
+    }
+}
@@ -0,0 +1,164 @@
+#include "helpers.h"
+
+// checks that list holds exactly the given elements
+static int dlist_holds(dlist_t *list, const int *expected, size_t count) {
+    if(dlist_length(list) != count || dlist_verify(list) != 0) {
+        return 0;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        if(dlist_get(list, i, &ret) == NULL || ret != expected[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+TEST(range_functions_do_not_work_on_illegal_ranges) {
+    int data[4] = { 0 };
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_insert_range(list, 0, data, 4), 0);
+
+        assertEquals(dlist_get_range(list, 2, 3, data), NULL);
+        assertEquals(dlist_get_range(list, 5, 0, data), NULL);
+        assertEquals(dlist_get_range(list, 0, 1, NULL), NULL);
+        assertNotEquals(dlist_set_range(list, 3, 2, data), 0);
+        assertNotEquals(dlist_set_range(list, 0, 1, NULL), 0);
+        assertNotEquals(dlist_insert_range(list, 5, data, 1), 0);
+        assertNotEquals(dlist_remove_range(list, 1, 4), 0);
+        assertNotEquals(dlist_remove_range(list, 5, 0), 0);
+
+        // empty ranges are fine
+        assertEquals(dlist_get_range(list, 4, 0, data), data);
+        assertEquals(dlist_set_range(list, 4, 0, data), 0);
+        assertEquals(dlist_insert_range(list, 4, data, 0), 0);
+        assertEquals(dlist_remove_range(list, 4, 0), 0);
+
+        assertEquals(dlist_length(list), 4);
+    }
+}
+
+TEST(get_and_set_range_work_correctly) {
+    int data[10], out[10];
+
+    USING(dlist_new(sizeof(int))) {
+        for(int i = 0; i < 10; i++) {
+            dlist_append(list, &i);
+            data[i] = 100 + i;
+        }
+
+        assertEquals(dlist_get_range(list, 0, 10, out), out);
+        for(int i = 0; i < 10; i++) {
+            assertEquals(out[i], i);
+        }
+
+        assertEquals(dlist_set_range(list, 3, 4, data), 0);
+        assertEquals(dlist_get_range(list, 2, 6, out), out);
+
+        int expected[] = { 2, 100, 101, 102, 103, 7 };
+        for(int i = 0; i < 6; i++) {
+            assertEquals(out[i], expected[i]);
+        }
+
+        // reading consecutive windows
+        for(int i = 0; i < 10; i += 2) {
+            assertEquals(dlist_get_range(list, i, 2, out), out);
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(out[0], ret);
+            assertNotEquals(dlist_get(list, i + 1, &ret), NULL);
+            assertEquals(out[1], ret);
+        }
+    }
+}
+
+TEST(insert_range_works_correctly) {
+    int batch[] = { 10, 11, 12 };
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_insert_range(list, 0, batch, 3), 0);
+        assertEquals(dlist_insert_range(list, 3, batch, 2), 0);
+        assertEquals(dlist_insert_range(list, 1, batch + 2, 1), 0);
+        assertEquals(dlist_insert_range(list, 0, batch + 1, 2), 0);
+
+        int expected[] = { 11, 12, 10, 12, 11, 12, 10, 11 };
+        assertTrue(dlist_holds(list, expected, 8));
+        assertEquals(*((int*) dlist_last(list)), 11);
+    }
+
+    USING(dlist_new_pooled(sizeof(int), 4)) {
+        int many[100];
+        for(int i = 0; i < 100; i++) {
+            many[i] = i;
+        }
+
+        // the nodes come from one slab, in order
+        assertEquals(dlist_insert_range(list, 0, many, 100), 0);
+        assertTrue(dlist_holds(list, many, 100));
+
+        char *first = (char*) list->head;
+        size_t stride = (char*) list->head->next - first;
+        assertEquals((char*) list->tail, first + 99 * stride);
+
+        // without data, elements are not initialized
+        assertEquals(dlist_insert_range(list, 50, NULL, 10), 0);
+        assertEquals(dlist_length(list), 110);
+    }
+}
+
+TEST(remove_range_works_correctly) {
+    USING(dlist_new(sizeof(int))) {
+        for(int i = 0; i < 10; i++) {
+            dlist_append(list, &i);
+        }
+
+        assertNotEquals(dlist_get(list, 8, NULL), NULL);
+        assertEquals(dlist_remove_range(list, 3, 4), 0);
+
+        int middle[] = { 0, 1, 2, 7, 8, 9 };
+        assertTrue(dlist_holds(list, middle, 6));
+
+        assertEquals(dlist_remove_range(list, 4, 2), 0);
+        int end[] = { 0, 1, 2, 7 };
+        assertTrue(dlist_holds(list, end, 4));
+        assertEquals(*((int*) dlist_last(list)), 7);
+
+        assertEquals(dlist_remove_range(list, 0, 2), 0);
+        int start[] = { 2, 7 };
+        assertTrue(dlist_holds(list, start, 2));
+
+        assertEquals(dlist_remove_range(list, 0, 2), 0);
+        assertEquals(dlist_length(list), 0);
+        assertEquals(dlist_first(list), NULL);
+        assertEquals(dlist_last(list), NULL);
+    }
+}
+
+TEST(range_functions_keep_index_usable) {
+    int batch[50];
+    for(int i = 0; i < 50; i++) {
+        batch[i] = -i;
+    }
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_index_enable(list), 0);
+
+        for(int i = 0; i < 2000; i++) {
+            dlist_append(list, &i);
+        }
+
+        assertNotEquals(dlist_get(list, 1000, NULL), NULL);
+        assertEquals(dlist_insert_range(list, 1000, batch, 50), 0);
+        assertNotEquals(dlist_get(list, 1049, &ret), NULL);
+        assertEquals(ret, -49);
+        assertNotEquals(dlist_get(list, 1050, &ret), NULL);
+        assertEquals(ret, 1000);
+        assertEquals(dlist_verify(list), 0);
+
+        assertEquals(dlist_remove_range(list, 500, 550), 0);
+        assertNotEquals(dlist_get(list, 500, &ret), NULL);
+        assertEquals(ret, 1000);
+        assertEquals(dlist_verify(list), 0);
+    }
+}
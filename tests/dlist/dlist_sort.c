@@ -0,0 +1,229 @@
+#include "helpers.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// orders ints ascending, see dlist_compare_elements
+static int compare_ints(void *a, void *b) {
+    return *((int*)b) - *((int*)a);
+}
+
+// pairs of a key to sort by and the original position
+struct pair {
+    int key;
+    int pos;
+};
+
+static int compare_keys(void *a, void *b) {
+    return ((struct pair*)b)->key - ((struct pair*)a)->key;
+}
+
+TEST(sort_does_not_work_without_compare) {
+    USING(dlist_new(sizeof(int))) {
+        assertTrue(dlist_sort(list, NULL) < 0);
+        assertTrue(dlist_sort(NULL, compare_ints) < 0);
+    }
+}
+
+TEST(sort_works_on_short_lists) {
+    int one = 1;
+
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_sort(list, compare_ints), 0);
+        assertEquals(dlist_length(list), 0);
+
+        dlist_append(list, &one);
+        assertEquals(dlist_sort(list, compare_ints), 0);
+        assertEquals(dlist_length(list), 1);
+        assertEquals(*((int*)dlist_first(list)), 1);
+    }
+}
+
+TEST(sort_orders_elements) {
+    srand(9);
+
+    for(int length = 2; length < 1000; length = length * 2 + 1) {
+        USING(dlist_new(sizeof(int))) {
+            for(int i = 0; i < length; i++) {
+                int number = rand() % 100;
+                dlist_append(list, &number);
+            }
+
+            void *first = dlist_first(list);
+
+            assertEquals(dlist_sort(list, compare_ints), 0);
+            assertEquals(dlist_length(list), length);
+            assertEquals(dlist_verify(list), 0);
+
+            int last = -1;
+            for(int i = 0; i < length; i++) {
+                assertNotEquals(dlist_get(list, i, &ret), NULL);
+                assertTrue(last <= ret);
+                last = ret;
+            }
+
+            // nodes are relinked, not copied
+            int found = 0;
+            for(int i = 0; i < length; i++) {
+                if(dlist_get(list, i, NULL) == first) {
+                    found++;
+                }
+            }
+
+            assertEquals(found, 1);
+            assertEquals(*((int*)dlist_last(list)), last);
+        }
+    }
+}
+
+TEST(sort_is_stable) {
+    USING(dlist_new(sizeof(struct pair))) {
+        struct pair pair;
+
+        for(pair.pos = 0; pair.pos < 500; pair.pos++) {
+            pair.key = (pair.pos * 7) % 10;
+            dlist_append(list, &pair);
+        }
+
+        assertEquals(dlist_sort(list, compare_keys), 0);
+
+        struct pair last = {-1, -1};
+        for(int i = 0; i < 500; i++) {
+            assertNotEquals(dlist_get(list, i, &pair), NULL);
+            assertTrue(last.key <= pair.key);
+
+            if(last.key == pair.key) {
+                assertTrue(last.pos < pair.pos);
+            }
+
+            last = pair;
+        }
+    }
+}
+
+TEST(sort_keeps_index_usable) {
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_index_enable(list), 0);
+
+        for(int i = 0; i < 1000; i++) {
+            int number = 999 - i;
+            dlist_append(list, &number);
+        }
+
+        assertEquals(dlist_sort(list, compare_ints), 0);
+
+        for(int i = 0; i < 1000; i++) {
+            assertNotEquals(dlist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+        }
+
+        assertEquals(dlist_verify(list), 0);
+    }
+}
+
+TEST(sort_parallel_does_not_work_without_compare) {
+    USING(dlist_new(sizeof(int))) {
+        assertTrue(dlist_sort_parallel(list, NULL, 4) < 0);
+        assertTrue(dlist_sort_parallel(NULL, compare_ints, 4) < 0);
+        assertEquals(dlist_sort_parallel(list, compare_ints, 4), 0);
+    }
+}
+
+TEST(sort_parallel_orders_elements) {
+    srand(13);
+
+    // many, few and only one distinct key, the last ones
+    // leave some buckets empty
+    int keys[] = { 1000, 3, 1 };
+
+    for(size_t threads = 0; threads <= 9; threads++) {
+        USING(dlist_new(sizeof(struct pair))) {
+            struct pair pair;
+
+            for(pair.pos = 0; pair.pos < 50000; pair.pos++) {
+                pair.key = rand() % keys[threads % 3];
+                dlist_append(list, &pair);
+            }
+
+            assertEquals(dlist_sort_parallel(list, compare_keys, threads), 0);
+            assertEquals(dlist_length(list), 50000);
+
+            // sorted and stable
+            struct pair last = {-1, -1};
+            dlist_foreach(list, element) {
+                pair = *((struct pair*)element);
+                assertTrue(last.key <= pair.key);
+
+                if(last.key == pair.key) {
+                    assertTrue(last.pos < pair.pos);
+                }
+
+                last = pair;
+            }
+
+            assertEquals(((struct pair*)dlist_last(list))->pos, last.pos);
+        }
+    }
+}
+
+// records keyed by an unsigned integer
+struct record {
+    char tag;
+    uint64_t big;
+    uint16_t small;
+    int pos;
+};
+
+TEST(radix_sort_does_not_work_on_illegal_keys) {
+    USING(dlist_new(sizeof(struct record))) {
+        assertTrue(dlist_radix_sort(NULL, 0, 4) < 0);
+        assertTrue(dlist_radix_sort(list, 0, 3) < 0);
+        assertTrue(dlist_radix_sort(list, 0, 0) < 0);
+        assertTrue(dlist_radix_sort(list, sizeof(struct record) - 1, 2) < 0);
+        assertEquals(dlist_radix_sort(list, sizeof(struct record) - 2, 2), 0);
+    }
+}
+
+TEST(radix_sort_orders_elements) {
+    srand(17);
+
+    for(int length = 2; length < 5000; length = length * 3 + 1) {
+        USING(dlist_new(sizeof(struct record))) {
+            struct record record = {0};
+
+            for(record.pos = 0; record.pos < length; record.pos++) {
+                record.big = ((uint64_t) rand() << 40) ^ rand();
+                record.small = rand() % 50;
+                dlist_append(list, &record);
+            }
+
+            // sort by the 64 bit key
+            assertEquals(dlist_radix_sort(list, offsetof(struct record, big), sizeof(uint64_t)), 0);
+            assertEquals(dlist_length(list), length);
+            assertEquals(dlist_verify(list), 0);
+
+            uint64_t last = 0;
+            dlist_foreach(list, element) {
+                assertTrue(last <= ((struct record*)element)->big);
+                last = ((struct record*)element)->big;
+            }
+
+            assertEquals(((struct record*)dlist_last(list))->big, last);
+
+            // sort by the 16 bit key, which has many duplicates,
+            // and check that it is stable
+            assertEquals(dlist_radix_sort(list, offsetof(struct record, small), sizeof(uint16_t)), 0);
+
+            struct record prev = {0, 0, 0, -1};
+            dlist_foreach(list, element) {
+                record = *((struct record*)element);
+                assertTrue(prev.small <= record.small);
+
+                if(prev.small == record.small) {
+                    assertTrue(prev.big <= record.big);
+                }
+
+                prev = record;
+            }
+        }
+    }
+}
@@ -0,0 +1,154 @@
+#include "helpers.h"
+
+// fills list with count numbers, starting at first
+static void dlist_fill(dlist_t *list, int first, int count) {
+    for(int i = first; i < first + count; i++) {
+        dlist_append(list, &i);
+    }
+}
+
+// checks that list holds exactly the given elements
+static int dlist_holds(dlist_t *list, const int *expected, size_t count) {
+    if(dlist_length(list) != count || dlist_verify(list) != 0) {
+        return 0;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        if(dlist_get(list, i, &ret) == NULL || ret != expected[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+TEST(splice_does_not_work_on_illegal_ranges) {
+    dlist_t *other = dlist_new(sizeof(int));
+    dlist_fill(other, 10, 5);
+
+    USING(dlist_new(sizeof(int))) {
+        dlist_fill(list, 0, 5);
+
+        assertNotEquals(dlist_splice(list, 0, list, 1, 1), 0);
+        assertNotEquals(dlist_splice(list, 6, other, 0, 1), 0);
+        assertNotEquals(dlist_splice(list, 0, other, 6, 0), 0);
+        assertNotEquals(dlist_splice(list, 0, other, 3, 3), 0);
+        assertEquals(dlist_splice(list, 0, other, 5, 0), 0);
+
+        assertEquals(dlist_length(list), 5);
+        assertEquals(dlist_length(other), 5);
+    }
+
+    USING(dlist_new(sizeof(char))) {
+        assertNotEquals(dlist_splice(list, 0, other, 0, 1), 0);
+    }
+
+    dlist_free(other);
+}
+
+TEST(splice_moves_nodes_without_copying) {
+    USING(dlist_new(sizeof(int))) {
+        dlist_t *other = dlist_new(sizeof(int));
+        dlist_fill(list, 0, 5);
+        dlist_fill(other, 10, 5);
+
+        void *moved = dlist_get(other, 1, NULL);
+
+        // move the middle of other into the middle of list
+        assertEquals(dlist_splice(list, 2, other, 1, 3), 0);
+        assertEquals(dlist_get(list, 2, NULL), moved);
+
+        int expected[] = { 0, 1, 11, 12, 13, 2, 3, 4 };
+        assertTrue(dlist_holds(list, expected, 8));
+
+        int rest[] = { 10, 14 };
+        assertTrue(dlist_holds(other, rest, 2));
+
+        // move the tail of list to the front of other
+        assertEquals(dlist_splice(other, 0, list, 6, 2), 0);
+        int tail[] = { 3, 4, 10, 14 };
+        assertTrue(dlist_holds(other, tail, 4));
+        assertEquals(*((int*) dlist_last(list)), 2);
+
+        // move everything to the end of list
+        assertEquals(dlist_splice(list, 6, other, 0, 4), 0);
+        int all[] = { 0, 1, 11, 12, 13, 2, 3, 4, 10, 14 };
+        assertTrue(dlist_holds(list, all, 10));
+        assertTrue(dlist_holds(other, NULL, 0));
+        assertEquals(dlist_first(other), NULL);
+        assertEquals(dlist_last(other), NULL);
+
+        // and into an empty list
+        assertEquals(dlist_splice(other, 0, list, 0, 10), 0);
+        assertTrue(dlist_holds(other, all, 10));
+        assertTrue(dlist_holds(list, NULL, 0));
+
+        dlist_free(other);
+    }
+}
+
+TEST(splice_works_with_pools) {
+    USING(dlist_new_pooled(sizeof(int), 4)) {
+        dlist_t *other = dlist_new_pooled(sizeof(int), 4);
+        dlist_fill(list, 0, 10);
+        dlist_fill(other, 10, 10);
+
+        assertEquals(dlist_splice(list, 10, other, 0, 10), 0);
+        assertEquals(dlist_length(list), 20);
+
+        // nodes from either pool can be released by either list
+        assertEquals(dlist_splice(other, 0, list, 5, 10), 0);
+        assertEquals(dlist_free(other), 0);
+    }
+}
+
+TEST(splice_at_moves_range_between_cursors) {
+    dlist_cursor_t dest, first, end;
+
+    USING(dlist_new(sizeof(int))) {
+        dlist_t *other = dlist_new(sizeof(int));
+        dlist_fill(list, 0, 5);
+        dlist_fill(other, 10, 5);
+
+        assertEquals(dlist_index_enable(list), 0);
+        assertNotEquals(dlist_get(list, 3, NULL), NULL);
+
+        assertEquals(dlist_cursor_init(&dest, list, 3), 0);
+        assertEquals(dlist_cursor_init(&first, other, 1), 0);
+        assertEquals(dlist_cursor_init(&end, other, 4), 0);
+
+        // cursors must be in the right order and lists
+        assertNotEquals(dlist_splice_at(&dest, &end, &first), 0);
+        assertNotEquals(dlist_splice_at(&dest, &first, &dest), 0);
+        assertNotEquals(dlist_splice_at(&first, &first, &end), 0);
+
+        assertEquals(dlist_splice_at(&dest, &first, &end), 0);
+
+        int expected[] = { 0, 1, 2, 11, 12, 13, 3, 4 };
+        assertTrue(dlist_holds(list, expected, 8));
+
+        int rest[] = { 10, 14 };
+        assertTrue(dlist_holds(other, rest, 2));
+
+        // the cursors were updated
+        assertEquals(dlist_cursor_pos(&dest), 6);
+        assertEquals(*((int*) dlist_cursor_get(&dest)), 3);
+        assertEquals(dlist_cursor_pos(&first), 1);
+        assertEquals(*((int*) dlist_cursor_get(&first)), 14);
+        assertEquals(dlist_cursor_pos(&end), 1);
+        assertEquals(dlist_cursor_get(&end), dlist_cursor_get(&first));
+
+        // move the rest of list to the end of other
+        assertEquals(dlist_cursor_init(&dest, other, 2), 0);
+        assertEquals(dlist_cursor_init(&first, list, 6), 0);
+        assertEquals(dlist_cursor_init(&end, list, 8), 0);
+        assertEquals(dlist_splice_at(&dest, &first, &end), 0);
+
+        int tail[] = { 10, 14, 3, 4 };
+        assertTrue(dlist_holds(other, tail, 4));
+        assertEquals(*((int*) dlist_last(list)), 13);
+        assertEquals(dlist_verify(list), 0);
+
+        dlist_free(other);
+    }
+}
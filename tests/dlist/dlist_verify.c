@@ -0,0 +1,75 @@
+#include "helpers.h"
+
+TEST(verify_finds_cycles) {
+    USING(dlist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            dlist_append(list, &i);
+        }
+
+        // point the tail back into the middle
+        dlist_node_t *middle = list->head->next->next;
+        list->tail->next = middle;
+        assertTrue(dlist_verify(list) < 0);
+
+        // or make a loop before reaching the tail
+        list->tail->next = NULL;
+        dlist_node_t *next = middle->next;
+        middle->next = list->head;
+        assertTrue(dlist_verify(list) < 0);
+
+        middle->next = next;
+        assertEquals(dlist_verify(list), 0);
+    }
+}
+
+TEST(verify_finds_broken_prev_pointers) {
+    USING(dlist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            dlist_append(list, &i);
+        }
+
+        dlist_node_t *node = list->tail->prev->prev;
+        dlist_node_t *prev = node->prev;
+
+        node->prev = list->head;
+        assertTrue(dlist_verify(list) < 0);
+
+        node->prev = prev;
+        list->head->prev = list->tail;
+        assertTrue(dlist_verify(list) < 0);
+
+        list->head->prev = NULL;
+        assertEquals(dlist_verify(list), 0);
+    }
+}
+
+TEST(verify_finds_wrong_length_and_tail) {
+    USING(dlist_new(sizeof(int))) {
+        assertEquals(dlist_verify(list), 0);
+
+        for(int i = 0; i < 100; i++) {
+            dlist_append(list, &i);
+        }
+
+        list->length++;
+        assertTrue(dlist_verify(list) < 0);
+        list->length -= 2;
+        assertTrue(dlist_verify(list) < 0);
+        list->length++;
+
+        dlist_node_t *tail = list->tail;
+        list->tail = list->tail->prev;
+        assertTrue(dlist_verify(list) < 0);
+        list->tail = tail;
+    }
+}
+
+TEST(verify_works_on_large_list) {
+    USING(dlist_new(sizeof(int))) {
+        for(int i = 0; i < 1000000; i++) {
+            dlist_append(list, &i);
+        }
+
+        assertEquals(dlist_verify(list), 0);
+    }
+}
@@ -27,9 +27,25 @@ TEST(new_sets_all_pointers_to_null);
 TEST(init_works_with_all_sizes);
 TEST(init_sets_all_pointers_to_null);
 
+/* dlist_init_pooled() */
+TEST(init_pooled_works_with_all_sizes);
+TEST(init_pooled_recycles_nodes);
+TEST(init_pooled_split_and_join_share_nodes);
+
+/* dlist_init_arena() */
+TEST(init_arena_does_not_work_without_arena);
+TEST(init_arena_works_with_all_sizes);
+TEST(init_arena_lists_are_released_by_reset);
+
+/* dlist_init_allocator() */
+TEST(init_allocator_works_with_all_sizes);
+TEST(init_allocator_is_used_for_all_nodes);
+TEST(init_allocator_without_free_skips_purge);
+
 /* dlist_purge() */
 TEST(purge_does_nothing_on_empty_list);
 TEST(purge_removes_all_elements_of_list);
+TEST(purge_keeps_pool_of_pooled_list);
 
 /* dlist_free() */
 
@@ -48,17 +64,37 @@ TEST(insert_works_without_data);
 TEST(insert_returns_null_on_illegal);
 TEST(insert_works_with_data);
 
+/* dlist_append_with(), dlist_prepend_with(), dlist_insert_with() */
+TEST(append_with_builds_elements_in_place);
+TEST(append_with_does_not_add_failed_elements);
+
+/* dlist_generate() */
+TEST(generate_appends_elements);
+TEST(generate_does_not_add_anything_on_failure);
+
 /* dlist_remove() */
 TEST(remove_on_empty_list_does_not_work);
 TEST(remove_in_beginning_works);
 TEST(remove_at_end_works);
 TEST(remove_in_middle_works);
 
+/* dlist_get_range(), dlist_set_range(), dlist_insert_range(), dlist_remove_range() */
+TEST(range_functions_do_not_work_on_illegal_ranges);
+TEST(get_and_set_range_work_correctly);
+TEST(insert_range_works_correctly);
+TEST(remove_range_works_correctly);
+TEST(range_functions_keep_index_usable);
+
 /* dlist_pop() */
 TEST(pop_works_on_empty_list);
 TEST(pop_works_on_single_list);
 TEST(pop_works_on_full_list);
 
+/* dlist_pop_many() */
+TEST(pop_many_works_on_empty_list);
+TEST(pop_many_pops_in_batches);
+TEST(pop_back_many_pops_in_batches);
+
 /* dlist_set() */
 TEST(set_does_not_work_for_empty_list);
 TEST(set_does_not_work_for_illegal_index);
@@ -88,9 +124,80 @@ TEST(join_does_not_work_on_different_element_sizes);
 TEST(join_works_on_empty_lists);
 TEST(join_works_on_full_lists);
 
+/* dlist_splice() */
+TEST(splice_does_not_work_on_illegal_ranges);
+TEST(splice_moves_nodes_without_copying);
+TEST(splice_works_with_pools);
+TEST(splice_at_moves_range_between_cursors);
+
+/* dlist_partition() */
+TEST(partition_does_not_work_on_illegal_outputs);
+TEST(partition_moves_nodes_in_order);
+TEST(partition_keeps_unclassified_elements);
+
 /* dlist_copy() */
 TEST(copy_works_on_empty_list);
 TEST(copy_works_on_full_list);
+TEST(copy_lays_out_nodes_in_order);
+TEST(copy_can_be_modified_and_joined);
+
+/* dlist_from_array(), dlist_to_array() */
+TEST(from_array_does_not_work_without_data);
+TEST(from_array_copies_elements);
+TEST(from_array_lays_out_nodes_in_order);
+TEST(to_array_copies_elements);
+
+/* dlist_compact() */
+TEST(compact_does_not_work_on_arena_lists);
+TEST(compact_moves_nodes_into_one_block);
+TEST(compact_step_works_in_rounds);
+
+/* dlist_locality_stats() */
+TEST(locality_stats_does_not_work_on_null);
+TEST(locality_stats_measures_contiguous_list);
+TEST(locality_stats_sees_scattered_list);
+TEST(compact_keeps_index_usable);
+
+/* dlist_sort() */
+TEST(sort_does_not_work_without_compare);
+TEST(sort_works_on_short_lists);
+TEST(sort_orders_elements);
+TEST(sort_is_stable);
+TEST(sort_keeps_index_usable);
+TEST(sort_parallel_does_not_work_without_compare);
+TEST(sort_parallel_orders_elements);
+
+/* dlist_radix_sort() */
+TEST(radix_sort_does_not_work_on_illegal_keys);
+TEST(radix_sort_orders_elements);
+
+/* dlist_verify() */
+TEST(verify_finds_cycles);
+TEST(verify_finds_broken_prev_pointers);
+TEST(verify_finds_wrong_length_and_tail);
+TEST(verify_works_on_large_list);
+
+/* dlist_index_enable() */
+TEST(index_enable_and_disable_work);
+TEST(index_get_works_on_large_list);
+TEST(index_survives_mutations);
+TEST(index_survives_bulk_removal);
+TEST(index_survives_bulk_insertion);
+TEST(index_is_rebuilt_after_bulk_operations);
+
+/* dlist_cursor_init() */
+TEST(cursor_init_does_not_work_on_illegal_positions);
+TEST(cursor_moves_in_both_directions);
+TEST(cursor_insert_works_correctly);
+TEST(cursor_remove_works_correctly);
+TEST(cursor_move_to_front_works_correctly);
+TEST(cursor_keeps_index_usable);
+
+/* DLIST_DEFINE() */
+TEST(define_has_same_node_layout);
+TEST(define_basic_operations_work);
+TEST(define_sort_is_stable);
+TEST(define_find_works);
 
 TEST_SUITE(basic_data_access) {
     TEST_ADD(size_works_with_dlist_new),
@@ -112,8 +219,18 @@ TEST_SUITE(creation_destruction) {
     TEST_ADD(new_sets_all_pointers_to_null),
     TEST_ADD(init_works_with_all_sizes),
     TEST_ADD(init_sets_all_pointers_to_null),
+    TEST_ADD(init_pooled_works_with_all_sizes),
+    TEST_ADD(init_pooled_recycles_nodes),
+    TEST_ADD(init_pooled_split_and_join_share_nodes),
+    TEST_ADD(init_arena_does_not_work_without_arena),
+    TEST_ADD(init_arena_works_with_all_sizes),
+    TEST_ADD(init_arena_lists_are_released_by_reset),
+    TEST_ADD(init_allocator_works_with_all_sizes),
+    TEST_ADD(init_allocator_is_used_for_all_nodes),
+    TEST_ADD(init_allocator_without_free_skips_purge),
     TEST_ADD(purge_does_nothing_on_empty_list),
     TEST_ADD(purge_removes_all_elements_of_list),
+    TEST_ADD(purge_keeps_pool_of_pooled_list),
     TEST_SUITE_CLOSURE
 };
 
@@ -127,6 +244,10 @@ TEST_SUITE(insertion) {
     TEST_ADD(insert_works_without_data),
     TEST_ADD(insert_returns_null_on_illegal),
     TEST_ADD(insert_works_with_data),
+    TEST_ADD(append_with_builds_elements_in_place),
+    TEST_ADD(append_with_does_not_add_failed_elements),
+    TEST_ADD(generate_appends_elements),
+    TEST_ADD(generate_does_not_add_anything_on_failure),
     TEST_SUITE_CLOSURE
 };
 
@@ -134,6 +255,9 @@ TEST_SUITE(removal) {
     TEST_ADD(pop_works_on_empty_list),
     TEST_ADD(pop_works_on_single_list),
     TEST_ADD(pop_works_on_full_list),
+    TEST_ADD(pop_many_works_on_empty_list),
+    TEST_ADD(pop_many_pops_in_batches),
+    TEST_ADD(pop_back_many_pops_in_batches),
     TEST_ADD(remove_on_empty_list_does_not_work),
     TEST_ADD(remove_in_beginning_works),
     TEST_ADD(remove_at_end_works),
@@ -150,6 +274,11 @@ TEST_SUITE(accessing) {
     TEST_ADD(set_does_not_work_for_illegal_index),
     TEST_ADD(set_with_null_data_returns_null),
     TEST_ADD(set_works_with_data),
+    TEST_ADD(range_functions_do_not_work_on_illegal_ranges),
+    TEST_ADD(get_and_set_range_work_correctly),
+    TEST_ADD(insert_range_works_correctly),
+    TEST_ADD(remove_range_works_correctly),
+    TEST_ADD(range_functions_keep_index_usable),
     TEST_SUITE_CLOSURE
 };
 
@@ -165,8 +294,57 @@ TEST_SUITE(manipulation) {
     TEST_ADD(join_does_not_work_on_different_element_sizes),
     TEST_ADD(join_works_on_empty_lists),
     TEST_ADD(join_works_on_full_lists),
+    TEST_ADD(splice_does_not_work_on_illegal_ranges),
+    TEST_ADD(splice_moves_nodes_without_copying),
+    TEST_ADD(splice_works_with_pools),
+    TEST_ADD(splice_at_moves_range_between_cursors),
+    TEST_ADD(partition_does_not_work_on_illegal_outputs),
+    TEST_ADD(partition_moves_nodes_in_order),
+    TEST_ADD(partition_keeps_unclassified_elements),
     TEST_ADD(copy_works_on_empty_list),
     TEST_ADD(copy_works_on_full_list),
+    TEST_ADD(copy_lays_out_nodes_in_order),
+    TEST_ADD(copy_can_be_modified_and_joined),
+    TEST_ADD(from_array_does_not_work_without_data),
+    TEST_ADD(from_array_copies_elements),
+    TEST_ADD(from_array_lays_out_nodes_in_order),
+    TEST_ADD(to_array_copies_elements),
+    TEST_ADD(compact_does_not_work_on_arena_lists),
+    TEST_ADD(compact_moves_nodes_into_one_block),
+    TEST_ADD(compact_step_works_in_rounds),
+    TEST_ADD(locality_stats_does_not_work_on_null),
+    TEST_ADD(locality_stats_measures_contiguous_list),
+    TEST_ADD(locality_stats_sees_scattered_list),
+    TEST_ADD(compact_keeps_index_usable),
+    TEST_ADD(sort_does_not_work_without_compare),
+    TEST_ADD(sort_works_on_short_lists),
+    TEST_ADD(sort_orders_elements),
+    TEST_ADD(sort_is_stable),
+    TEST_ADD(sort_keeps_index_usable),
+    TEST_ADD(sort_parallel_does_not_work_without_compare),
+    TEST_ADD(sort_parallel_orders_elements),
+    TEST_ADD(radix_sort_does_not_work_on_illegal_keys),
+    TEST_ADD(radix_sort_orders_elements),
+    TEST_ADD(verify_finds_cycles),
+    TEST_ADD(verify_finds_broken_prev_pointers),
+    TEST_ADD(verify_finds_wrong_length_and_tail),
+    TEST_ADD(verify_works_on_large_list),
+    TEST_ADD(index_enable_and_disable_work),
+    TEST_ADD(index_get_works_on_large_list),
+    TEST_ADD(index_survives_mutations),
+    TEST_ADD(index_survives_bulk_removal),
+    TEST_ADD(index_survives_bulk_insertion),
+    TEST_ADD(index_is_rebuilt_after_bulk_operations),
+    TEST_ADD(cursor_init_does_not_work_on_illegal_positions),
+    TEST_ADD(cursor_moves_in_both_directions),
+    TEST_ADD(cursor_insert_works_correctly),
+    TEST_ADD(cursor_remove_works_correctly),
+    TEST_ADD(cursor_move_to_front_works_correctly),
+    TEST_ADD(cursor_keeps_index_usable),
+    TEST_ADD(define_has_same_node_layout),
+    TEST_ADD(define_basic_operations_work),
+    TEST_ADD(define_sort_is_stable),
+    TEST_ADD(define_find_works),
     TEST_SUITE_CLOSURE
 };
 
@@ -0,0 +1,61 @@
+#include "helpers.h"
+
+// writes the next number into the element
+static int count_up(void *data, void *ctx) {
+    *((int*) data) = (*((int*) ctx))++;
+    return 0;
+}
+
+// like count_up, but fails once the number reaches 5
+static int count_up_to_five(void *data, void *ctx) {
+    if(*((int*) ctx) >= 5) {
+        return -1;
+    }
+
+    return count_up(data, ctx);
+}
+
+TEST(append_with_builds_elements_in_place) {
+    int next = 0;
+
+    USING(slist_new(sizeof(int))) {
+        assertEquals(slist_append_with(list, NULL, &next), NULL);
+
+        for(int i = 0; i < 3; i++) {
+            void *data = slist_append_with(list, count_up, &next);
+            assertNotEquals(data, NULL);
+            assertEquals(data, slist_last(list));
+        }
+
+        void *data = slist_prepend_with(list, count_up, &next);
+        assertNotEquals(data, NULL);
+        assertEquals(data, slist_first(list));
+
+        assertNotEquals(slist_insert_with(list, 2, count_up, &next), NULL);
+        assertNotEquals(slist_insert_with(list, 5, count_up, &next), NULL);
+        assertEquals(slist_insert_with(list, 7, count_up, &next), NULL);
+
+        int expected[] = { 3, 0, 4, 1, 2, 5 };
+        assertEquals(slist_length(list), 6);
+        assertEquals(*((int*) slist_last(list)), 5);
+
+        for(int i = 0; i < 6; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, expected[i]);
+        }
+    }
+}
+
+TEST(append_with_does_not_add_failed_elements) {
+    int next = 4;
+
+    USING(slist_new_pooled(sizeof(int), 4)) {
+        assertNotEquals(slist_append_with(list, count_up_to_five, &next), NULL);
+        assertEquals(slist_append_with(list, count_up_to_five, &next), NULL);
+        assertEquals(slist_prepend_with(list, count_up_to_five, &next), NULL);
+        assertEquals(slist_insert_with(list, 1, count_up_to_five, &next), NULL);
+
+        assertEquals(slist_length(list), 1);
+        assertEquals(*((int*) slist_first(list)), 4);
+    }
+}
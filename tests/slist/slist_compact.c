@@ -0,0 +1,93 @@
+#include "helpers.h"
+
+// checks that the nodes of list lie next to each other
+// in memory, in list order
+static int slist_is_contiguous(slist_t *list) {
+    if(list->head == NULL || list->head->next == NULL) {
+        return 1;
+    }
+
+    char *head = (char*) list->head;
+    size_t stride = (char*) list->head->next - head;
+    size_t i = 0;
+
+    for(slist_node_t *node = list->head; node != NULL; node = node->next, i++) {
+        if((char*) node != (head + (i * stride))) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+// fills list with 0..count-1, in a scattered way
+static void slist_fill_scattered(slist_t *list, int count) {
+    for(int i = count - 1; i >= 0; i--) {
+        slist_append(list, &i);
+        slist_prepend(list, &i);
+    }
+
+    // leaves count-1..0, every other node of the heap
+    for(int i = 0; i < count; i++) {
+        slist_remove(list, 0);
+    }
+}
+
+TEST(compact_does_not_work_on_arena_lists) {
+    arena_t *arena = arena_new(0);
+
+    USING(slist_new_arena(sizeof(int), arena)) {
+        assertTrue(slist_compact(list) < 0);
+    }
+
+    arena_free(arena);
+
+    assertTrue(slist_compact(NULL) < 0);
+}
+
+TEST(compact_moves_nodes_into_one_block) {
+    USING(slist_new(sizeof(int))) {
+        assertEquals(slist_compact(list), 0);
+
+        slist_fill_scattered(list, 1000);
+        assertEquals(slist_compact(list), 0);
+        assertEquals(slist_verify(list), 0);
+        assertEquals(slist_length(list), 1000);
+        assertTrue(slist_is_contiguous(list));
+
+        // the list keeps the pool it got
+        assertNotEquals(list->pool, NULL);
+
+        for(int i = 0; i < 1000; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, 999 - i);
+        }
+    }
+}
+
+TEST(compact_step_works_in_rounds) {
+    USING(slist_new_pooled(sizeof(int), 8)) {
+        slist_fill_scattered(list, 1000);
+
+        size_t pos = 0;
+        int steps = 0;
+
+        while((ret = slist_compact_step(list, &pos, 64)) > 0) {
+            steps++;
+
+            // modifying the list in between steps is fine
+            slist_insert(list, pos, &steps);
+            slist_remove(list, pos);
+            assertEquals(slist_verify(list), 0);
+        }
+
+        assertEquals(ret, 0);
+        assertEquals(pos, 0);
+        assertEquals(steps, 15);
+
+        for(int i = 0; i < 1000; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, 999 - i);
+        }
+    }
+}
@@ -72,3 +72,66 @@ TEST(copy_works_on_full_list) {
         slist_free(copy);
     }
 }
+
+TEST(copy_lays_out_nodes_in_order) {
+    USING(slist_new_pooled(sizeof(int), 16)) {
+        // scatter the nodes of the original
+        for(int i = 0; i < 1000; i++) {
+            slist_prepend(list, &i);
+            slist_insert(list, slist_length(list) / 2, &i);
+        }
+
+        for(int i = 0; i < 500; i++) {
+            slist_remove(list, (i * 7) % slist_length(list));
+        }
+
+        slist_t *copy = slist_copy(list);
+        assertNotEquals(copy, NULL);
+        assertEquals(copy->pool, list->pool);
+        assertEquals(slist_length(copy), 1500);
+
+        char *head = (char*) copy->head;
+        size_t stride = (char*) copy->head->next - head;
+        size_t i = 0;
+
+        for(slist_node_t *node = copy->head; node != NULL; node = node->next, i++) {
+            assertEquals((char*) node, head + (i * stride));
+        }
+
+        assertEquals(slist_free(copy), 0);
+    }
+}
+
+TEST(copy_can_be_modified_and_joined) {
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            slist_append(list, &i);
+        }
+
+        // a plain list gets a pooled copy, laid out in order
+        slist_t *copy = slist_copy(list);
+        assertNotEquals(copy, NULL);
+        assertNotEquals(copy->pool, NULL);
+
+        char *head = (char*) copy->head;
+        size_t stride = (char*) copy->head->next - head;
+        size_t i = 0;
+
+        for(slist_node_t *node = copy->head; node != NULL; node = node->next, i++) {
+            assertEquals((char*) node, head + (i * stride));
+        }
+
+        // remove some nodes, and add others
+        for(int i = 0; i < 50; i++) {
+            assertEquals(slist_remove(copy, i), 0);
+            assertNotEquals(slist_append(copy, &i), NULL);
+        }
+
+        assertEquals(slist_verify(copy), 0);
+
+        // nodes of the copy are released by the original
+        assertEquals(slist_join(list, copy), list);
+        assertEquals(slist_length(list), 200);
+        assertEquals(slist_free(copy), 0);
+    }
+}
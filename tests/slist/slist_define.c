@@ -0,0 +1,135 @@
+#include "helpers.h"
+#include "clists/slist_define.h"
+#include <stddef.h>
+
+struct pair {
+    int key;
+    int value;
+};
+
+typedef struct pair pair_t;
+
+static inline int int_compare(const int *a, const int *b) {
+    return (*a > *b) ? -1 : (*a < *b);
+}
+
+// only looks at the key, so sorting by it can be
+// checked for stability
+static inline int pair_compare(const pair_t *a, const pair_t *b) {
+    return int_compare(&a->key, &b->key);
+}
+
+SLIST_DEFINE(intlist, int)
+SLIST_DEFINE_SORT(intlist, int, int_compare)
+
+SLIST_DEFINE(pairlist, pair_t)
+SLIST_DEFINE_SORT(pairlist, pair_t, pair_compare)
+
+TEST(define_has_same_node_layout) {
+    assertEquals(offsetof(intlist_node_t, next), offsetof(slist_node_t, next));
+    assertEquals(offsetof(intlist_node_t, data), offsetof(slist_node_t, data));
+}
+
+TEST(define_basic_operations_work) {
+    intlist_t *list = intlist_new();
+    assertNotEquals(list, NULL);
+    assertEquals(intlist_first(list), NULL);
+    assertEquals(intlist_last(list), NULL);
+
+    for(int i = 0; i < 10; i++) {
+        assertNotEquals(intlist_append(list, &i), NULL);
+    }
+
+    int minus = -1, hundred = 100;
+    assertEquals(*intlist_prepend(list, &minus), -1);
+    assertEquals(*intlist_insert(list, 5, &hundred), 100);
+    assertEquals(intlist_insert(list, 13, &hundred), NULL);
+    assertEquals(intlist_length(list), 12);
+    assertEquals(intlist_verify(list), 0);
+
+    int expected[] = { -1, 0, 1, 2, 3, 100, 4, 5, 6, 7, 8, 9 };
+    for(int i = 0; i < 12; i++) {
+        assertNotEquals(intlist_get(list, i, &ret), NULL);
+        assertEquals(ret, expected[i]);
+    }
+
+    assertEquals(intlist_get(list, 12, &ret), NULL);
+    assertEquals(*intlist_set(list, 0, &hundred), 100);
+    assertEquals(intlist_set(list, 0, NULL), NULL);
+    assertEquals(intlist_set(list, 12, &hundred), NULL);
+
+    assertNotEquals(intlist_remove(list, 12), 0);
+    assertEquals(intlist_remove(list, 11), 0);
+    assertEquals(*intlist_last(list), 8);
+    assertEquals(intlist_remove(list, 5), 0);
+    assertEquals(intlist_verify(list), 0);
+
+    assertEquals(intlist_pop(list, &ret), &ret);
+    assertEquals(ret, 100);
+    assertEquals(*intlist_first(list), 0);
+    assertEquals(intlist_length(list), 9);
+
+    while(intlist_length(list) > 0) {
+        assertEquals(intlist_remove(list, 0), 0);
+    }
+
+    assertEquals(intlist_pop(list, &ret), NULL);
+    assertNotEquals(intlist_remove(list, 0), 0);
+    assertEquals(intlist_first(list), NULL);
+    assertEquals(intlist_last(list), NULL);
+    assertEquals(intlist_verify(list), 0);
+
+    assertEquals(intlist_free(list), 0);
+}
+
+TEST(define_sort_is_stable) {
+    pairlist_t list;
+    pairlist_init(&list);
+
+    for(int i = 0; i < 1000; i++) {
+        pair_t pair = { (i * 7919) % 37, i };
+        assertNotEquals(pairlist_append(&list, &pair), NULL);
+    }
+
+    assertEquals(pairlist_sort(&list), 0);
+    assertEquals(pairlist_verify(&list), 0);
+    assertEquals(pairlist_length(&list), 1000);
+
+    pair_t prev, pair;
+    assertNotEquals(pairlist_get(&list, 0, &prev), NULL);
+
+    for(size_t i = 1; i < 1000; i++) {
+        assertNotEquals(pairlist_get(&list, i, &pair), NULL);
+        assertTrue(prev.key <= pair.key);
+
+        // equal keys keep their order
+        if(prev.key == pair.key) {
+            assertTrue(prev.value < pair.value);
+        }
+
+        prev = pair;
+    }
+
+    assertEquals(pairlist_last(&list)->key, 36);
+    pairlist_purge(&list);
+    assertEquals(pairlist_length(&list), 0);
+}
+
+TEST(define_find_works) {
+    intlist_t *list = intlist_new();
+
+    for(int i = 0; i < 20; i += 2) {
+        intlist_append(list, &i);
+    }
+
+    int key = 8;
+    int *found = intlist_find(list, &key);
+    assertNotEquals(found, NULL);
+    assertEquals(*found, 8);
+    assertEquals(found, intlist_get(list, 4, NULL));
+
+    key = 7;
+    assertEquals(intlist_find(list, &key), NULL);
+
+    intlist_free(list);
+}
@@ -0,0 +1,72 @@
+#include "helpers.h"
+
+TEST(from_array_does_not_work_without_data) {
+    assertEquals(slist_from_array(NULL, 4, sizeof(int)), NULL);
+
+    USING(slist_from_array(NULL, 0, sizeof(int))) {
+        assertNotEquals(list, NULL);
+        assertEquals(slist_length(list), 0);
+    }
+}
+
+TEST(from_array_copies_elements) {
+    int numbers[1000];
+    for(int i = 0; i < 1000; i++) {
+        numbers[i] = i * 3;
+    }
+
+    USING(slist_from_array(numbers, 1000, sizeof(int))) {
+        assertEquals(slist_length(list), 1000);
+        assertEquals(slist_size(list), sizeof(int));
+
+        for(int i = 0; i < 1000; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, i * 3);
+        }
+
+        // the list is still usable afterwards
+        assertNotEquals(slist_append(list, &numbers[0]), NULL);
+        assertEquals(slist_remove(list, 10), 0);
+    }
+}
+
+TEST(from_array_lays_out_nodes_in_order) {
+    int numbers[1000] = {0};
+
+    USING(slist_from_array(numbers, 1000, sizeof(int))) {
+        char *head = (char*) list->head;
+        size_t stride = (char*) list->head->next - head;
+
+        // every node directly follows the one before it
+        size_t i = 0;
+        for(slist_node_t *node = list->head; node != NULL; node = node->next, i++) {
+            assertEquals((char*) node, head + (i * stride));
+        }
+
+        assertEquals(i, 1000);
+    }
+}
+
+TEST(to_array_copies_elements) {
+    int numbers[500];
+
+    assertEquals(slist_to_array(NULL, numbers), NULL);
+
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 500; i++) {
+            int number = 500 - i;
+            slist_append(list, &number);
+        }
+
+        assertEquals(slist_to_array(list, numbers), numbers);
+
+        for(int i = 0; i < 500; i++) {
+            assertEquals(numbers[i], 500 - i);
+        }
+
+        int *array = slist_to_array(list, NULL);
+        assertNotEquals(array, NULL);
+        assertEquals(memcmp(array, numbers, sizeof(numbers)), 0);
+        free(array);
+    }
+}
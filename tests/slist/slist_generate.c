@@ -0,0 +1,59 @@
+#include "helpers.h"
+
+// writes the next number into the element
+static int count_up(void *data, void *ctx) {
+    *((int*) data) = (*((int*) ctx))++;
+    return 0;
+}
+
+// like count_up, but fails once the number reaches 50
+static int count_up_to_fifty(void *data, void *ctx) {
+    if(*((int*) ctx) >= 50) {
+        return -1;
+    }
+
+    return count_up(data, ctx);
+}
+
+TEST(generate_appends_elements) {
+    int next = 0;
+
+    USING(slist_new(sizeof(int))) {
+        assertNotEquals(slist_generate(list, 1, NULL, &next), 0);
+        assertEquals(slist_generate(list, 0, count_up, &next), 0);
+
+        assertEquals(slist_generate(list, 10, count_up, &next), 0);
+        assertEquals(slist_generate(list, 20, count_up, &next), 0);
+        assertEquals(slist_length(list), 30);
+        assertEquals(slist_verify(list), 0);
+
+        for(int i = 0; i < 30; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+        }
+
+        assertEquals(*((int*) slist_last(list)), 29);
+    }
+
+    USING(slist_new_pooled(sizeof(int), 4)) {
+        next = 0;
+
+        // the nodes come from one slab, in order
+        assertEquals(slist_generate(list, 100, count_up, &next), 0);
+
+        char *first = (char*) list->head;
+        size_t stride = (char*) list->head->next - first;
+        assertEquals((char*) list->tail, first + 99 * stride);
+    }
+}
+
+TEST(generate_does_not_add_anything_on_failure) {
+    int next = 0;
+
+    USING(slist_new(sizeof(int))) {
+        assertEquals(slist_generate(list, 40, count_up_to_fifty, &next), 0);
+        assertNotEquals(slist_generate(list, 20, count_up_to_fifty, &next), 0);
+        assertEquals(slist_length(list), 40);
+        assertEquals(*((int*) slist_last(list)), 39);
+    }
+}
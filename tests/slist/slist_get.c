@@ -1,5 +1,8 @@
 #include "helpers.h"
 
+// swap two variables
+#define swap(x,y) do { int _t = x; x = y; y = _t; } while(0)
+
 TEST(get_does_not_work_for_empty_list) {
     USING(slist_new(sizeof(int))) {
         assertEquals(slist_get(list, 0, NULL), NULL);
@@ -70,3 +73,90 @@ TEST(get_works_with_data) {
         assertEquals(ret, 6);
     }
 }
+
+TEST(get_remembers_last_node) {
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            slist_append(list, &i);
+        }
+
+        // sequential access
+        for(int i = 1; i < 99; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+            assertNotEquals(list->finger, NULL);
+            assertEquals(list->finger_pos, i);
+        }
+
+        // going backwards starts over at the head
+        assertNotEquals(slist_get(list, 10, &ret), NULL);
+        assertEquals(ret, 10);
+        assertEquals(list->finger_pos, 10);
+    }
+}
+
+TEST(get_finger_survives_mutations) {
+    // mirror of the list contents
+    int array[102];
+    size_t length = 100;
+
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            slist_append(list, &i);
+            array[i] = i;
+        }
+
+        int value = -1;
+
+        slist_get(list, 50, NULL);
+        slist_prepend(list, &value);
+        memmove(&array[1], &array[0], length * sizeof(int));
+        array[0] = value;
+        length++;
+        assertEquals(slist_verify(list), 0);
+
+        slist_get(list, 50, NULL);
+        slist_insert(list, 20, &value);
+        memmove(&array[21], &array[20], (length - 20) * sizeof(int));
+        array[20] = value;
+        length++;
+        assertEquals(slist_verify(list), 0);
+
+        slist_get(list, 50, NULL);
+        slist_remove(list, 30);
+        memmove(&array[30], &array[31], (length - 31) * sizeof(int));
+        length--;
+        assertEquals(slist_verify(list), 0);
+
+        slist_get(list, 50, NULL);
+        slist_remove(list, 50);
+        memmove(&array[50], &array[51], (length - 51) * sizeof(int));
+        length--;
+        assertEquals(slist_verify(list), 0);
+
+        slist_get(list, 50, NULL);
+        slist_pop(list, NULL);
+        memmove(&array[0], &array[1], (length - 1) * sizeof(int));
+        length--;
+        assertEquals(slist_verify(list), 0);
+
+        slist_get(list, 50, NULL);
+        slist_swap(list, 10, 50);
+        swap(array[10], array[50]);
+        assertEquals(slist_verify(list), 0);
+
+        slist_get(list, 50, NULL);
+        slist_t *splt = slist_split(list, 40);
+        assertEquals(slist_verify(list), 0);
+        assertEquals(slist_verify(splt), 0);
+        slist_join(list, splt);
+        slist_free(splt);
+
+        // check that everything is still where it belongs
+        assertEquals(slist_length(list), length);
+        for(size_t i = 0; i < length; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, array[i]);
+        }
+    }
+}
@@ -0,0 +1,113 @@
+#include "helpers.h"
+
+struct counting {
+    size_t allocs;
+    size_t frees;
+    size_t bytes;
+};
+
+static void *counting_alloc(void *ctx, size_t size) {
+    struct counting *counting = ctx;
+    counting->allocs++;
+    counting->bytes += size;
+    return malloc(size);
+}
+
+static void counting_free(void *ctx, void *ptr, size_t size) {
+    struct counting *counting = ctx;
+    counting->frees++;
+    counting->bytes -= size;
+    free(ptr);
+}
+
+TEST(init_allocator_works_with_all_sizes)
+{
+    struct counting counting = {0, 0, 0};
+    allocator_t allocator = {counting_alloc, counting_free, &counting};
+
+    slist_t *list = slist_new_allocator(sizeof(int), &allocator);
+    assertNotEquals(list, NULL);
+    assertEquals(list->allocator, &allocator);
+    assertEquals(slist_size(list), sizeof(int));
+    assertEquals(counting.allocs, 1);
+    assertEquals(slist_free(list), 0);
+    assertEquals(counting.frees, 1);
+    assertEquals(counting.bytes, 0);
+
+    // NULL means malloc()
+    USING(slist_new_allocator(56, NULL)) {
+        assertEquals(list->allocator, NULL);
+        assertEquals(slist_size(list), 56);
+        assertNotEquals(slist_append(list, NULL), NULL);
+    }
+}
+
+TEST(init_allocator_is_used_for_all_nodes)
+{
+    struct counting counting = {0, 0, 0};
+    allocator_t allocator = {counting_alloc, counting_free, &counting};
+
+    slist_t local;
+    assertEquals(slist_init_allocator(&local, sizeof(int), &allocator), &local);
+
+    for(int i = 0; i < 10; i++) {
+        assertNotEquals(slist_append(&local, &i), NULL);
+    }
+
+    assertEquals(counting.allocs, 10);
+    assertEquals(slist_remove(&local, 3), 0);
+    assertEquals(slist_pop(&local, NULL), NULL);
+    assertEquals(counting.frees, 2);
+
+    // split off and copied lists use the allocator too
+    slist_t *half = slist_split(&local, 4);
+    assertNotEquals(half, NULL);
+    assertEquals(half->allocator, &allocator);
+    slist_t *copy = slist_copy(half);
+    assertNotEquals(copy, NULL);
+    assertEquals(copy->allocator, &allocator);
+    assertEquals(slist_join(&local, copy), &local);
+    assertEquals(slist_verify(&local), 0);
+    assertEquals(slist_length(&local), 8);
+
+    // can't join lists with different allocators
+    slist_t *plain = slist_new(sizeof(int));
+    assertNotEquals(slist_append(plain, &ret), NULL);
+    assertEquals(slist_join(&local, plain), NULL);
+    assertEquals(slist_join(plain, half), NULL);
+    slist_free(plain);
+
+    assertEquals(slist_free(half), 0);
+    assertEquals(slist_free(copy), 0);
+    slist_purge(&local);
+
+    assertEquals(counting.allocs, counting.frees);
+    assertEquals(counting.bytes, 0);
+}
+
+TEST(init_allocator_without_free_skips_purge)
+{
+    struct counting counting = {0, 0, 0};
+    allocator_t allocator = {counting_alloc, NULL, &counting};
+
+    // nodes are kept in an array so the test can
+    // release them itself
+    void *nodes[10];
+
+    slist_t local;
+    assertEquals(slist_init_allocator(&local, sizeof(int), &allocator), &local);
+
+    for(int i = 0; i < 10; i++) {
+        assertNotEquals(slist_append(&local, &i), NULL);
+        nodes[i] = local.tail;
+    }
+
+    assertEquals(slist_purge(&local), &local);
+    assertEquals(slist_length(&local), 0);
+    assertEquals(counting.allocs, 10);
+    assertEquals(counting.frees, 0);
+
+    for(int i = 0; i < 10; i++) {
+        free(nodes[i]);
+    }
+}
@@ -0,0 +1,77 @@
+#include "helpers.h"
+
+TEST(init_arena_does_not_work_without_arena)
+{
+    slist_t local;
+    assertEquals(slist_init_arena(&local, sizeof(int), NULL), NULL);
+    assertEquals(slist_new_arena(sizeof(int), NULL), NULL);
+}
+
+TEST(init_arena_works_with_all_sizes)
+{
+    arena_t *arena = arena_new(0);
+    assertNotEquals(arena, NULL);
+
+    slist_t local;
+    assertEquals(slist_init_arena(&local, sizeof(int), arena), &local);
+    assertEquals(local.arena, arena);
+    assertEquals(slist_size(&local), sizeof(int));
+    assertEquals(slist_length(&local), 0);
+
+    slist_t *list = slist_new_arena(56, arena);
+    assertNotEquals(list, NULL);
+    assertEquals(list->arena, arena);
+    assertEquals(slist_size(list), 56);
+    assertEquals(slist_length(list), 0);
+    assertEquals(slist_free(list), 0);
+
+    arena_free(arena);
+}
+
+TEST(init_arena_lists_are_released_by_reset)
+{
+    arena_t *arena = arena_new(128);
+    assertNotEquals(arena, NULL);
+
+    for(int round = 0; round < 3; round++) {
+        slist_t *list = slist_new_arena(sizeof(int), arena);
+        assertNotEquals(list, NULL);
+
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(slist_append(list, &i), NULL);
+        }
+
+        assertEquals(slist_verify(list), 0);
+        assertEquals(slist_remove(list, 50), 0);
+        assertEquals(slist_pop(list, &ret), &ret);
+        assertEquals(ret, 0);
+        assertEquals(*((int*)slist_get(list, 50, NULL)), 52);
+
+        // split and copy stay in the arena
+        slist_t *half = slist_split(list, 49);
+        assertNotEquals(half, NULL);
+        assertEquals(half->arena, arena);
+        slist_t *copy = slist_copy(half);
+        assertNotEquals(copy, NULL);
+        assertEquals(copy->arena, arena);
+        assertEquals(slist_join(list, copy), list);
+        assertEquals(slist_length(list), 98);
+        assertEquals(slist_verify(list), 0);
+
+        // can't mix arena and heap nodes
+        slist_t *heap = slist_new(sizeof(int));
+        assertNotEquals(slist_append(heap, &ret), NULL);
+        assertEquals(slist_join(list, heap), NULL);
+        assertEquals(slist_join(heap, half), NULL);
+        slist_free(heap);
+
+        // purging doesn't free anything
+        assertEquals(slist_purge(list), list);
+        assertEquals(slist_length(list), 0);
+        assertEquals(slist_free(half), 0);
+
+        arena_reset(arena);
+    }
+
+    arena_free(arena);
+}
@@ -0,0 +1,102 @@
+#include "helpers.h"
+
+TEST(init_pooled_works_with_all_sizes)
+{
+    USING(slist_new_pooled(sizeof(int), 0)) {
+        assertNotEquals(list, NULL);
+        assertNotEquals(list->pool, NULL);
+        assertEquals(slist_size(list), sizeof(int));
+        assertEquals(slist_length(list), 0);
+    }
+
+    USING(malloc(sizeof(slist_t))) {
+        assertEquals(slist_init_pooled(list, 56, 4), list);
+        assertNotEquals(list->pool, NULL);
+        assertEquals(slist_size(list), 56);
+        assertEquals(slist_length(list), 0);
+    }
+}
+
+TEST(init_pooled_recycles_nodes)
+{
+    USING(slist_new_pooled(sizeof(int), 4)) {
+        int one = 1, two = 2;
+
+        // popped nodes get reused
+        void *first = slist_append(list, &one);
+        assertNotEquals(first, NULL);
+        assertEquals(slist_pop(list, &ret), &ret);
+        assertEquals(ret, one);
+        assertEquals(slist_append(list, &two), first);
+        assertEquals(slist_pop(list, NULL), NULL);
+
+        // more nodes than fit into a slab
+        for(int i = 0; i < 10; i++) {
+            assertNotEquals(slist_append(list, &i), NULL);
+        }
+
+        assertEquals(slist_verify(list), 0);
+        assertEquals(slist_length(list), 10);
+
+        for(int i = 0; i < 10; i++) {
+            assertEquals(*((int*)slist_get(list, i, NULL)), i);
+        }
+
+        assertEquals(slist_remove(list, 5), 0);
+        assertEquals(slist_remove(list, 0), 0);
+        assertEquals(slist_length(list), 8);
+        assertEquals(slist_verify(list), 0);
+
+        slist_purge(list);
+        assertNotEquals(list->pool, NULL);
+        assertEquals(slist_length(list), 0);
+    }
+}
+
+TEST(init_pooled_split_and_join_share_nodes)
+{
+    USING(slist_new_pooled(sizeof(int), 4)) {
+        for(int i = 0; i < 6; i++) {
+            assertNotEquals(slist_append(list, &i), NULL);
+        }
+
+        // split off list shares the pool
+        slist_t *half = slist_split(list, 3);
+        assertNotEquals(half, NULL);
+        assertEquals(half->pool, list->pool);
+        assertEquals(slist_length(half), 3);
+
+        // join with a list without a pool
+        slist_t *plain = slist_new(sizeof(int));
+        assertNotEquals(slist_append(plain, &ret), NULL);
+        assertEquals(slist_join(plain, half), plain);
+        assertEquals(plain->pool, list->pool);
+        assertEquals(slist_length(plain), 4);
+        assertEquals(slist_verify(plain), 0);
+        slist_free(half);
+
+        // join with a list from another pool
+        slist_t *other = slist_new_pooled(sizeof(int), 2);
+        assertNotEquals(slist_append(other, &ret), NULL);
+        assertEquals(slist_join(list, other), list);
+        assertEquals(slist_length(list), 4);
+        assertEquals(slist_verify(list), 0);
+        slist_free(other);
+
+        assertEquals(slist_join(list, plain), list);
+        assertEquals(slist_length(list), 8);
+        assertEquals(*((int*)slist_get(list, 5, NULL)), 3);
+        slist_free(plain);
+
+        // copies share the pool as well
+        slist_t *copy = slist_copy(list);
+        assertNotEquals(copy, NULL);
+        assertEquals(slist_length(copy), 8);
+        assertEquals(slist_verify(copy), 0);
+        slist_free(copy);
+
+        while(slist_length(list) > 0) {
+            assertEquals(slist_remove(list, slist_length(list) - 1), 0);
+        }
+    }
+}
@@ -0,0 +1,47 @@
+#include "helpers.h"
+
+TEST(insert_after_works_at_front_and_end) {
+    int one = 1, two = 2, three = 3;
+
+    USING(slist_new(sizeof(int))) {
+        // inserting after NULL prepends
+        assertNotEquals(slist_insert_after(list, NULL, &two), NULL);
+        assertEquals(list->head, list->tail);
+        assertNotEquals(slist_insert_after(list, NULL, &one), NULL);
+
+        // inserting after the tail appends
+        assertNotEquals(slist_insert_after(list, list->tail, &three), NULL);
+        assertEquals(*((int*) slist_last(list)), 3);
+        assertEquals(slist_length(list), 3);
+
+        for(int i = 0; i < 3; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, i + 1);
+        }
+    }
+}
+
+TEST(insert_after_works_in_one_pass) {
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(slist_append(list, &i), NULL);
+        }
+
+        // move the finger somewhere into the list
+        assertNotEquals(slist_get(list, 50, NULL), NULL);
+
+        // put the negative of every element after it
+        for(slist_node_t *node = list->head; node != NULL; node = node->next) {
+            int neg = -*((int*) node->data);
+            node = slist_node_of(slist_insert_after(list, node, &neg));
+            assertNotEquals(node, NULL);
+        }
+
+        assertEquals(slist_length(list), 200);
+
+        for(int i = 0; i < 200; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, (i % 2) ? -(i / 2) : (i / 2));
+        }
+    }
+}
@@ -0,0 +1,81 @@
+#include "helpers.h"
+
+TEST(iter_does_not_work_without_list) {
+    slist_iter_t iter;
+    assertNotEquals(slist_iter_init(&iter, NULL), 0);
+
+    USING(slist_new(sizeof(int))) {
+        assertNotEquals(slist_iter_init(NULL, list), 0);
+        assertEquals(slist_iter_init(&iter, list), 0);
+        assertEquals(slist_iter_node(&iter), NULL);
+        assertEquals(slist_iter_get(&iter), NULL);
+        assertNotEquals(slist_iter_next(&iter), 0);
+        assertNotEquals(slist_iter_remove(&iter), 0);
+    }
+}
+
+TEST(iter_visits_all_nodes) {
+    slist_iter_t iter;
+
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 10; i++) {
+            assertNotEquals(slist_append(list, &i), NULL);
+        }
+
+        int i = 0;
+        for(slist_iter_init(&iter, list); slist_iter_node(&iter) != NULL; slist_iter_next(&iter)) {
+            assertEquals(*((int*) slist_iter_get(&iter)), i);
+            assertEquals(slist_iter_get(&iter), slist_iter_node(&iter)->data);
+            assertEquals(slist_node_of(slist_iter_get(&iter)), slist_iter_node(&iter));
+            i++;
+        }
+
+        assertEquals(i, 10);
+    }
+}
+
+TEST(iter_remove_filters_list) {
+    slist_iter_t iter;
+
+    USING(slist_new(sizeof(int))) {
+        for(int i = -5; i < 5; i++) {
+            assertNotEquals(slist_append(list, &i), NULL);
+        }
+
+        // remove every odd number, including head and tail
+        assertEquals(slist_iter_init(&iter, list), 0);
+
+        while(slist_iter_node(&iter) != NULL) {
+            if(*((int*) slist_iter_get(&iter)) % 2 != 0) {
+                assertEquals(slist_iter_remove(&iter), 0);
+            } else {
+                assertEquals(slist_iter_next(&iter), 0);
+            }
+        }
+
+        assertEquals(slist_length(list), 5);
+        assertEquals(*((int*) slist_last(list)), 4);
+
+        for(int i = 0; i < 5; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, 2 * i - 4);
+        }
+    }
+
+    USING(slist_new_pooled(sizeof(int), 16)) {
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(slist_append(list, &i), NULL);
+        }
+
+        // remove everything
+        assertEquals(slist_iter_init(&iter, list), 0);
+
+        while(slist_iter_node(&iter) != NULL) {
+            assertEquals(slist_iter_remove(&iter), 0);
+        }
+
+        assertEquals(slist_length(list), 0);
+        assertEquals(list->head, NULL);
+        assertEquals(list->tail, NULL);
+    }
+}
@@ -0,0 +1,64 @@
+#include "helpers.h"
+
+TEST(locality_stats_does_not_work_on_null) {
+    locality_stats_t stats;
+
+    assertTrue(slist_locality_stats(NULL, &stats) < 0);
+
+    USING(slist_new(sizeof(int))) {
+        assertTrue(slist_locality_stats(list, NULL) < 0);
+        assertEquals(slist_locality_stats(list, &stats), 0);
+        assertEquals(stats.nodes, 0);
+        assertEquals(stats.steps, 0);
+        assertEquals(stats.pages, 0);
+        assertTrue(stats.page_size > 0);
+    }
+}
+
+TEST(locality_stats_measures_contiguous_list) {
+    int numbers[4096] = {0};
+    locality_stats_t stats;
+
+    USING(slist_from_array(numbers, 4096, sizeof(int))) {
+        assertEquals(slist_locality_stats(list, &stats), 0);
+        assertEquals(stats.nodes, 4096);
+        assertEquals(stats.steps, 4095);
+
+        // every step goes to the next node in the block
+        size_t stride = (char*) list->head->next - (char*) list->head;
+        assertEquals(stats.p50_distance, stride);
+        assertEquals(stats.p99_distance, stride);
+        assertEquals(stats.max_distance, stride);
+        assertTrue(stats.mean_distance == stride);
+
+        // and the nodes fill up whole pages
+        size_t needed = ((4096 * stride) / stats.page_size) + 1;
+        assertTrue(stats.pages <= (needed + 1));
+        assertTrue(stats.page_cross_fraction < 0.1);
+    }
+}
+
+TEST(locality_stats_sees_scattered_list) {
+    locality_stats_t before, after;
+
+    USING(slist_new_pooled(sizeof(int), 64)) {
+        // alternate between the ends of the list, so that
+        // consecutive nodes are far apart
+        for(int i = 0; i < 4096; i++) {
+            if(i % 2) {
+                slist_append(list, &i);
+            } else {
+                slist_prepend(list, &i);
+            }
+        }
+
+        assertEquals(slist_locality_stats(list, &before), 0);
+        assertEquals(slist_compact(list), 0);
+        assertEquals(slist_locality_stats(list, &after), 0);
+
+        assertEquals(before.nodes, after.nodes);
+        assertTrue(before.p50_distance >= after.p50_distance);
+        assertTrue(before.max_distance > after.max_distance);
+        assertTrue(before.mean_distance > after.mean_distance);
+    }
+}
@@ -0,0 +1,82 @@
+#include "helpers.h"
+#include "../../clists/nodecache.h"
+#include <pthread.h>
+
+#define NODECACHE_TEST_NODES 200
+
+static void *nodecache_fill_and_exit(void *arg) {
+    slist_t *list = arg;
+
+    // nodes freed by this thread end up in the depot
+    // when the thread exits
+    for(int i = 0; i < NODECACHE_TEST_NODES; i++) {
+        slist_append(list, &i);
+    }
+
+    slist_purge(list);
+
+    return NULL;
+}
+
+TEST(nodecache_reuses_nodes)
+{
+    nodecache_enable();
+    assertEquals(nodecache_enabled(), true);
+
+    USING(slist_new(sizeof(int))) {
+        void *first = slist_append(list, &ret);
+        assertNotEquals(first, NULL);
+        assertEquals(slist_pop(list, NULL), NULL);
+
+        // the node is reused by another list of the
+        // same element size
+        slist_t *other = slist_new(sizeof(int));
+        assertEquals(slist_append(other, &ret), first);
+        slist_free(other);
+    }
+
+    nodecache_disable();
+    assertEquals(nodecache_enabled(), false);
+
+    // nodes allocated while the cache was enabled can
+    // be freed after disabling it and vice versa
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(slist_append(list, &i), NULL);
+        }
+
+        nodecache_enable();
+        for(int i = 0; i < 50; i++) {
+            assertEquals(slist_remove(list, 0), 0);
+        }
+
+        nodecache_disable();
+    }
+
+    nodecache_flush();
+    nodecache_trim();
+}
+
+TEST(nodecache_shares_nodes_between_threads)
+{
+    nodecache_enable();
+
+    slist_t *list = slist_new(sizeof(int));
+    pthread_t thread;
+
+    assertEquals(pthread_create(&thread, NULL, nodecache_fill_and_exit, list), 0);
+    assertEquals(pthread_join(thread, NULL), 0);
+
+    for(int i = 0; i < NODECACHE_TEST_NODES; i++) {
+        assertNotEquals(slist_append(list, &i), NULL);
+    }
+
+    assertEquals(slist_verify(list), 0);
+    assertEquals(slist_length(list), NODECACHE_TEST_NODES);
+    assertEquals(*((int*)slist_get(list, 123, NULL)), 123);
+    slist_free(list);
+
+    nodecache_disable();
+    nodecache_flush();
+    nodecache_trim();
+}
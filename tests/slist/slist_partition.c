@@ -0,0 +1,106 @@
+#include "helpers.h"
+
+// sorts numbers by their remainder modulo *ctx
+static size_t classify_mod(void *data, void *ctx) {
+    return (size_t) (*((int*) data) % *((int*) ctx));
+}
+
+TEST(partition_does_not_work_on_illegal_outputs) {
+    int three = 3;
+    slist_t *outs[3];
+
+    USING(slist_new(sizeof(int))) {
+        slist_t *other = slist_new(sizeof(int));
+        slist_t *bytes = slist_new(sizeof(char));
+        slist_append(list, &three);
+
+        outs[0] = other;
+        outs[1] = list;
+        assertNotEquals(slist_partition(list, classify_mod, &three, outs, 2), 0);
+        outs[1] = NULL;
+        assertNotEquals(slist_partition(list, classify_mod, &three, outs, 2), 0);
+        outs[1] = bytes;
+        assertNotEquals(slist_partition(list, classify_mod, &three, outs, 2), 0);
+        assertNotEquals(slist_partition(list, NULL, &three, outs, 1), 0);
+        assertNotEquals(slist_partition(list, classify_mod, &three, NULL, 1), 0);
+        assertNotEquals(slist_partition(list, classify_mod, &three, outs, 0), 0);
+
+        assertEquals(slist_length(list), 1);
+        assertEquals(slist_length(other), 0);
+
+        slist_free(other);
+        slist_free(bytes);
+    }
+}
+
+TEST(partition_moves_nodes_in_order) {
+    int three = 3;
+    slist_t *outs[3];
+
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 3; i++) {
+            outs[i] = slist_new(sizeof(int));
+        }
+
+        // outputs that already hold something are appended to
+        int minus = -3;
+        slist_append(outs[0], &minus);
+
+        for(int i = 0; i < 30; i++) {
+            slist_append(list, &i);
+        }
+
+        void *first = slist_first(list);
+        assertEquals(slist_partition(list, classify_mod, &three, outs, 3), 0);
+        assertEquals(slist_length(list), 0);
+        assertEquals(slist_first(list), NULL);
+        assertEquals(slist_last(list), NULL);
+
+        // the node was moved, not copied
+        assertEquals(slist_get(outs[0], 1, NULL), first);
+
+        for(int i = 0; i < 3; i++) {
+            assertEquals(slist_verify(outs[i]), 0);
+            size_t offset = (i == 0) ? 1 : 0;
+            assertEquals(slist_length(outs[i]), 10 + offset);
+
+            for(int j = 0; j < 10; j++) {
+                assertNotEquals(slist_get(outs[i], j + offset, &ret), NULL);
+                assertEquals(ret, 3 * j + i);
+            }
+
+            slist_free(outs[i]);
+        }
+    }
+}
+
+TEST(partition_keeps_unclassified_elements) {
+    int four = 4;
+    slist_t *outs[2];
+
+    USING(slist_new_pooled(sizeof(int), 8)) {
+        outs[0] = slist_new_pooled(sizeof(int), 8);
+        outs[1] = outs[0];
+
+        for(int i = 0; i < 20; i++) {
+            slist_append(list, &i);
+        }
+
+        // remainders 0 and 1 go to the same list, 2 and 3 stay
+        assertEquals(slist_partition(list, classify_mod, &four, outs, 2), 0);
+        assertEquals(slist_length(list), 10);
+        assertEquals(slist_length(outs[0]), 10);
+        assertEquals(slist_verify(outs[0]), 0);
+
+        for(int i = 0; i < 10; i++) {
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(ret, 4 * (i / 2) + 2 + (i % 2));
+            assertNotEquals(slist_get(outs[0], i, &ret), NULL);
+            assertEquals(ret, 4 * (i / 2) + (i % 2));
+        }
+
+        // the pools were merged, so either list can be
+        // released first
+        assertEquals(slist_free(outs[0]), 0);
+    }
+}
@@ -0,0 +1,60 @@
+#include "helpers.h"
+
+TEST(pop_many_works_on_empty_list) {
+    int out[4];
+
+    USING(slist_new(sizeof(int))) {
+        assertEquals(slist_pop_many(list, out, 4), 0);
+        assertEquals(slist_pop_many(list, NULL, 4), 0);
+    }
+}
+
+TEST(pop_many_pops_in_batches) {
+    int out[8];
+
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 20; i++) {
+            slist_append(list, &i);
+        }
+
+        assertNotEquals(slist_get(list, 10, NULL), NULL);
+
+        // full batches
+        for(int batch = 0; batch < 2; batch++) {
+            assertEquals(slist_pop_many(list, out, 8), 8);
+
+            for(int i = 0; i < 8; i++) {
+                assertEquals(out[i], batch * 8 + i);
+            }
+
+            assertEquals(slist_verify(list), 0);
+        }
+
+        assertEquals(slist_length(list), 4);
+        assertEquals(*((int*) slist_first(list)), 16);
+        assertNotEquals(slist_get(list, 1, &ret), NULL);
+        assertEquals(ret, 17);
+
+        // the last batch is short
+        assertEquals(slist_pop_many(list, out, 8), 4);
+        for(int i = 0; i < 4; i++) {
+            assertEquals(out[i], 16 + i);
+        }
+
+        assertEquals(slist_length(list), 0);
+        assertEquals(slist_first(list), NULL);
+        assertEquals(slist_last(list), NULL);
+    }
+
+    USING(slist_new_pooled(sizeof(int), 4)) {
+        for(int i = 0; i < 10; i++) {
+            slist_append(list, &i);
+        }
+
+        // elements can be discarded
+        assertEquals(slist_pop_many(list, NULL, 3), 3);
+        assertEquals(slist_pop_many(list, out, 1), 1);
+        assertEquals(out[0], 3);
+        assertEquals(slist_length(list), 6);
+    }
+}
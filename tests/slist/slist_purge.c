@@ -37,3 +37,31 @@ TEST(purge_removes_all_elements_of_list) {
         assertEquals(slist_size(list), sizeof(int));
     }
 }
+
+TEST(purge_keeps_pool_of_pooled_list)
+{
+    USING(slist_new_pooled(sizeof(int), 4)) {
+        pool_t *pool = list->pool;
+
+        for(int i = 0; i < 6; i++) {
+            assertNotEquals(slist_append(list, &i), NULL);
+        }
+
+        void *first = slist_get(list, 0, NULL);
+        assertEquals(slist_purge(list), list);
+        assertEquals(slist_length(list), 0);
+        assertEquals(list->pool, pool);
+
+        // the nodes are reused instead of allocated again
+        int value = 7;
+        assertEquals(slist_append(list, &value), first);
+        assertEquals(slist_length(list), 1);
+        assertEquals(*((int*)slist_get(list, 0, NULL)), value);
+
+        // releasing drops the pool
+        assertEquals(slist_release(list), list);
+        assertEquals(list->pool, NULL);
+        assertEquals(slist_length(list), 0);
+        assertNotEquals(slist_append(list, &value), NULL);
+    }
+}
@@ -0,0 +1,147 @@
+#include "helpers.h"
+
+// checks that list holds exactly the given elements
+static int slist_holds(slist_t *list, const int *expected, size_t count) {
+    if(slist_length(list) != count || slist_verify(list) != 0) {
+        return 0;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        if(slist_get(list, i, &ret) == NULL || ret != expected[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+TEST(range_functions_do_not_work_on_illegal_ranges) {
+    int data[4] = { 0 };
+
+    USING(slist_new(sizeof(int))) {
+        assertEquals(slist_insert_range(list, 0, data, 4), 0);
+
+        assertEquals(slist_get_range(list, 2, 3, data), NULL);
+        assertEquals(slist_get_range(list, 5, 0, data), NULL);
+        assertEquals(slist_get_range(list, 0, 1, NULL), NULL);
+        assertNotEquals(slist_set_range(list, 3, 2, data), 0);
+        assertNotEquals(slist_set_range(list, 0, 1, NULL), 0);
+        assertNotEquals(slist_insert_range(list, 5, data, 1), 0);
+        assertNotEquals(slist_remove_range(list, 1, 4), 0);
+        assertNotEquals(slist_remove_range(list, 5, 0), 0);
+
+        // empty ranges are fine
+        assertEquals(slist_get_range(list, 4, 0, data), data);
+        assertEquals(slist_set_range(list, 4, 0, data), 0);
+        assertEquals(slist_insert_range(list, 4, data, 0), 0);
+        assertEquals(slist_remove_range(list, 4, 0), 0);
+
+        assertEquals(slist_length(list), 4);
+    }
+}
+
+TEST(get_and_set_range_work_correctly) {
+    int data[10], out[10];
+
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 10; i++) {
+            slist_append(list, &i);
+            data[i] = 100 + i;
+        }
+
+        assertEquals(slist_get_range(list, 0, 10, out), out);
+        for(int i = 0; i < 10; i++) {
+            assertEquals(out[i], i);
+        }
+
+        assertEquals(slist_set_range(list, 3, 4, data), 0);
+        assertEquals(slist_get_range(list, 2, 6, out), out);
+
+        int expected[] = { 2, 100, 101, 102, 103, 7 };
+        for(int i = 0; i < 6; i++) {
+            assertEquals(out[i], expected[i]);
+        }
+
+        // reading consecutive windows
+        for(int i = 0; i < 10; i += 2) {
+            assertEquals(slist_get_range(list, i, 2, out), out);
+            assertNotEquals(slist_get(list, i, &ret), NULL);
+            assertEquals(out[0], ret);
+            assertNotEquals(slist_get(list, i + 1, &ret), NULL);
+            assertEquals(out[1], ret);
+        }
+    }
+}
+
+TEST(insert_range_works_correctly) {
+    int batch[] = { 10, 11, 12 };
+
+    USING(slist_new(sizeof(int))) {
+        assertEquals(slist_insert_range(list, 0, batch, 3), 0);
+        assertEquals(slist_insert_range(list, 3, batch, 2), 0);
+        assertEquals(slist_insert_range(list, 1, batch + 2, 1), 0);
+        assertEquals(slist_insert_range(list, 0, batch + 1, 2), 0);
+
+        int expected[] = { 11, 12, 10, 12, 11, 12, 10, 11 };
+        assertTrue(slist_holds(list, expected, 8));
+        assertEquals(*((int*) slist_last(list)), 11);
+    }
+
+    USING(slist_new_pooled(sizeof(int), 4)) {
+        int many[100];
+        for(int i = 0; i < 100; i++) {
+            many[i] = i;
+        }
+
+        // the nodes come from one slab, in order
+        assertEquals(slist_insert_range(list, 0, many, 100), 0);
+        assertTrue(slist_holds(list, many, 100));
+
+        char *first = (char*) list->head;
+        size_t stride = (char*) list->head->next - first;
+        assertEquals((char*) list->tail, first + 99 * stride);
+
+        // without data, elements are not initialized
+        assertEquals(slist_insert_range(list, 50, NULL, 10), 0);
+        assertEquals(slist_length(list), 110);
+    }
+
+    USING(slist_new_pooled(sizeof(int), 16)) {
+        // small ranges share slabs instead of getting
+        // a tiny slab each
+        for(int i = 0; i < 64; i++) {
+            assertEquals(slist_insert_range(list, 0, &i, 1), 0);
+        }
+
+        assertEquals(slist_length(list), 64);
+        assertEquals(list->pool->slabs_count, 4);
+    }
+}
+
+TEST(remove_range_works_correctly) {
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 10; i++) {
+            slist_append(list, &i);
+        }
+
+        assertNotEquals(slist_get(list, 8, NULL), NULL);
+        assertEquals(slist_remove_range(list, 3, 4), 0);
+
+        int middle[] = { 0, 1, 2, 7, 8, 9 };
+        assertTrue(slist_holds(list, middle, 6));
+
+        assertEquals(slist_remove_range(list, 4, 2), 0);
+        int end[] = { 0, 1, 2, 7 };
+        assertTrue(slist_holds(list, end, 4));
+        assertEquals(*((int*) slist_last(list)), 7);
+
+        assertEquals(slist_remove_range(list, 0, 2), 0);
+        int start[] = { 2, 7 };
+        assertTrue(slist_holds(list, start, 2));
+
+        assertEquals(slist_remove_range(list, 0, 2), 0);
+        assertEquals(slist_length(list), 0);
+        assertEquals(slist_first(list), NULL);
+        assertEquals(slist_last(list), NULL);
+    }
+}
@@ -0,0 +1,33 @@
+#include "helpers.h"
+
+TEST(remove_after_does_not_work_past_the_end) {
+    USING(slist_new(sizeof(int))) {
+        assertNotEquals(slist_remove_after(list, NULL), 0);
+        assertNotEquals(slist_append(list, NULL), NULL);
+        assertNotEquals(slist_remove_after(list, list->tail), 0);
+        assertEquals(slist_length(list), 1);
+    }
+}
+
+TEST(remove_after_works_at_front_and_end) {
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 4; i++) {
+            assertNotEquals(slist_append(list, &i), NULL);
+        }
+
+        // removing after NULL pops
+        assertEquals(slist_remove_after(list, NULL), 0);
+        assertEquals(*((int*) slist_first(list)), 1);
+
+        // removing the tail updates it
+        assertEquals(slist_remove_after(list, list->head->next), 0);
+        assertEquals(*((int*) slist_last(list)), 2);
+        assertEquals(slist_length(list), 2);
+
+        assertEquals(slist_remove_after(list, list->head), 0);
+        assertEquals(list->head, list->tail);
+        assertEquals(slist_remove_after(list, NULL), 0);
+        assertEquals(list->head, NULL);
+        assertEquals(list->tail, NULL);
+    }
+}
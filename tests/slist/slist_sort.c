@@ -0,0 +1,165 @@
+#include "helpers.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// orders ints ascending, see slist_compare_elements
+static int compare_ints(void *a, void *b) {
+    return *((int*)b) - *((int*)a);
+}
+
+// pairs of a key to sort by and the original position
+struct pair {
+    int key;
+    int pos;
+};
+
+static int compare_keys(void *a, void *b) {
+    return ((struct pair*)b)->key - ((struct pair*)a)->key;
+}
+
+TEST(sort_does_not_work_without_compare) {
+    USING(slist_new(sizeof(int))) {
+        assertTrue(slist_sort(list, NULL) < 0);
+        assertTrue(slist_sort(NULL, compare_ints) < 0);
+    }
+}
+
+TEST(sort_works_on_short_lists) {
+    int one = 1;
+
+    USING(slist_new(sizeof(int))) {
+        assertEquals(slist_sort(list, compare_ints), 0);
+        assertEquals(slist_length(list), 0);
+
+        slist_append(list, &one);
+        assertEquals(slist_sort(list, compare_ints), 0);
+        assertEquals(slist_length(list), 1);
+        assertEquals(*((int*)slist_first(list)), 1);
+    }
+}
+
+TEST(sort_orders_elements) {
+    srand(9);
+
+    for(int length = 2; length < 1000; length = length * 2 + 1) {
+        USING(slist_new(sizeof(int))) {
+            for(int i = 0; i < length; i++) {
+                int number = rand() % 100;
+                slist_append(list, &number);
+            }
+
+            void *first = slist_first(list);
+
+            assertEquals(slist_sort(list, compare_ints), 0);
+            assertEquals(slist_length(list), length);
+            assertEquals(slist_verify(list), 0);
+
+            int last = -1;
+            for(int i = 0; i < length; i++) {
+                assertNotEquals(slist_get(list, i, &ret), NULL);
+                assertTrue(last <= ret);
+                last = ret;
+            }
+
+            // nodes are relinked, not copied
+            int found = 0;
+            for(int i = 0; i < length; i++) {
+                if(slist_get(list, i, NULL) == first) {
+                    found++;
+                }
+            }
+
+            assertEquals(found, 1);
+            assertEquals(*((int*)slist_last(list)), last);
+        }
+    }
+}
+
+TEST(sort_is_stable) {
+    USING(slist_new(sizeof(struct pair))) {
+        struct pair pair;
+
+        for(pair.pos = 0; pair.pos < 500; pair.pos++) {
+            pair.key = (pair.pos * 7) % 10;
+            slist_append(list, &pair);
+        }
+
+        assertEquals(slist_sort(list, compare_keys), 0);
+
+        struct pair last = {-1, -1};
+        for(int i = 0; i < 500; i++) {
+            assertNotEquals(slist_get(list, i, &pair), NULL);
+            assertTrue(last.key <= pair.key);
+
+            if(last.key == pair.key) {
+                assertTrue(last.pos < pair.pos);
+            }
+
+            last = pair;
+        }
+    }
+}
+
+// records keyed by an unsigned integer
+struct record {
+    char tag;
+    uint64_t big;
+    uint16_t small;
+    int pos;
+};
+
+TEST(radix_sort_does_not_work_on_illegal_keys) {
+    USING(slist_new(sizeof(struct record))) {
+        assertTrue(slist_radix_sort(NULL, 0, 4) < 0);
+        assertTrue(slist_radix_sort(list, 0, 3) < 0);
+        assertTrue(slist_radix_sort(list, 0, 0) < 0);
+        assertTrue(slist_radix_sort(list, sizeof(struct record) - 1, 2) < 0);
+        assertEquals(slist_radix_sort(list, sizeof(struct record) - 2, 2), 0);
+    }
+}
+
+TEST(radix_sort_orders_elements) {
+    srand(17);
+
+    for(int length = 2; length < 5000; length = length * 3 + 1) {
+        USING(slist_new(sizeof(struct record))) {
+            struct record record = {0};
+
+            for(record.pos = 0; record.pos < length; record.pos++) {
+                record.big = ((uint64_t) rand() << 40) ^ rand();
+                record.small = rand() % 50;
+                slist_append(list, &record);
+            }
+
+            // sort by the 64 bit key
+            assertEquals(slist_radix_sort(list, offsetof(struct record, big), sizeof(uint64_t)), 0);
+            assertEquals(slist_length(list), length);
+            assertEquals(slist_verify(list), 0);
+
+            uint64_t last = 0;
+            for(int i = 0; i < length; i++) {
+                assertNotEquals(slist_get(list, i, &record), NULL);
+                assertTrue(last <= record.big);
+                last = record.big;
+            }
+
+            assertEquals(((struct record*)slist_last(list))->big, last);
+
+            // sort by the 16 bit key, which has many duplicates,
+            // and check that it is stable
+            assertEquals(slist_radix_sort(list, offsetof(struct record, small), sizeof(uint16_t)), 0);
+
+            struct record prev = {0, 0, 0, -1};
+            for(int i = 0; i < length; i++) {
+                assertNotEquals(slist_get(list, i, &record), NULL);
+                assertTrue(prev.small <= record.small);
+
+                if(prev.small == record.small) {
+                    assertTrue(prev.big <= record.big);
+                }
+
+                prev = record;
+            }
+        }
+    }
+}
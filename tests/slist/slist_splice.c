@@ -0,0 +1,103 @@
+#include "helpers.h"
+
+// fills list with count numbers, starting at first
+static void slist_fill(slist_t *list, int first, int count) {
+    for(int i = first; i < first + count; i++) {
+        slist_append(list, &i);
+    }
+}
+
+// checks that list holds exactly the given elements
+static int slist_holds(slist_t *list, const int *expected, size_t count) {
+    if(slist_length(list) != count || slist_verify(list) != 0) {
+        return 0;
+    }
+
+    for(size_t i = 0; i < count; i++) {
+        if(slist_get(list, i, &ret) == NULL || ret != expected[i]) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
+TEST(splice_does_not_work_on_illegal_ranges) {
+    slist_t *other = slist_new(sizeof(int));
+    slist_fill(other, 10, 5);
+
+    USING(slist_new(sizeof(int))) {
+        slist_fill(list, 0, 5);
+
+        assertNotEquals(slist_splice(list, 0, list, 1, 1), 0);
+        assertNotEquals(slist_splice(list, 6, other, 0, 1), 0);
+        assertNotEquals(slist_splice(list, 0, other, 6, 0), 0);
+        assertNotEquals(slist_splice(list, 0, other, 3, 3), 0);
+        assertEquals(slist_splice(list, 0, other, 5, 0), 0);
+
+        assertEquals(slist_length(list), 5);
+        assertEquals(slist_length(other), 5);
+    }
+
+    USING(slist_new(sizeof(char))) {
+        assertNotEquals(slist_splice(list, 0, other, 0, 1), 0);
+    }
+
+    slist_free(other);
+}
+
+TEST(splice_moves_nodes_without_copying) {
+    USING(slist_new(sizeof(int))) {
+        slist_t *other = slist_new(sizeof(int));
+        slist_fill(list, 0, 5);
+        slist_fill(other, 10, 5);
+
+        void *moved = slist_get(other, 1, NULL);
+
+        // move the middle of other into the middle of list
+        assertEquals(slist_splice(list, 2, other, 1, 3), 0);
+        assertEquals(slist_get(list, 2, NULL), moved);
+
+        int expected[] = { 0, 1, 11, 12, 13, 2, 3, 4 };
+        assertTrue(slist_holds(list, expected, 8));
+
+        int rest[] = { 10, 14 };
+        assertTrue(slist_holds(other, rest, 2));
+
+        // move the tail of list to the front of other
+        assertEquals(slist_splice(other, 0, list, 6, 2), 0);
+        int tail[] = { 3, 4, 10, 14 };
+        assertTrue(slist_holds(other, tail, 4));
+        assertEquals(*((int*) slist_last(list)), 2);
+
+        // move everything to the end of list
+        assertEquals(slist_splice(list, 6, other, 0, 4), 0);
+        int all[] = { 0, 1, 11, 12, 13, 2, 3, 4, 10, 14 };
+        assertTrue(slist_holds(list, all, 10));
+        assertTrue(slist_holds(other, NULL, 0));
+        assertEquals(slist_first(other), NULL);
+        assertEquals(slist_last(other), NULL);
+
+        // and into an empty list
+        assertEquals(slist_splice(other, 0, list, 0, 10), 0);
+        assertTrue(slist_holds(other, all, 10));
+        assertTrue(slist_holds(list, NULL, 0));
+
+        slist_free(other);
+    }
+}
+
+TEST(splice_works_with_pools) {
+    USING(slist_new_pooled(sizeof(int), 4)) {
+        slist_t *other = slist_new_pooled(sizeof(int), 4);
+        slist_fill(list, 0, 10);
+        slist_fill(other, 10, 10);
+
+        assertEquals(slist_splice(list, 10, other, 0, 10), 0);
+        assertEquals(slist_length(list), 20);
+
+        // nodes from either pool can be released by either list
+        assertEquals(slist_splice(other, 0, list, 5, 10), 0);
+        assertEquals(slist_free(other), 0);
+    }
+}
@@ -0,0 +1,52 @@
+#include "helpers.h"
+
+TEST(verify_finds_cycles) {
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            slist_append(list, &i);
+        }
+
+        // point the tail back into the middle
+        slist_node_t *middle = list->head->next->next;
+        list->tail->next = middle;
+        assertTrue(slist_verify(list) < 0);
+
+        // or make a loop before reaching the tail
+        list->tail->next = NULL;
+        slist_node_t *next = middle->next;
+        middle->next = list->head;
+        assertTrue(slist_verify(list) < 0);
+
+        middle->next = next;
+        assertEquals(slist_verify(list), 0);
+    }
+}
+
+TEST(verify_finds_wrong_length_and_tail) {
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            slist_append(list, &i);
+        }
+
+        list->length++;
+        assertTrue(slist_verify(list) < 0);
+        list->length -= 2;
+        assertTrue(slist_verify(list) < 0);
+        list->length++;
+
+        slist_node_t *tail = list->tail;
+        list->tail = list->head;
+        assertTrue(slist_verify(list) < 0);
+        list->tail = tail;
+    }
+}
+
+TEST(verify_works_on_large_list) {
+    USING(slist_new(sizeof(int))) {
+        for(int i = 0; i < 1000000; i++) {
+            slist_append(list, &i);
+        }
+
+        assertEquals(slist_verify(list), 0);
+    }
+}
@@ -27,9 +27,29 @@ TEST(new_sets_all_pointers_to_null);
 TEST(init_works_with_all_sizes);
 TEST(init_sets_all_pointers_to_null);
 
+/* slist_init_pooled() */
+TEST(init_pooled_works_with_all_sizes);
+TEST(init_pooled_recycles_nodes);
+TEST(init_pooled_split_and_join_share_nodes);
+
+/* slist_init_arena() */
+TEST(init_arena_does_not_work_without_arena);
+TEST(init_arena_works_with_all_sizes);
+TEST(init_arena_lists_are_released_by_reset);
+
+/* node cache */
+TEST(nodecache_reuses_nodes);
+TEST(nodecache_shares_nodes_between_threads);
+
+/* slist_init_allocator() */
+TEST(init_allocator_works_with_all_sizes);
+TEST(init_allocator_is_used_for_all_nodes);
+TEST(init_allocator_without_free_skips_purge);
+
 /* slist_purge() */
 TEST(purge_does_nothing_on_empty_list);
 TEST(purge_removes_all_elements_of_list);
+TEST(purge_keeps_pool_of_pooled_list);
 
 /* slist_free() */
 
@@ -48,17 +68,46 @@ TEST(insert_works_without_data);
 TEST(insert_returns_null_on_illegal);
 TEST(insert_works_with_data);
 
+/* slist_append_with(), slist_prepend_with(), slist_insert_with() */
+TEST(append_with_builds_elements_in_place);
+TEST(append_with_does_not_add_failed_elements);
+
+/* slist_generate() */
+TEST(generate_appends_elements);
+TEST(generate_does_not_add_anything_on_failure);
+
 /* slist_remove() */
 TEST(remove_on_empty_list_does_not_work);
 TEST(remove_in_beginning_works);
 TEST(remove_at_end_works);
 TEST(remove_in_middle_works);
 
+/* slist_insert_after(), slist_remove_after() */
+TEST(insert_after_works_at_front_and_end);
+TEST(insert_after_works_in_one_pass);
+TEST(remove_after_does_not_work_past_the_end);
+TEST(remove_after_works_at_front_and_end);
+
+/* slist_iter_init() */
+TEST(iter_does_not_work_without_list);
+TEST(iter_visits_all_nodes);
+TEST(iter_remove_filters_list);
+
+/* slist_get_range(), slist_set_range(), slist_insert_range(), slist_remove_range() */
+TEST(range_functions_do_not_work_on_illegal_ranges);
+TEST(get_and_set_range_work_correctly);
+TEST(insert_range_works_correctly);
+TEST(remove_range_works_correctly);
+
 /* slist_pop() */
 TEST(pop_works_on_empty_list);
 TEST(pop_works_on_single_list);
 TEST(pop_works_on_full_list);
 
+/* slist_pop_many() */
+TEST(pop_many_works_on_empty_list);
+TEST(pop_many_pops_in_batches);
+
 /* slist_set() */
 TEST(set_does_not_work_for_empty_list);
 TEST(set_does_not_work_for_illegal_index);
@@ -70,6 +119,8 @@ TEST(get_does_not_work_for_empty_list);
 TEST(get_does_not_work_for_illegal_index);
 TEST(get_works_without_data);
 TEST(get_works_with_data);
+TEST(get_remembers_last_node);
+TEST(get_finger_survives_mutations);
 
 /* slist_swap() */
 TEST(swap_does_not_work_on_empty_list);
@@ -88,9 +139,58 @@ TEST(join_does_not_work_on_different_element_sizes);
 TEST(join_works_on_empty_lists);
 TEST(join_works_on_full_lists);
 
+/* slist_splice() */
+TEST(splice_does_not_work_on_illegal_ranges);
+TEST(splice_moves_nodes_without_copying);
+TEST(splice_works_with_pools);
+
+/* slist_partition() */
+TEST(partition_does_not_work_on_illegal_outputs);
+TEST(partition_moves_nodes_in_order);
+TEST(partition_keeps_unclassified_elements);
+
 /* slist_copy() */
 TEST(copy_works_on_empty_list);
 TEST(copy_works_on_full_list);
+TEST(copy_lays_out_nodes_in_order);
+TEST(copy_can_be_modified_and_joined);
+
+/* slist_from_array(), slist_to_array() */
+TEST(from_array_does_not_work_without_data);
+TEST(from_array_copies_elements);
+TEST(from_array_lays_out_nodes_in_order);
+TEST(to_array_copies_elements);
+
+/* slist_compact() */
+TEST(compact_does_not_work_on_arena_lists);
+TEST(compact_moves_nodes_into_one_block);
+TEST(compact_step_works_in_rounds);
+
+/* slist_locality_stats() */
+TEST(locality_stats_does_not_work_on_null);
+TEST(locality_stats_measures_contiguous_list);
+TEST(locality_stats_sees_scattered_list);
+
+/* slist_sort() */
+TEST(sort_does_not_work_without_compare);
+TEST(sort_works_on_short_lists);
+TEST(sort_orders_elements);
+TEST(sort_is_stable);
+
+/* slist_radix_sort() */
+TEST(radix_sort_does_not_work_on_illegal_keys);
+TEST(radix_sort_orders_elements);
+
+/* slist_verify() */
+TEST(verify_finds_cycles);
+TEST(verify_finds_wrong_length_and_tail);
+TEST(verify_works_on_large_list);
+
+/* SLIST_DEFINE() */
+TEST(define_has_same_node_layout);
+TEST(define_basic_operations_work);
+TEST(define_sort_is_stable);
+TEST(define_find_works);
 
 TEST_SUITE(basic_data_access) {
     TEST_ADD(size_works_with_slist_new),
@@ -112,8 +212,20 @@ TEST_SUITE(creation_destruction) {
     TEST_ADD(new_sets_all_pointers_to_null),
     TEST_ADD(init_works_with_all_sizes),
     TEST_ADD(init_sets_all_pointers_to_null),
+    TEST_ADD(init_pooled_works_with_all_sizes),
+    TEST_ADD(init_pooled_recycles_nodes),
+    TEST_ADD(init_pooled_split_and_join_share_nodes),
+    TEST_ADD(init_arena_does_not_work_without_arena),
+    TEST_ADD(init_arena_works_with_all_sizes),
+    TEST_ADD(init_arena_lists_are_released_by_reset),
+    TEST_ADD(init_allocator_works_with_all_sizes),
+    TEST_ADD(init_allocator_is_used_for_all_nodes),
+    TEST_ADD(init_allocator_without_free_skips_purge),
+    TEST_ADD(nodecache_reuses_nodes),
+    TEST_ADD(nodecache_shares_nodes_between_threads),
     TEST_ADD(purge_does_nothing_on_empty_list),
     TEST_ADD(purge_removes_all_elements_of_list),
+    TEST_ADD(purge_keeps_pool_of_pooled_list),
     TEST_SUITE_CLOSURE
 };
 
@@ -127,6 +239,12 @@ TEST_SUITE(insertion) {
     TEST_ADD(insert_works_without_data),
     TEST_ADD(insert_returns_null_on_illegal),
     TEST_ADD(insert_works_with_data),
+    TEST_ADD(append_with_builds_elements_in_place),
+    TEST_ADD(append_with_does_not_add_failed_elements),
+    TEST_ADD(generate_appends_elements),
+    TEST_ADD(generate_does_not_add_anything_on_failure),
+    TEST_ADD(insert_after_works_at_front_and_end),
+    TEST_ADD(insert_after_works_in_one_pass),
     TEST_SUITE_CLOSURE
 };
 
@@ -134,10 +252,17 @@ TEST_SUITE(removal) {
     TEST_ADD(pop_works_on_empty_list),
     TEST_ADD(pop_works_on_single_list),
     TEST_ADD(pop_works_on_full_list),
+    TEST_ADD(pop_many_works_on_empty_list),
+    TEST_ADD(pop_many_pops_in_batches),
     TEST_ADD(remove_on_empty_list_does_not_work),
     TEST_ADD(remove_in_beginning_works),
     TEST_ADD(remove_at_end_works),
     TEST_ADD(remove_in_middle_works),
+    TEST_ADD(remove_after_does_not_work_past_the_end),
+    TEST_ADD(remove_after_works_at_front_and_end),
+    TEST_ADD(iter_does_not_work_without_list),
+    TEST_ADD(iter_visits_all_nodes),
+    TEST_ADD(iter_remove_filters_list),
     TEST_SUITE_CLOSURE
 };
 
@@ -146,10 +271,16 @@ TEST_SUITE(accessing) {
     TEST_ADD(get_does_not_work_for_illegal_index),
     TEST_ADD(get_works_without_data),
     TEST_ADD(get_works_with_data),
+    TEST_ADD(get_remembers_last_node),
+    TEST_ADD(get_finger_survives_mutations),
     TEST_ADD(set_does_not_work_for_empty_list),
     TEST_ADD(set_does_not_work_for_illegal_index),
     TEST_ADD(set_with_null_data_returns_null),
     TEST_ADD(set_works_with_data),
+    TEST_ADD(range_functions_do_not_work_on_illegal_ranges),
+    TEST_ADD(get_and_set_range_work_correctly),
+    TEST_ADD(insert_range_works_correctly),
+    TEST_ADD(remove_range_works_correctly),
     TEST_SUITE_CLOSURE
 };
 
@@ -165,8 +296,39 @@ TEST_SUITE(manipulation) {
     TEST_ADD(join_does_not_work_on_different_element_sizes),
     TEST_ADD(join_works_on_empty_lists),
     TEST_ADD(join_works_on_full_lists),
+    TEST_ADD(splice_does_not_work_on_illegal_ranges),
+    TEST_ADD(splice_moves_nodes_without_copying),
+    TEST_ADD(splice_works_with_pools),
+    TEST_ADD(partition_does_not_work_on_illegal_outputs),
+    TEST_ADD(partition_moves_nodes_in_order),
+    TEST_ADD(partition_keeps_unclassified_elements),
     TEST_ADD(copy_works_on_empty_list),
     TEST_ADD(copy_works_on_full_list),
+    TEST_ADD(copy_lays_out_nodes_in_order),
+    TEST_ADD(copy_can_be_modified_and_joined),
+    TEST_ADD(from_array_does_not_work_without_data),
+    TEST_ADD(from_array_copies_elements),
+    TEST_ADD(from_array_lays_out_nodes_in_order),
+    TEST_ADD(to_array_copies_elements),
+    TEST_ADD(compact_does_not_work_on_arena_lists),
+    TEST_ADD(compact_moves_nodes_into_one_block),
+    TEST_ADD(compact_step_works_in_rounds),
+    TEST_ADD(locality_stats_does_not_work_on_null),
+    TEST_ADD(locality_stats_measures_contiguous_list),
+    TEST_ADD(locality_stats_sees_scattered_list),
+    TEST_ADD(sort_does_not_work_without_compare),
+    TEST_ADD(sort_works_on_short_lists),
+    TEST_ADD(sort_orders_elements),
+    TEST_ADD(sort_is_stable),
+    TEST_ADD(radix_sort_does_not_work_on_illegal_keys),
+    TEST_ADD(radix_sort_orders_elements),
+    TEST_ADD(verify_finds_cycles),
+    TEST_ADD(verify_finds_wrong_length_and_tail),
+    TEST_ADD(verify_works_on_large_list),
+    TEST_ADD(define_has_same_node_layout),
+    TEST_ADD(define_basic_operations_work),
+    TEST_ADD(define_sort_is_stable),
+    TEST_ADD(define_find_works),
     TEST_SUITE_CLOSURE
 };
 
@@ -0,0 +1,8 @@
+#include "../cu/cu.h"
+#include "../../clists/ulist.h"
+#include "helpers.h"
+
+void check_and_free(ulist_t *list) {
+    assertEquals(ulist_verify(list), 0);
+    ulist_free(list);
+}
@@ -0,0 +1,128 @@
+#include "cu/cu.h"
+
+/* ulist_new() */
+TEST(new_works_with_all_sizes);
+TEST(new_sets_all_pointers_to_null);
+TEST(new_fits_small_elements_into_nodes);
+
+/* ulist_purge() */
+TEST(purge_removes_all_elements_of_list);
+
+/* ulist_append() */
+TEST(append_sets_both_head_and_tail);
+TEST(append_works_across_nodes);
+
+/* ulist_prepend() */
+TEST(prepend_sets_both_head_and_tail);
+TEST(prepend_works_across_nodes);
+
+/* ulist_insert() */
+TEST(insert_returns_null_on_illegal);
+TEST(insert_splits_full_nodes);
+
+/* ulist_remove() */
+TEST(remove_on_empty_list_does_not_work);
+TEST(remove_frees_empty_nodes);
+TEST(remove_in_middle_merges_nodes);
+
+/* ulist_pop() */
+TEST(pop_works_on_empty_list);
+TEST(pop_works_on_full_list);
+
+/* ulist_get() */
+TEST(get_does_not_work_for_illegal_index);
+TEST(get_works_with_data);
+
+/* ulist_set() */
+TEST(set_does_not_work_for_illegal_index);
+TEST(set_works_with_data);
+
+/* ulist_foreach() */
+TEST(foreach_visits_all_elements_in_order);
+
+/* ulist_swap() */
+TEST(swap_does_not_work_on_nonexisting_indices);
+TEST(swap_works_correctly_with_different_indices);
+
+/* ulist_split() */
+TEST(split_does_not_work_on_illegal_pos);
+TEST(split_works_at_every_position);
+
+/* ulist_join() */
+TEST(join_does_not_work_on_different_element_sizes);
+TEST(join_works_on_empty_lists);
+TEST(join_works_on_full_lists);
+
+/* ulist_copy() */
+TEST(copy_works_on_empty_list);
+TEST(copy_works_on_full_list);
+
+TEST_SUITE(creation_destruction) {
+    TEST_ADD(new_works_with_all_sizes),
+    TEST_ADD(new_sets_all_pointers_to_null),
+    TEST_ADD(new_fits_small_elements_into_nodes),
+    TEST_ADD(purge_removes_all_elements_of_list),
+    TEST_SUITE_CLOSURE
+};
+
+TEST_SUITE(insertion) {
+    TEST_ADD(append_sets_both_head_and_tail),
+    TEST_ADD(append_works_across_nodes),
+    TEST_ADD(prepend_sets_both_head_and_tail),
+    TEST_ADD(prepend_works_across_nodes),
+    TEST_ADD(insert_returns_null_on_illegal),
+    TEST_ADD(insert_splits_full_nodes),
+    TEST_SUITE_CLOSURE
+};
+
+TEST_SUITE(removal) {
+    TEST_ADD(pop_works_on_empty_list),
+    TEST_ADD(pop_works_on_full_list),
+    TEST_ADD(remove_on_empty_list_does_not_work),
+    TEST_ADD(remove_frees_empty_nodes),
+    TEST_ADD(remove_in_middle_merges_nodes),
+    TEST_SUITE_CLOSURE
+};
+
+TEST_SUITE(accessing) {
+    TEST_ADD(get_does_not_work_for_illegal_index),
+    TEST_ADD(get_works_with_data),
+    TEST_ADD(set_does_not_work_for_illegal_index),
+    TEST_ADD(set_works_with_data),
+    TEST_ADD(foreach_visits_all_elements_in_order),
+    TEST_SUITE_CLOSURE
+};
+
+TEST_SUITE(manipulation) {
+    TEST_ADD(swap_does_not_work_on_nonexisting_indices),
+    TEST_ADD(swap_works_correctly_with_different_indices),
+    TEST_ADD(split_does_not_work_on_illegal_pos),
+    TEST_ADD(split_works_at_every_position),
+    TEST_ADD(join_does_not_work_on_different_element_sizes),
+    TEST_ADD(join_works_on_empty_lists),
+    TEST_ADD(join_works_on_full_lists),
+    TEST_ADD(copy_works_on_empty_list),
+    TEST_ADD(copy_works_on_full_list),
+    TEST_SUITE_CLOSURE
+};
+
+/* test suites */
+TEST_SUITES {
+    TEST_SUITE_ADD(creation_destruction),
+    TEST_SUITE_ADD(insertion),
+    TEST_SUITE_ADD(removal),
+    TEST_SUITE_ADD(accessing),
+    TEST_SUITE_ADD(manipulation),
+    TEST_SUITES_CLOSURE
+};
+
+int main(int argc, char *argv[])
+{
+    CU_SET_NAME("ulist");
+    CU_SET_OUT_PREFIX("output/");
+    CU_RUN(argc, argv);
+
+    // set return value according to whether
+    // there were any failures
+    return (cu_fail_test_suites > 0) ? -1 : 0;
+}
@@ -0,0 +1,32 @@
+#include "helpers.h"
+
+TEST(append_sets_both_head_and_tail) {
+    int one = 1;
+
+    USING(ulist_new(sizeof(int))) {
+        assertNotEquals(ulist_append(list, &one), NULL);
+        assertNotEquals(list->head, NULL);
+        assertEquals(list->head, list->tail);
+        assertEquals(*((int*)ulist_first(list)), one);
+        assertEquals(*((int*)ulist_last(list)), one);
+    }
+}
+
+TEST(append_works_across_nodes) {
+    USING(ulist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            int *element = ulist_append(list, &i);
+            assertNotEquals(element, NULL);
+            assertEquals(*element, i);
+            assertEquals(ulist_length(list), i + 1);
+        }
+
+        assertNotEquals(list->head, list->tail);
+        assertEquals(ulist_verify(list), 0);
+
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(ulist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#include "helpers.h"
+
+TEST(copy_works_on_empty_list) {
+    USING(ulist_new(sizeof(int))) {
+        ulist_t *copy = ulist_copy(list);
+        assertNotEquals(copy, NULL);
+        assertEquals(ulist_verify(copy), 0);
+        assertEquals(ulist_length(copy), 0);
+        assertEquals(ulist_size(copy), sizeof(int));
+        ulist_free(copy);
+    }
+}
+
+TEST(copy_works_on_full_list) {
+    USING(ulist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            ulist_append(list, &i);
+        }
+
+        ulist_t *copy = ulist_copy(list);
+        assertNotEquals(copy, NULL);
+        assertEquals(ulist_verify(copy), 0);
+        assertEquals(ulist_length(copy), 100);
+
+        for(int i = 0; i < 100; i++) {
+            int *orig = ulist_get(list, i, NULL);
+            int *copied = ulist_get(copy, i, NULL);
+            assertNotEquals(orig, copied);
+            assertEquals(*orig, *copied);
+        }
+
+        ulist_free(copy);
+    }
+}
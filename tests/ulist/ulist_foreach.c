@@ -0,0 +1,24 @@
+#include "helpers.h"
+
+TEST(foreach_visits_all_elements_in_order) {
+    USING(ulist_new(sizeof(int))) {
+        int count = 0;
+
+        ulist_foreach(list, element) {
+            count++;
+        }
+
+        assertEquals(count, 0);
+
+        for(int i = 0; i < 100; i++) {
+            ulist_append(list, &i);
+        }
+
+        ulist_foreach(list, element) {
+            assertEquals(*((int*)element), count);
+            count++;
+        }
+
+        assertEquals(count, 100);
+    }
+}
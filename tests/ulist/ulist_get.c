@@ -0,0 +1,55 @@
+#include "helpers.h"
+
+TEST(get_does_not_work_for_illegal_index) {
+    int one = 1;
+
+    USING(ulist_new(sizeof(int))) {
+        assertEquals(ulist_get(list, 0, NULL), NULL);
+        ulist_append(list, &one);
+        assertEquals(ulist_get(list, 1, NULL), NULL);
+    }
+}
+
+TEST(get_works_with_data) {
+    USING(ulist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            ulist_append(list, &i);
+        }
+
+        for(int i = 0; i < 100; i++) {
+            int *element = ulist_get(list, i, &ret);
+            assertNotEquals(element, NULL);
+            assertEquals(*element, i);
+            assertEquals(ret, i);
+        }
+    }
+}
+
+TEST(set_does_not_work_for_illegal_index) {
+    int one = 1;
+
+    USING(ulist_new(sizeof(int))) {
+        assertEquals(ulist_set(list, 0, &one), NULL);
+        ulist_append(list, &one);
+        assertEquals(ulist_set(list, 1, &one), NULL);
+        assertEquals(ulist_set(list, 0, NULL), NULL);
+    }
+}
+
+TEST(set_works_with_data) {
+    USING(ulist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            ulist_append(list, NULL);
+        }
+
+        for(int i = 0; i < 100; i++) {
+            int value = 3 * i;
+            assertNotEquals(ulist_set(list, i, &value), NULL);
+        }
+
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(ulist_get(list, i, &ret), NULL);
+            assertEquals(ret, 3 * i);
+        }
+    }
+}
@@ -0,0 +1,34 @@
+#include "helpers.h"
+
+TEST(insert_returns_null_on_illegal) {
+    USING(ulist_new(sizeof(int))) {
+        assertEquals(ulist_insert(list, 1, NULL), NULL);
+        assertNotEquals(ulist_insert(list, 0, NULL), NULL);
+        assertEquals(ulist_insert(list, 2, NULL), NULL);
+        assertEquals(ulist_length(list), 1);
+    }
+}
+
+TEST(insert_splits_full_nodes) {
+    USING(ulist_new(sizeof(int))) {
+        // fill the list with even numbers, then insert
+        // the odd ones in between
+        for(int i = 0; i < 100; i += 2) {
+            ulist_append(list, &i);
+        }
+
+        for(int i = 1; i < 100; i += 2) {
+            int *element = ulist_insert(list, i, &i);
+            assertNotEquals(element, NULL);
+            assertEquals(*element, i);
+            assertEquals(ulist_verify(list), 0);
+        }
+
+        assertEquals(ulist_length(list), 100);
+
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(ulist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+        }
+    }
+}
@@ -0,0 +1,52 @@
+#include "helpers.h"
+
+TEST(join_does_not_work_on_different_element_sizes) {
+    USING(ulist_new(sizeof(int))) {
+        ulist_t *other = ulist_new(sizeof(char));
+        assertEquals(ulist_join(list, other), NULL);
+        ulist_free(other);
+    }
+}
+
+TEST(join_works_on_empty_lists) {
+    int one = 1;
+
+    USING(ulist_new(sizeof(int))) {
+        ulist_t *other = ulist_new(sizeof(int));
+        assertEquals(ulist_join(list, other), list);
+        assertEquals(ulist_length(list), 0);
+
+        ulist_append(other, &one);
+        assertEquals(ulist_join(list, other), list);
+        assertEquals(ulist_length(list), 1);
+        assertEquals(ulist_length(other), 0);
+        assertEquals(ulist_verify(other), 0);
+
+        ulist_free(other);
+    }
+}
+
+TEST(join_works_on_full_lists) {
+    USING(ulist_new(sizeof(int))) {
+        ulist_t *other = ulist_new(sizeof(int));
+
+        for(int i = 0; i < 50; i++) {
+            ulist_append(list, &i);
+        }
+
+        for(int i = 50; i < 100; i++) {
+            ulist_append(other, &i);
+        }
+
+        assertEquals(ulist_join(list, other), list);
+        assertEquals(ulist_length(list), 100);
+        assertEquals(ulist_length(other), 0);
+
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(ulist_get(list, i, &ret), NULL);
+            assertEquals(ret, i);
+        }
+
+        ulist_free(other);
+    }
+}
@@ -0,0 +1,31 @@
+#include "helpers.h"
+
+TEST(new_works_with_all_sizes) {
+    for(size_t size = 1; size < 256; size++) {
+        USING(ulist_new(size)) {
+            assertNotEquals(list, NULL);
+            assertEquals(ulist_size(list), size);
+            assertEquals(ulist_length(list), 0);
+        }
+    }
+}
+
+TEST(new_sets_all_pointers_to_null) {
+    USING(ulist_new(sizeof(int))) {
+        assertEquals(list->head, NULL);
+        assertEquals(list->tail, NULL);
+        assertEquals(ulist_first(list), NULL);
+        assertEquals(ulist_last(list), NULL);
+    }
+}
+
+TEST(new_fits_small_elements_into_nodes) {
+    USING(ulist_new(sizeof(char))) {
+        assertTrue(list->per_node > ULIST_MIN_PER_NODE);
+        assertTrue((sizeof(ulist_node_t) + list->per_node) <= ULIST_NODE_BYTES);
+    }
+
+    USING(ulist_new(1024)) {
+        assertEquals(list->per_node, ULIST_MIN_PER_NODE);
+    }
+}
@@ -0,0 +1,23 @@
+#include "helpers.h"
+
+TEST(pop_works_on_empty_list) {
+    USING(ulist_new(sizeof(int))) {
+        assertEquals(ulist_pop(list, &ret), NULL);
+    }
+}
+
+TEST(pop_works_on_full_list) {
+    USING(ulist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            ulist_append(list, &i);
+        }
+
+        for(int i = 0; i < 100; i++) {
+            assertEquals(ulist_pop(list, &ret), &ret);
+            assertEquals(ret, i);
+            assertEquals(ulist_length(list), 99 - i);
+        }
+
+        assertEquals(ulist_pop(list, &ret), NULL);
+    }
+}
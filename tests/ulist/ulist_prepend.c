@@ -0,0 +1,30 @@
+#include "helpers.h"
+
+TEST(prepend_sets_both_head_and_tail) {
+    int one = 1;
+
+    USING(ulist_new(sizeof(int))) {
+        assertNotEquals(ulist_prepend(list, &one), NULL);
+        assertNotEquals(list->head, NULL);
+        assertEquals(list->head, list->tail);
+        assertEquals(*((int*)ulist_first(list)), one);
+    }
+}
+
+TEST(prepend_works_across_nodes) {
+    USING(ulist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(ulist_prepend(list, &i), NULL);
+            assertEquals(*((int*)ulist_first(list)), i);
+            assertEquals(*((int*)ulist_last(list)), 0);
+        }
+
+        assertEquals(ulist_length(list), 100);
+        assertEquals(ulist_verify(list), 0);
+
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(ulist_get(list, i, &ret), NULL);
+            assertEquals(ret, 99 - i);
+        }
+    }
+}
@@ -0,0 +1,17 @@
+#include "helpers.h"
+
+TEST(purge_removes_all_elements_of_list) {
+    USING(ulist_new(sizeof(int))) {
+        assertEquals(ulist_purge(list), list);
+
+        for(int i = 0; i < 100; i++) {
+            ulist_append(list, &i);
+        }
+
+        assertEquals(ulist_purge(list), list);
+        assertEquals(ulist_length(list), 0);
+        assertEquals(list->head, NULL);
+        assertEquals(list->tail, NULL);
+        assertEquals(ulist_size(list), sizeof(int));
+    }
+}
@@ -0,0 +1,65 @@
+#include "helpers.h"
+
+TEST(remove_on_empty_list_does_not_work) {
+    USING(ulist_new(sizeof(int))) {
+        assertEquals(ulist_remove(list, 0), -1);
+    }
+}
+
+TEST(remove_frees_empty_nodes) {
+    USING(ulist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            ulist_append(list, &i);
+        }
+
+        // remove from the end
+        for(int i = 99; i >= 50; i--) {
+            assertEquals(ulist_remove(list, i), 0);
+            assertEquals(ulist_verify(list), 0);
+            assertEquals(*((int*)ulist_last(list)), i - 1);
+        }
+
+        // remove from the beginning
+        for(int i = 0; i < 50; i++) {
+            assertEquals(*((int*)ulist_first(list)), i);
+            assertEquals(ulist_remove(list, 0), 0);
+            assertEquals(ulist_verify(list), 0);
+        }
+
+        assertEquals(ulist_length(list), 0);
+        assertEquals(list->head, NULL);
+        assertEquals(list->tail, NULL);
+    }
+}
+
+TEST(remove_in_middle_merges_nodes) {
+    USING(ulist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            ulist_append(list, &i);
+        }
+
+        // remove every odd element
+        for(int i = 1; i < 50; i++) {
+            assertEquals(ulist_remove(list, i), 0);
+            assertEquals(ulist_verify(list), 0);
+        }
+
+        assertEquals(ulist_length(list), 51);
+
+        for(int i = 0; i < 50; i++) {
+            assertNotEquals(ulist_get(list, i, &ret), NULL);
+            assertEquals(ret, 2 * i);
+        }
+
+        assertNotEquals(ulist_get(list, 50, &ret), NULL);
+        assertEquals(ret, 99);
+
+        // nodes should not have become sparse
+        size_t nodes = 0;
+        for(ulist_node_t *node = list->head; node != NULL; node = node->next) {
+            nodes++;
+        }
+
+        assertTrue(nodes <= (2 * 51 / list->per_node) + 1);
+    }
+}
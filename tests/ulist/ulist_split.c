@@ -0,0 +1,37 @@
+#include "helpers.h"
+
+TEST(split_does_not_work_on_illegal_pos) {
+    USING(ulist_new(sizeof(int))) {
+        assertEquals(ulist_split(list, 0), NULL);
+        ulist_append(list, NULL);
+        assertEquals(ulist_split(list, 1), NULL);
+    }
+}
+
+TEST(split_works_at_every_position) {
+    for(int pos = 0; pos < 50; pos++) {
+        USING(ulist_new(sizeof(int))) {
+            for(int i = 0; i < 50; i++) {
+                ulist_append(list, &i);
+            }
+
+            ulist_t *splt = ulist_split(list, pos);
+            assertNotEquals(splt, NULL);
+            assertEquals(ulist_verify(splt), 0);
+            assertEquals(ulist_length(list), pos);
+            assertEquals(ulist_length(splt), 50 - pos);
+
+            for(int i = 0; i < pos; i++) {
+                assertNotEquals(ulist_get(list, i, &ret), NULL);
+                assertEquals(ret, i);
+            }
+
+            for(int i = pos; i < 50; i++) {
+                assertNotEquals(ulist_get(splt, i - pos, &ret), NULL);
+                assertEquals(ret, i);
+            }
+
+            ulist_free(splt);
+        }
+    }
+}
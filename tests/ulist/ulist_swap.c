@@ -0,0 +1,28 @@
+#include "helpers.h"
+
+TEST(swap_does_not_work_on_nonexisting_indices) {
+    USING(ulist_new(sizeof(int))) {
+        assertEquals(ulist_swap(list, 0, 0), -1);
+        ulist_append(list, NULL);
+        assertEquals(ulist_swap(list, 0, 1), -1);
+        assertEquals(ulist_swap(list, 0, 0), 0);
+    }
+}
+
+TEST(swap_works_correctly_with_different_indices) {
+    USING(ulist_new(sizeof(int))) {
+        for(int i = 0; i < 100; i++) {
+            ulist_append(list, &i);
+        }
+
+        // reverse the list
+        for(int i = 0; i < 50; i++) {
+            assertEquals(ulist_swap(list, i, 99 - i), 0);
+        }
+
+        for(int i = 0; i < 100; i++) {
+            assertNotEquals(ulist_get(list, i, &ret), NULL);
+            assertEquals(ret, 99 - i);
+        }
+    }
+}
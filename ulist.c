@@ -0,0 +1,652 @@
+/*  File: ulist.c
+ *
+ *  Copyright (C) 2011, Patrick M. Elsen
+ *
+ *  This file is part of CLists (http://github.com/xfbs/CLists)
+ *  Author: Patrick M. Elsen <pelsen.vn (a) gmail.com>
+ *
+ *  All rights reserved.
+ *
+ *  This program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License along
+ *  with this program; if not, write to the Free Software Foundation, Inc.,
+ *  51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "clists/ulist.h"
+#include <assert.h>
+
+// get a pointer to the element at index i of a node
+#define ulist_element(list, node, i) ((node)->data + ((i) * (list)->size))
+
+// swap two variables
+#define swap(x,y) do {   \
+    typeof(x) _x = x;      \
+    typeof(y) _y = y;      \
+    x = _y;                \
+    y = _x;                \
+    } while(0)
+
+// allocate a new, empty node for the list
+static ulist_node_t *ulist_node_new(const ulist_t *list);
+
+// get the node holding the element at pos and the offset
+// of the element in that node. if prev is not NULL, the
+// node before it is stored there.
+static ulist_node_t *ulist_node_get(const ulist_t *list, size_t pos, size_t *offset, ulist_node_t **prev);
+
+size_t ulist_size(const ulist_t *list) {
+    if(list != NULL) {
+        return list->size;
+    }
+
+    return 0;
+}
+
+size_t ulist_length(const ulist_t *list) {
+    if(list != NULL) {
+        return list->length;
+    }
+
+    return 0;
+}
+
+void *ulist_first(const ulist_t *list) {
+    if(list != NULL && list->head != NULL) {
+        return ulist_element(list, list->head, 0);
+    }
+
+    return NULL;
+}
+
+void *ulist_last(const ulist_t *list) {
+    if(list != NULL && list->tail != NULL) {
+        return ulist_element(list, list->tail, list->tail->count - 1);
+    }
+
+    return NULL;
+}
+
+ulist_t *ulist_new(size_t size)
+{
+    // allocate memory for new list
+    ulist_t *list = malloc(sizeof(ulist_t));
+
+    // check if memory allocation worked
+    if(list == NULL) {
+        return NULL;
+    }
+
+    return ulist_init(list, size);
+}
+
+ulist_t *ulist_init(ulist_t *list, size_t size)
+{
+    // make sure list exists
+    if(list == NULL) {
+        return NULL;
+    }
+
+    // initialize memory
+    memset(list, 0, sizeof(ulist_t));
+
+    // set size
+    list->size = size;
+
+    // fit as many elements into a node as possible
+    // without going over ULIST_NODE_BYTES
+    list->per_node = ULIST_MIN_PER_NODE;
+    if(size > 0 && ((ULIST_NODE_BYTES - sizeof(ulist_node_t)) / size) > ULIST_MIN_PER_NODE) {
+        list->per_node = (ULIST_NODE_BYTES - sizeof(ulist_node_t)) / size;
+    }
+
+    return list;
+}
+
+ulist_t *ulist_purge(ulist_t *list)
+{
+    ulist_node_t *cur = list->head;
+    ulist_node_t *next;
+
+    while(cur != NULL) {
+        next = cur->next;
+        free(cur);
+        cur = next;
+    }
+
+    // reset everything but size and per_node
+    list->head = NULL;
+    list->tail = NULL;
+    list->length = 0;
+
+    return list;
+}
+
+int ulist_free(ulist_t *list)
+{
+    // can't free a NULL pointer
+    if(list == NULL) {
+        return -1;
+    }
+
+    ulist_purge(list);
+    free(list);
+
+    return 0;
+}
+
+void *ulist_append(ulist_t *list, const void *data)
+{
+    ulist_node_t *node = list->tail;
+
+    // if the last node is full (or there is none), we
+    // need a new one
+    if(node == NULL || node->count == list->per_node) {
+        ulist_node_t *new = ulist_node_new(list);
+
+        // make sure allocation worked
+        if(new == NULL) {
+            return NULL;
+        }
+
+        if(node != NULL) {
+            node->next = new;
+        } else {
+            list->head = new;
+        }
+
+        list->tail = new;
+        node = new;
+    }
+
+    // the new element goes at the end of the node
+    void *element = ulist_element(list, node, node->count);
+    node->count++;
+    list->length++;
+
+    if(data != NULL) {
+        memcpy(element, data, list->size);
+    }
+
+    return element;
+}
+
+void *ulist_prepend(ulist_t *list, const void *data)
+{
+    ulist_node_t *node = list->head;
+
+    if(node == NULL || node->count == list->per_node) {
+        // the first node is full (or there is none), so
+        // we need a new one
+        ulist_node_t *new = ulist_node_new(list);
+
+        // make sure allocation worked
+        if(new == NULL) {
+            return NULL;
+        }
+
+        new->next = node;
+        list->head = new;
+
+        if(list->tail == NULL) {
+            list->tail = new;
+        }
+
+        node = new;
+    } else {
+        // make space for the new element
+        memmove(ulist_element(list, node, 1),
+                ulist_element(list, node, 0),
+                node->count * list->size);
+    }
+
+    node->count++;
+    list->length++;
+
+    if(data != NULL) {
+        memcpy(node->data, data, list->size);
+    }
+
+    return node->data;
+}
+
+void *ulist_insert(ulist_t *list, size_t pos, const void *data)
+{
+    // there are some special cases where we can call
+    // some optimized functions
+    if(pos == 0) {
+        return ulist_prepend(list, data);
+    } else if(pos == list->length) {
+        return ulist_append(list, data);
+    } else if(pos > list->length) {
+        return NULL;
+    }
+
+    // find the node that holds the element at pos
+    size_t offset;
+    ulist_node_t *node = ulist_node_get(list, pos, &offset, NULL);
+    assert(node != NULL);
+
+    // if the node is full, split it in half
+    if(node->count == list->per_node) {
+        ulist_node_t *new = ulist_node_new(list);
+
+        // make sure allocation worked
+        if(new == NULL) {
+            return NULL;
+        }
+
+        size_t half = node->count / 2;
+
+        // move upper half into new node
+        memcpy(new->data,
+               ulist_element(list, node, half),
+               (node->count - half) * list->size);
+        new->count = node->count - half;
+        node->count = half;
+
+        // link new node
+        new->next = node->next;
+        node->next = new;
+
+        if(list->tail == node) {
+            list->tail = new;
+        }
+
+        // figure out which half the element goes into
+        if(offset > half) {
+            node = new;
+            offset -= half;
+        }
+    }
+
+    // make space for the new element
+    memmove(ulist_element(list, node, offset + 1),
+            ulist_element(list, node, offset),
+            (node->count - offset) * list->size);
+
+    node->count++;
+    list->length++;
+
+    void *element = ulist_element(list, node, offset);
+
+    if(data != NULL) {
+        memcpy(element, data, list->size);
+    }
+
+    return element;
+}
+
+int ulist_remove(ulist_t *list, size_t pos)
+{
+    // can't remove something which is not in the list
+    if(pos >= list->length) {
+        return -1;
+    }
+
+    size_t offset;
+    ulist_node_t *prev;
+    ulist_node_t *node = ulist_node_get(list, pos, &offset, &prev);
+    assert(node != NULL);
+
+    // close the gap
+    memmove(ulist_element(list, node, offset),
+            ulist_element(list, node, offset + 1),
+            (node->count - offset - 1) * list->size);
+
+    node->count--;
+    list->length--;
+
+    if(node->count == 0) {
+        // empty nodes are not allowed, unlink it
+        if(prev != NULL) {
+            prev->next = node->next;
+        } else {
+            list->head = node->next;
+        }
+
+        if(list->tail == node) {
+            list->tail = prev;
+        }
+
+        free(node);
+    } else if(node->next != NULL &&
+            node->count < (list->per_node / 2) &&
+            (node->count + node->next->count) <= list->per_node) {
+        // the node is less than half full, merge the next
+        // one into it so nodes don't get sparse
+        ulist_node_t *next = node->next;
+
+        memcpy(ulist_element(list, node, node->count),
+               next->data,
+               next->count * list->size);
+
+        node->count += next->count;
+        node->next = next->next;
+
+        if(list->tail == next) {
+            list->tail = node;
+        }
+
+        free(next);
+    }
+
+    return 0;
+}
+
+void *ulist_set(ulist_t *list, size_t pos, const void *data)
+{
+    size_t offset;
+    ulist_node_t *node = ulist_node_get(list, pos, &offset, NULL);
+
+    // make sure node exists
+    if(node == NULL || data == NULL) {
+        return NULL;
+    }
+
+    void *element = ulist_element(list, node, offset);
+    memcpy(element, data, list->size);
+
+    return element;
+}
+
+void *ulist_get(const ulist_t *list, size_t pos, void *data)
+{
+    size_t offset;
+    ulist_node_t *node = ulist_node_get(list, pos, &offset, NULL);
+
+    // make sure node exists
+    if(node == NULL) {
+        return NULL;
+    }
+
+    void *element = ulist_element(list, node, offset);
+
+    if(data != NULL) {
+        memcpy(data, element, list->size);
+    }
+
+    return element;
+}
+
+void *ulist_pop(ulist_t *list, void *data)
+{
+    // make sure list isn't empty
+    if(list->head == NULL) {
+        assert(list->length == 0);
+        return NULL;
+    }
+
+    // copy data if requested
+    if(data != NULL) {
+        memcpy(data, list->head->data, list->size);
+    }
+
+    ulist_remove(list, 0);
+
+    return data;
+}
+
+int ulist_swap(ulist_t *list, size_t pos_a, size_t pos_b)
+{
+    // if elements don't exist, we can't swap 'em
+    if(pos_a >= list->length || pos_b >= list->length) {
+        return -1;
+    }
+
+    // swapping an element with itself is a nop
+    if(pos_a == pos_b) {
+        return 0;
+    }
+
+    char *a = ulist_get(list, pos_a, NULL);
+    char *b = ulist_get(list, pos_b, NULL);
+    assert(a != NULL && b != NULL);
+
+    // swap byte by byte, so we don't need a buffer
+    for(size_t i = 0; i < list->size; i++) {
+        swap(a[i], b[i]);
+    }
+
+    return 0;
+}
+
+ulist_t *ulist_split(ulist_t *list, size_t pos)
+{
+    // check if pos actually points to anything useful
+    if(pos >= list->length) {
+        return NULL;
+    }
+
+    // allocate new list
+    ulist_t *new = ulist_new(list->size);
+
+    if(new == NULL) {
+        return NULL;
+    }
+
+    new->per_node = list->per_node;
+
+    size_t offset;
+    ulist_node_t *prev;
+    ulist_node_t *node = ulist_node_get(list, pos, &offset, &prev);
+    assert(node != NULL);
+
+    if(offset == 0) {
+        // the split happens between prev and node
+        new->head = node;
+        new->tail = list->tail;
+        list->tail = prev;
+
+        if(prev != NULL) {
+            prev->next = NULL;
+        } else {
+            list->head = NULL;
+        }
+    } else {
+        // the split happens inside of node, so move the
+        // elements from offset on into a new node
+        ulist_node_t *second = ulist_node_new(list);
+
+        if(second == NULL) {
+            free(new);
+            return NULL;
+        }
+
+        memcpy(second->data,
+               ulist_element(list, node, offset),
+               (node->count - offset) * list->size);
+        second->count = node->count - offset;
+        node->count = offset;
+
+        second->next = node->next;
+        node->next = NULL;
+
+        new->head = second;
+        new->tail = (list->tail == node) ? second : list->tail;
+        list->tail = node;
+    }
+
+    // update the lengths of both lists
+    new->length = list->length - pos;
+    list->length = pos;
+
+    return new;
+}
+
+ulist_t *ulist_join(ulist_t *dest, ulist_t *src)
+{
+    // nodes must be interchangeable
+    if(src->size != dest->size || src->per_node != dest->per_node) {
+        return NULL;
+    }
+
+    // if there is nothing to copy, just return dest
+    if(src->length == 0) {
+        return dest;
+    }
+
+    if(dest->length == 0) {
+        dest->head = src->head;
+    } else {
+        dest->tail->next = src->head;
+    }
+
+    dest->tail = src->tail;
+    dest->length += src->length;
+
+    // reset src, but keep data size
+    src->head = NULL;
+    src->tail = NULL;
+    src->length = 0;
+
+    return dest;
+}
+
+ulist_t *ulist_copy(const ulist_t *list)
+{
+    // allocate a new list
+    ulist_t *copy = ulist_new(list->size);
+
+    // memory error checking
+    if(copy == NULL) {
+        return NULL;
+    }
+
+    copy->per_node = list->per_node;
+
+    // copy whole nodes at a time
+    for(ulist_node_t *node = list->head; node != NULL; node = node->next) {
+        ulist_node_t *new = ulist_node_new(copy);
+
+        if(new == NULL) {
+            ulist_free(copy);
+            return NULL;
+        }
+
+        memcpy(new->data, node->data, node->count * list->size);
+        new->count = node->count;
+
+        if(copy->tail != NULL) {
+            copy->tail->next = new;
+        } else {
+            copy->head = new;
+        }
+
+        copy->tail = new;
+        copy->length += new->count;
+    }
+
+    return copy;
+}
+
+int ulist_verify(const ulist_t *list)
+{
+    if(list == NULL) {
+        return -1;
+    }
+
+    // an empty list has no nodes
+    if(list->length == 0) {
+        if(list->head != NULL || list->tail != NULL) {
+            return -2;
+        }
+
+        return 0;
+    }
+
+    if(list->head == NULL || list->tail == NULL) {
+        return -3;
+    }
+
+    size_t nodes = 0;
+    size_t length = 0;
+    ulist_node_t *last = NULL;
+
+    for(ulist_node_t *node = list->head; node != NULL; node = node->next) {
+        // every node holds at least one element, so there
+        // can't be more nodes than elements. if there are,
+        // the list has a cycle.
+        if(++nodes > list->length) {
+            return -4;
+        }
+
+        // nodes may not be empty or overfull
+        if(node->count == 0 || node->count > list->per_node) {
+            return -5;
+        }
+
+        length += node->count;
+        last = node;
+    }
+
+    if(last != list->tail) {
+        return -6;
+    }
+
+    if(length != list->length) {
+        return -7;
+    }
+
+    return 0;
+}
+
+static ulist_node_t *ulist_node_new(const ulist_t *list)
+{
+    ulist_node_t *node = malloc(sizeof(ulist_node_t) + (list->per_node * list->size));
+
+    if(node == NULL) {
+        return NULL;
+    }
+
+    node->next = NULL;
+    node->count = 0;
+
+    return node;
+}
+
+static ulist_node_t *ulist_node_get(const ulist_t *list, size_t pos, size_t *offset, ulist_node_t **prev)
+{
+    // pos must be inside the list
+    if(pos >= list->length) {
+        return NULL;
+    }
+
+    // shortcut: the element is in the last node. this only
+    // works if we don't need to know the previous node.
+    if(prev == NULL && pos >= (list->length - list->tail->count)) {
+        *offset = pos - (list->length - list->tail->count);
+        return list->tail;
+    }
+
+    // skip over whole nodes until we find the one that
+    // holds the element
+    ulist_node_t *before = NULL;
+    ulist_node_t *node = list->head;
+    while(node != NULL && pos >= node->count) {
+        pos -= node->count;
+        before = node;
+        node = node->next;
+    }
+
+    // error in the list!
+    if(node == NULL) {
+        return NULL;
+    }
+
+    if(prev != NULL) {
+        *prev = before;
+    }
+
+    *offset = pos;
+    return node;
+}